@@ -0,0 +1,303 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMApplyCostTracker.h"
+#include "UPMStatistics.h"
+#include "RHI.h"
+#include "RenderCore.h"
+#include "Json.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Apply cost tuning
+static const int32 UPMApplyCostHistoryFrames = 31;    // Baseline is the median of this many frames
+static const int32 UPMApplyCostMaxFrames = 30;        // Longest measurement after a change
+static const int32 UPMApplyCostSettledFrames = 3;     // Frames back at baseline that end a measurement
+static const float UPMApplyCostSettledRatio = 1.1f;   // "Back at baseline": within 10 percent
+static const int32 UPMApplyCostRecentStalls = 9;      // Stalls per setting the median is taken over
+static const double UPMApplyCostSaveInterval = 30.0;  // Seconds between writes of ApplyCosts.json
+
+// Stats of changes to several fields at once, which say nothing about any one of them
+static const TCHAR* UPMApplyCostBatchName = TEXT("Batch");
+
+static FString UPMGetApplyCostsPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("ApplyCosts.json");
+}
+
+/** Previous frame's game, render and RHI thread time (ms) */
+static FVector3f UPMSampleThreadTimes()
+{
+    return FVector3f(FPlatformTime::ToMilliseconds(GGameThreadTime), FPlatformTime::ToMilliseconds(GRenderThreadTime),
+        FPlatformTime::ToMilliseconds(GRHIThreadTime));
+}
+
+FUPMApplyCostTracker::FUPMApplyCostTracker()
+    : HistoryIndex(0)
+    , bMeasuring(false)
+    , MeasuredApplyCallMs(0.0f)
+    , Baseline(FVector3f::ZeroVector)
+    , Excess(FVector3f::ZeroVector)
+    , MeasuredFrames(0)
+    , SettledFrames(0)
+    , bDirty(false)
+    , LastSaveTime(0.0)
+{
+    BatchCosts.Setting = UPMApplyCostBatchName;
+    History.Reserve(UPMApplyCostHistoryFrames);
+
+    // What was measured since the last save is not lost on exit
+    PreExitHandle = FCoreDelegates::OnEnginePreExit.AddRaw(this, &FUPMApplyCostTracker::Flush);
+}
+
+FUPMApplyCostTracker::~FUPMApplyCostTracker()
+{
+    FCoreDelegates::OnEnginePreExit.Remove(PreExitHandle);
+}
+
+void FUPMApplyCostTracker::BeginMeasurement(const TArray<FName>& ChangedFields, float ApplyCallMs)
+{
+    // Overlapping changes: the earlier one ends here
+    if (bMeasuring)
+    {
+        FinishMeasurement();
+    }
+    if (History.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<float> GameThread;
+    TArray<float> RenderThread;
+    TArray<float> RHIThread;
+    for (const FVector3f& Sample : History)
+    {
+        GameThread.Add(Sample.X);
+        RenderThread.Add(Sample.Y);
+        RHIThread.Add(Sample.Z);
+    }
+    Baseline = FVector3f(FUPMStatistics::Percentile(GameThread, 50.0f), FUPMStatistics::Percentile(RenderThread, 50.0f),
+        FUPMStatistics::Percentile(RHIThread, 50.0f));
+
+    bMeasuring = true;
+    MeasuredFields = ChangedFields;
+    MeasuredApplyCallMs = ApplyCallMs;
+    Excess = FVector3f::ZeroVector;
+    MeasuredFrames = 0;
+    SettledFrames = 0;
+}
+
+void FUPMApplyCostTracker::Tick()
+{
+    // Written in batches, a file write per change would be a game thread hitch of its own
+    if (bDirty && FPlatformTime::Seconds() - LastSaveTime >= UPMApplyCostSaveInterval)
+    {
+        Flush();
+    }
+
+    const FVector3f Sample = UPMSampleThreadTimes();
+    if (!bMeasuring)
+    {
+        if (History.Num() < UPMApplyCostHistoryFrames)
+        {
+            History.Add(Sample);
+        }
+        else
+        {
+            History[HistoryIndex] = Sample;
+            HistoryIndex = (HistoryIndex + 1) % UPMApplyCostHistoryFrames;
+        }
+        return;
+    }
+
+    Excess.X += FMath::Max(0.0f, Sample.X - Baseline.X);
+    Excess.Y += FMath::Max(0.0f, Sample.Y - Baseline.Y);
+    Excess.Z += FMath::Max(0.0f, Sample.Z - Baseline.Z);
+    ++MeasuredFrames;
+
+    const bool bSettled = Sample.X <= Baseline.X * UPMApplyCostSettledRatio && Sample.Y <= Baseline.Y * UPMApplyCostSettledRatio
+        && Sample.Z <= Baseline.Z * UPMApplyCostSettledRatio;
+    SettledFrames = bSettled ? SettledFrames + 1 : 0;
+    if (SettledFrames >= UPMApplyCostSettledFrames || MeasuredFrames >= UPMApplyCostMaxFrames)
+    {
+        FinishMeasurement();
+    }
+}
+
+void FUPMApplyCostTracker::FinishMeasurement()
+{
+    bMeasuring = false;
+    if (MeasuredFields.Num() == 0)
+    {
+        return;
+    }
+
+    // The apply call ran on the game thread in the first measured frame, so it is part of GameThread already.
+    // Only a change of one field says what that field costs; splitting a batch evenly would spread one rebuild
+    // over every cheap toggle changed with it, so batches are kept as batch samples only
+    const float StallMs = FMath::Max3(Excess.X, Excess.Y, Excess.Z);
+    if (MeasuredFields.Num() == 1)
+    {
+        const FString Setting = MeasuredFields[0].ToString();
+        FUPMSettingApplyCostStats& Stats = Costs.FindOrAdd(Setting);
+        Stats.Setting = Setting;
+        AddSample(Stats, RecentStalls.FindOrAdd(Setting), StallMs);
+    }
+    else
+    {
+        BatchCosts.Setting = UPMApplyCostBatchName;
+        AddSample(BatchCosts, BatchRecentStalls, StallMs);
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("UPM: Settings change stalled %.1f ms over %d frames (GT %.1f, RT %.1f, RHI %.1f, apply %.1f): %s"),
+        StallMs, MeasuredFrames, Excess.X, Excess.Y, Excess.Z, MeasuredApplyCallMs,
+        *FString::JoinBy(MeasuredFields, TEXT(", "), [](const FName& Field) { return Field.ToString(); }));
+
+    MeasuredFields.Reset();
+    bDirty = true;
+}
+
+void FUPMApplyCostTracker::AddSample(FUPMSettingApplyCostStats& Stats, TArray<float>& Stalls, float StallMs) const
+{
+    // Running means
+    const float Weight = 1.0f / (Stats.Samples + 1);
+    Stats.ApplyCallMs += (MeasuredApplyCallMs - Stats.ApplyCallMs) * Weight;
+    Stats.GameThreadMs += (Excess.X - Stats.GameThreadMs) * Weight;
+    Stats.RenderThreadMs += (Excess.Y - Stats.RenderThreadMs) * Weight;
+    Stats.RHIThreadMs += (Excess.Z - Stats.RHIThreadMs) * Weight;
+    Stats.MeanStallMs += (StallMs - Stats.MeanStallMs) * Weight;
+    Stats.MaxStallMs = FMath::Max(Stats.MaxStallMs, StallMs);
+    ++Stats.Samples;
+
+    if (Stalls.Num() >= UPMApplyCostRecentStalls)
+    {
+        Stalls.RemoveAt(0);
+    }
+    Stalls.Add(StallMs);
+    Stats.MedianStallMs = FUPMStatistics::Percentile(Stalls, 50.0f);
+}
+
+void FUPMApplyCostTracker::Flush()
+{
+    if (bDirty)
+    {
+        bDirty = false;
+        LastSaveTime = FPlatformTime::Seconds();
+        Save();
+    }
+}
+
+const FUPMSettingApplyCostStats* FUPMApplyCostTracker::Find(const FString& SettingPath) const
+{
+    return Costs.Find(SettingPath);
+}
+
+static void UPMApplyCostFromJson(const TSharedPtr<FJsonObject>& CostObject, FUPMSettingApplyCostStats& Stats, TArray<float>& OutStalls)
+{
+    CostObject->TryGetNumberField(TEXT("Samples"), Stats.Samples);
+    CostObject->TryGetNumberField(TEXT("ApplyCallMs"), Stats.ApplyCallMs);
+    CostObject->TryGetNumberField(TEXT("GameThreadMs"), Stats.GameThreadMs);
+    CostObject->TryGetNumberField(TEXT("RenderThreadMs"), Stats.RenderThreadMs);
+    CostObject->TryGetNumberField(TEXT("RHIThreadMs"), Stats.RHIThreadMs);
+    CostObject->TryGetNumberField(TEXT("MeanStallMs"), Stats.MeanStallMs);
+    CostObject->TryGetNumberField(TEXT("MaxStallMs"), Stats.MaxStallMs);
+
+    // Files written before the median was kept have none; those settings count as cheap until re-measured
+    const TArray<TSharedPtr<FJsonValue>>* StallValues;
+    if (CostObject->TryGetArrayField(TEXT("RecentStallMs"), StallValues) && StallValues->Num() > 0)
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *StallValues)
+        {
+            OutStalls.Add(static_cast<float>(Value->AsNumber()));
+        }
+        Stats.MedianStallMs = FUPMStatistics::Percentile(OutStalls, 50.0f);
+    }
+}
+
+static TSharedPtr<FJsonObject> UPMApplyCostToJson(const FUPMSettingApplyCostStats& Stats, const TArray<float>* Stalls)
+{
+    TSharedPtr<FJsonObject> CostObject = MakeShareable(new FJsonObject);
+    CostObject->SetNumberField("Samples", Stats.Samples);
+    CostObject->SetNumberField("ApplyCallMs", Stats.ApplyCallMs);
+    CostObject->SetNumberField("GameThreadMs", Stats.GameThreadMs);
+    CostObject->SetNumberField("RenderThreadMs", Stats.RenderThreadMs);
+    CostObject->SetNumberField("RHIThreadMs", Stats.RHIThreadMs);
+    CostObject->SetNumberField("MeanStallMs", Stats.MeanStallMs);
+    CostObject->SetNumberField("MaxStallMs", Stats.MaxStallMs);
+    if (Stalls)
+    {
+        TArray<TSharedPtr<FJsonValue>> StallValues;
+        for (float Stall : *Stalls)
+        {
+            StallValues.Add(MakeShareable(new FJsonValueNumber(Stall)));
+        }
+        CostObject->SetArrayField("RecentStallMs", StallValues);
+    }
+    return CostObject;
+}
+
+bool FUPMApplyCostTracker::Load()
+{
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *UPMGetApplyCostsPath()))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> RootObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    const TSharedPtr<FJsonObject>* SettingsObject;
+    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid() || !RootObject->TryGetObjectField(TEXT("Settings"), SettingsObject))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UPM: Failed to parse %s"), *UPMGetApplyCostsPath());
+        return false;
+    }
+
+    Costs.Reset();
+    RecentStalls.Reset();
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Setting : (*SettingsObject)->Values)
+    {
+        const TSharedPtr<FJsonObject>* CostObject;
+        if (Setting.Value->TryGetObject(CostObject))
+        {
+            FUPMSettingApplyCostStats& Stats = Costs.Add(Setting.Key);
+            Stats.Setting = Setting.Key;
+            UPMApplyCostFromJson(*CostObject, Stats, RecentStalls.Add(Setting.Key));
+        }
+    }
+
+    // Files written before batches were kept apart have none; their per-setting numbers are even shares of
+    // batches and settle once single changes are measured
+    BatchCosts = FUPMSettingApplyCostStats();
+    BatchCosts.Setting = UPMApplyCostBatchName;
+    BatchRecentStalls.Reset();
+    const TSharedPtr<FJsonObject>* BatchObject;
+    if (RootObject->TryGetObjectField(UPMApplyCostBatchName, BatchObject))
+    {
+        UPMApplyCostFromJson(*BatchObject, BatchCosts, BatchRecentStalls);
+    }
+    return true;
+}
+
+bool FUPMApplyCostTracker::Save() const
+{
+    TSharedPtr<FJsonObject> SettingsObject = MakeShareable(new FJsonObject);
+    for (const TPair<FString, FUPMSettingApplyCostStats>& Cost : Costs)
+    {
+        SettingsObject->SetObjectField(Cost.Key, UPMApplyCostToJson(Cost.Value, RecentStalls.Find(Cost.Key)));
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField("Date", FDateTime::Now().ToIso8601());
+    RootObject->SetObjectField("Settings", SettingsObject);
+    RootObject->SetObjectField(UPMApplyCostBatchName, UPMApplyCostToJson(BatchCosts, &BatchRecentStalls));
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer) || !FFileHelper::SaveStringToFile(OutputString, *UPMGetApplyCostsPath()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write apply costs to %s"), *UPMGetApplyCostsPath());
+        return false;
+    }
+    return true;
+}
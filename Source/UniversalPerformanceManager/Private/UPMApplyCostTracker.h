@@ -0,0 +1,71 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Transient cost of settings changes
+ *
+ * Keeps a short history of game, render and RHI thread times. When settings change, the median of that history
+ * is the baseline and the frames after the change are measured against it until they are back to normal (or
+ * the window ends). The excess thread time, plus the apply call itself, is folded into a per-setting table when
+ * one field changed, and into batch stats when several did (one stall says nothing about how it splits). The table is saved to Saved/UPM/ApplyCosts.json at most every few seconds
+ * and when the engine exits.
+ */
+class FUPMApplyCostTracker
+{
+public:
+    FUPMApplyCostTracker();
+    ~FUPMApplyCostTracker();
+
+    /** Settings changed; ApplyCallMs is the game thread time of the apply */
+    void BeginMeasurement(const TArray<FName>& ChangedFields, float ApplyCallMs);
+
+    /** Game thread, once per frame with the previous frame's thread times */
+    void Tick();
+
+    const FUPMSettingApplyCostStats* Find(const FString& SettingPath) const;
+    const TMap<FString, FUPMSettingApplyCostStats>& GetCosts() const { return Costs; }
+
+    /** Changes of several fields at once */
+    const FUPMSettingApplyCostStats& GetBatchCosts() const { return BatchCosts; }
+
+    bool Load();
+    bool Save() const;
+
+    /** Save if anything was measured since the last save */
+    void Flush();
+
+private:
+    void FinishMeasurement();
+
+    /** Fold the finished measurement into Stats */
+    void AddSample(FUPMSettingApplyCostStats& Stats, TArray<float>& Stalls, float StallMs) const;
+
+    // Recent frames before any change: game, render, RHI thread (ms)
+    TArray<FVector3f> History;
+    int32 HistoryIndex;
+
+    // Measurement in progress
+    bool bMeasuring;
+    TArray<FName> MeasuredFields;
+    float MeasuredApplyCallMs;
+    FVector3f Baseline;
+    FVector3f Excess;
+    int32 MeasuredFrames;
+    int32 SettledFrames;
+
+    TMap<FString, FUPMSettingApplyCostStats> Costs;
+
+    // Most recent stalls per setting, oldest first, for MedianStallMs
+    TMap<FString, TArray<float>> RecentStalls;
+
+    FUPMSettingApplyCostStats BatchCosts;
+    TArray<float> BatchRecentStalls;
+
+    bool bDirty;
+    double LastSaveTime;
+    FDelegateHandle PreExitHandle;
+};
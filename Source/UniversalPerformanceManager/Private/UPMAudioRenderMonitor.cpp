@@ -0,0 +1,175 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMAudioRenderMonitor.h"
+#include "Sound/SoundSubmix.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <intrin.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_UNIX || PLATFORM_APPLE || PLATFORM_ANDROID
+#include <time.h>
+#endif
+
+static const double UPMAudioWindowSeconds = 0.5;
+
+/** CPU time consumed by the calling thread in seconds, or a negative value where it cannot be measured */
+static double UPMGetThreadCPUSeconds()
+{
+#if PLATFORM_WINDOWS
+    // Thread cycle time is counted in TSC ticks, calibrate the TSC against the wall clock once
+    static const double SecondsPerTick = []()
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
+        const uint64 StartTicks = __rdtsc();
+        FPlatformProcess::Sleep(0.02f);
+        return (FPlatformTime::Seconds() - StartSeconds) / static_cast<double>(__rdtsc() - StartTicks);
+    }();
+
+    ULONG64 Cycles = 0;
+    if (!QueryThreadCycleTime(GetCurrentThread(), &Cycles))
+    {
+        return -1.0;
+    }
+    return static_cast<double>(Cycles) * SecondsPerTick;
+#elif PLATFORM_UNIX || PLATFORM_APPLE || PLATFORM_ANDROID
+    struct timespec Time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &Time) != 0)
+    {
+        return -1.0;
+    }
+    return static_cast<double>(Time.tv_sec) + static_cast<double>(Time.tv_nsec) * 1e-9;
+#else
+    return -1.0;
+#endif
+}
+
+FUPMAudioRenderMonitor::FUPMAudioRenderMonitor()
+    : DeviceId(INDEX_NONE)
+    , bListening(false)
+    , LastThreadCPUSeconds(-1.0)
+    , WindowRenderSeconds(0.0)
+    , WindowPeakSeconds(0.0)
+    , WindowAudioSeconds(0.0)
+    , WindowBuffers(0)
+    , AverageRenderMs(0.0f)
+    , PeakRenderMs(0.0f)
+    , BufferPeriodMs(0.0f)
+{
+}
+
+FUPMAudioRenderMonitor::~FUPMAudioRenderMonitor()
+{
+#if !UE_VERSION_NEWER_THAN(5, 3, 99)
+    // The device holds a raw pointer to us; newer engines only keep a weak reference
+    Stop();
+#endif
+}
+
+void FUPMAudioRenderMonitor::Start(FAudioDevice* AudioDevice)
+{
+    if (!AudioDevice || IsListeningTo(AudioDevice))
+    {
+        return;
+    }
+
+    Stop();
+
+    // Calibrate off the audio render thread
+    UPMGetThreadCPUSeconds();
+
+    // The first buffer after a restart has no previous buffer to measure against
+    ResetMeasurement();
+
+#if UE_VERSION_NEWER_THAN(5, 3, 99)
+    AudioDevice->RegisterSubmixBufferListener(AsShared(), const_cast<USoundSubmix&>(AudioDevice->GetMainSubmixObject()));
+#else
+    AudioDevice->RegisterSubmixBufferListener(this);
+#endif
+
+    DeviceId = AudioDevice->DeviceID;
+    bListening = true;
+    UE_LOG(LogTemp, Log, TEXT("UPM: Audio render monitor listening to audio device %d"), DeviceId);
+}
+
+void FUPMAudioRenderMonitor::Stop()
+{
+    if (!bListening)
+    {
+        return;
+    }
+
+    if (FAudioDeviceManager* DeviceManager = FAudioDeviceManager::Get())
+    {
+        if (FAudioDevice* AudioDevice = DeviceManager->GetAudioDeviceRaw(DeviceId))
+        {
+#if UE_VERSION_NEWER_THAN(5, 3, 99)
+            AudioDevice->UnregisterSubmixBufferListener(AsShared(), const_cast<USoundSubmix&>(AudioDevice->GetMainSubmixObject()));
+#else
+            AudioDevice->UnregisterSubmixBufferListener(this);
+#endif
+        }
+    }
+
+    bListening = false;
+    DeviceId = INDEX_NONE;
+    BufferPeriodMs.store(0.0f, std::memory_order_relaxed);
+    ResetMeasurement();
+}
+
+void FUPMAudioRenderMonitor::ResetMeasurement()
+{
+    LastThreadCPUSeconds = -1.0;
+    WindowRenderSeconds = 0.0;
+    WindowPeakSeconds = 0.0;
+    WindowAudioSeconds = 0.0;
+    WindowBuffers = 0;
+}
+
+bool FUPMAudioRenderMonitor::IsListeningTo(const FAudioDevice* AudioDevice) const
+{
+    return bListening && AudioDevice && AudioDevice->DeviceID == DeviceId;
+}
+
+#if UE_VERSION_NEWER_THAN(5, 3, 99)
+const FString& FUPMAudioRenderMonitor::GetListenerName() const
+{
+    static const FString ListenerName(TEXT("UPMAudioRenderMonitor"));
+    return ListenerName;
+}
+#endif
+
+void FUPMAudioRenderMonitor::OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples,
+    int32 NumChannels, const int32 SampleRate, double AudioClock)
+{
+    // Audio render thread
+    const double ThreadCPUSeconds = UPMGetThreadCPUSeconds();
+    if (ThreadCPUSeconds < 0.0 || NumChannels <= 0 || SampleRate <= 0)
+    {
+        return;
+    }
+
+    if (LastThreadCPUSeconds >= 0.0)
+    {
+        const double RenderSeconds = ThreadCPUSeconds - LastThreadCPUSeconds;
+        WindowRenderSeconds += RenderSeconds;
+        WindowPeakSeconds = FMath::Max(WindowPeakSeconds, RenderSeconds);
+        WindowBuffers++;
+    }
+    LastThreadCPUSeconds = ThreadCPUSeconds;
+
+    const double BufferSeconds = static_cast<double>(NumSamples / NumChannels) / SampleRate;
+    WindowAudioSeconds += BufferSeconds;
+
+    if (WindowAudioSeconds >= UPMAudioWindowSeconds && WindowBuffers > 0)
+    {
+        AverageRenderMs.store(static_cast<float>(WindowRenderSeconds / WindowBuffers * 1000.0), std::memory_order_relaxed);
+        PeakRenderMs.store(static_cast<float>(WindowPeakSeconds * 1000.0), std::memory_order_relaxed);
+        BufferPeriodMs.store(static_cast<float>(BufferSeconds * 1000.0), std::memory_order_relaxed);
+
+        WindowRenderSeconds = 0.0;
+        WindowPeakSeconds = 0.0;
+        WindowAudioSeconds = 0.0;
+        WindowBuffers = 0;
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioDevice.h"
+#include "AudioDeviceManager.h"
+#include "Misc/EngineVersionComparison.h"
+#include <atomic>
+
+/**
+ * Audio render cost monitor
+ *
+ * Listens to the main submix, which is the last thing the audio mixer renders for every buffer, and measures
+ * the CPU time the audio render thread consumed since the previous buffer. The render thread blocks while it
+ * waits for the next buffer request, so that CPU time is the cost of rendering one buffer. Averages and peaks
+ * are published once per window for the game thread.
+ *
+ * Works with hardware devices and the null device (headless Linux); thread CPU time is not available on every
+ * platform, IsMeasurementAvailable() reports whether anything was measured.
+ */
+class FUPMAudioRenderMonitor : public ISubmixBufferListener, public TSharedFromThis<FUPMAudioRenderMonitor, ESPMode::ThreadSafe>
+{
+public:
+    FUPMAudioRenderMonitor();
+    virtual ~FUPMAudioRenderMonitor();
+
+    /** Start listening on the device's main submix (restarts if listening to another device) */
+    void Start(FAudioDevice* AudioDevice);
+    void Stop();
+    bool IsListeningTo(const FAudioDevice* AudioDevice) const;
+
+    bool IsMeasurementAvailable() const { return BufferPeriodMs.load(std::memory_order_relaxed) > 0.0f; }
+    float GetAverageRenderTimeMs() const { return AverageRenderMs.load(std::memory_order_relaxed); }
+    float GetPeakRenderTimeMs() const { return PeakRenderMs.load(std::memory_order_relaxed); }
+
+    /** Render deadline: duration of one buffer */
+    float GetBufferPeriodMs() const { return BufferPeriodMs.load(std::memory_order_relaxed); }
+
+    // ISubmixBufferListener
+    virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples,
+        int32 NumChannels, const int32 SampleRate, double AudioClock) override;
+#if UE_VERSION_NEWER_THAN(5, 3, 99)
+    virtual const FString& GetListenerName() const override;
+#endif
+
+private:
+    /** Drop the render thread's previous buffer and partial window; only called while not registered */
+    void ResetMeasurement();
+
+    Audio::FDeviceId DeviceId;
+    bool bListening;
+
+    // Audio render thread only
+    double LastThreadCPUSeconds;
+    double WindowRenderSeconds;
+    double WindowPeakSeconds;
+    double WindowAudioSeconds;
+    int32 WindowBuffers;
+
+    // Published for the game thread
+    std::atomic<float> AverageRenderMs;
+    std::atomic<float> PeakRenderMs;
+    std::atomic<float> BufferPeriodMs;
+};
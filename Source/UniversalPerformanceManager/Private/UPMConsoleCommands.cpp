@@ -0,0 +1,445 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "UPMSettingsManager.h"
+#include "UPMPerformanceSubsystem.h"
+#include "UPMFrameTimeComparison.h"
+#include "UPMSelfBenchmark.h"
+
+static UUPMSettingsManager* UPMGetManager(UWorld* World, FOutputDevice& Ar)
+{
+    UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(World);
+    if (!Manager)
+    {
+        Ar.Logf(TEXT("UPM: Settings manager unavailable, no world loaded yet"));
+    }
+    return Manager;
+}
+
+/** Numbers, true/false and on/off */
+static bool UPMParseSettingValue(const FString& Text, double& OutValue)
+{
+    if (Text.Equals(TEXT("true"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("on"), ESearchCase::IgnoreCase))
+    {
+        OutValue = 1.0;
+        return true;
+    }
+    if (Text.Equals(TEXT("false"), ESearchCase::IgnoreCase) || Text.Equals(TEXT("off"), ESearchCase::IgnoreCase))
+    {
+        OutValue = 0.0;
+        return true;
+    }
+    if (Text.IsNumeric())
+    {
+        OutValue = FCString::Atod(*Text);
+        return true;
+    }
+    return false;
+}
+
+/** Set one setting, reporting failures; batching is up to the caller */
+static bool UPMSetSetting(UUPMSettingsManager* Manager, const FString& SettingPath, const FString& ValueText, FOutputDevice& Ar)
+{
+    double Value = 0.0;
+    if (!UPMParseSettingValue(ValueText, Value))
+    {
+        Ar.Logf(TEXT("UPM: Invalid value for %s: %s"), *SettingPath, *ValueText);
+        return false;
+    }
+    if (!Manager->SetSettingByName(SettingPath, Value))
+    {
+        Ar.Logf(TEXT("UPM: Unknown setting or invalid value: %s = %s (upm.Get lists all)"), *SettingPath, *ValueText);
+        return false;
+    }
+    return true;
+}
+
+// ==================== Settings ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMGetCommand(
+    TEXT("upm.Get"),
+    TEXT("Print settings. Usage: upm.Get [Category.Field | Category]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMSettingsManager* Manager = UPMGetManager(World, Ar);
+        if (!Manager)
+        {
+            return;
+        }
+
+        TArray<FString> SettingPaths;
+        UUPMSettingsManager::GetSettingPaths(SettingPaths);
+        const FString Filter = Args.Num() > 0 ? Args[0] : FString();
+        int32 NumPrinted = 0;
+        for (const FString& SettingPath : SettingPaths)
+        {
+            if (!Filter.IsEmpty() && !SettingPath.Equals(Filter, ESearchCase::IgnoreCase)
+                && !SettingPath.StartsWith(Filter + TEXT("."), ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+
+            double Value = 0.0;
+            UUPMSettingsManager::GetSettingValue(Manager->GetSettings(), SettingPath, Value);
+            Ar.Logf(TEXT("%s = %g"), *SettingPath, Value);
+            ++NumPrinted;
+        }
+
+        if (NumPrinted == 0)
+        {
+            Ar.Logf(TEXT("UPM: Unknown setting or category: %s"), *Filter);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMSetCommand(
+    TEXT("upm.Set"),
+    TEXT("Set and apply one setting. Usage: upm.Set <Category.Field> <Value>"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (Args.Num() < 2)
+        {
+            Ar.Logf(TEXT("UPM: Usage: upm.Set <Category.Field> <Value>"));
+            return;
+        }
+
+        if (UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            UPMSetSetting(Manager, Args[0], Args[1], Ar);
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMApplyCommand(
+    TEXT("upm.Apply"),
+    TEXT("Set several settings and apply them as one commit, or re-apply everything without arguments. Usage: upm.Apply [Category.Field=Value ...]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMSettingsManager* Manager = UPMGetManager(World, Ar);
+        if (!Manager)
+        {
+            return;
+        }
+
+        if (Args.Num() == 0)
+        {
+            Manager->ApplyAllSettings();
+        }
+        else
+        {
+            FUPMSettingsBatch Batch(Manager);
+            for (const FString& Arg : Args)
+            {
+                FString SettingPath;
+                FString ValueText;
+                if (!Arg.Split(TEXT("="), &SettingPath, &ValueText))
+                {
+                    Ar.Logf(TEXT("UPM: Expected Category.Field=Value, got %s"), *Arg);
+                    continue;
+                }
+                UPMSetSetting(Manager, SettingPath, ValueText, Ar);
+            }
+        }
+
+        // An explicit apply includes the expensive settings
+        Manager->NotifySafePoint();
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMSafePointCommand(
+    TEXT("upm.SafePoint"),
+    TEXT("Apply expensive settings held back until a safe point"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            for (const FString& SettingPath : Manager->GetDeferredSettings())
+            {
+                Ar.Logf(TEXT("UPM: Applying %s"), *SettingPath);
+            }
+            Manager->NotifySafePoint();
+        }
+    }));
+
+// ==================== Profiles ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMProfileSaveCommand(
+    TEXT("upm.Profile.Save"),
+    TEXT("Save the current settings as a profile. Usage: upm.Profile.Save <Name>"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMSettingsManager* Manager = UPMGetManager(World, Ar);
+        if (Manager && Args.Num() > 0)
+        {
+            Ar.Logf(TEXT("UPM: Profile %s %s"), *Args[0], Manager->SaveProfile(Args[0]) ? TEXT("saved") : TEXT("could not be saved"));
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMProfileLoadCommand(
+    TEXT("upm.Profile.Load"),
+    TEXT("Load and apply a saved profile. Usage: upm.Profile.Load <Name>"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMSettingsManager* Manager = UPMGetManager(World, Ar);
+        if (Manager && Args.Num() > 0)
+        {
+            Ar.Logf(TEXT("UPM: Profile %s %s"), *Args[0], Manager->LoadProfile(Args[0]) ? TEXT("applied") : TEXT("could not be loaded"));
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMProfileListCommand(
+    TEXT("upm.Profile.List"),
+    TEXT("List saved profiles"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            for (const FString& ProfileName : Manager->GetProfileNames())
+            {
+                Ar.Logf(TEXT("%s"), *ProfileName);
+            }
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMProfileLoadWhenWarmCommand(
+    TEXT("upm.Profile.LoadWhenWarm"),
+    TEXT("Precache the PSOs of a profile, then apply it once warm. Usage: upm.Profile.LoadWhenWarm <Name> [TimeoutSeconds]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMSettingsManager* Manager = UPMGetManager(World, Ar);
+        if (Manager && Args.Num() > 0)
+        {
+            const float TimeoutSeconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 10.0f;
+            if (!Manager->LoadProfileWhenWarm(Args[0], TimeoutSeconds))
+            {
+                Ar.Logf(TEXT("UPM: Profile %s could not be loaded"), *Args[0]);
+            }
+        }
+    }));
+
+// ==================== Shader Precache ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMPrecacheStatsCommand(
+    TEXT("upm.Precache.Stats"),
+    TEXT("Print PSO precache progress and the hitches after warm and cold settings switches"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            const FUPMShaderPrecacheStats Stats = Manager->GetShaderPrecacheStats();
+            Ar.Logf(TEXT("UPM: PSO precache %s (%.0f%%), %d requests, last took %.1fs"),
+                Manager->IsShaderPrecacheWarm() ? TEXT("warm") : TEXT("running"), Manager->GetShaderPrecacheProgress() * 100.0f,
+                Stats.Requests, Stats.LastPrecacheSeconds);
+            Ar.Logf(TEXT("UPM:   Warm switches %d: %d hitches, worst %.0f ms"), Stats.WarmSwitches, Stats.WarmSwitchHitches, Stats.WarmSwitchWorstHitchMs);
+            Ar.Logf(TEXT("UPM:   Cold switches %d: %d hitches, worst %.0f ms"), Stats.ColdSwitches, Stats.ColdSwitchHitches, Stats.ColdSwitchWorstHitchMs);
+        }
+    }));
+
+// ==================== Frame Rate Target ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMFrameRateCommand(
+    TEXT("upm.FrameRate"),
+    TEXT("Print the display refresh rate, the frame rate targets it paces evenly, the target in effect and the eco state"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            const FUPMDisplayRefreshInfo Display = Manager->GetDisplayRefreshInfo();
+            const FString Targets = FString::JoinBy(Manager->GetFrameRateTargets(), TEXT(", "),
+                [](float Target) { return FString::Printf(TEXT("%.1f"), Target); });
+            Ar.Logf(TEXT("UPM: Display %s at %.0f Hz, VRR %s"), *Display.MonitorId, Display.RefreshRate,
+                Display.bVariableRefreshRateSupported ? TEXT("supported") : TEXT("not supported"));
+            Ar.Logf(TEXT("UPM: Targets %s"), *Targets);
+            Ar.Logf(TEXT("UPM: In effect %.1f (%s), eco state %s"), Manager->GetFrameRateTarget(),
+                Manager->GetPerformanceSettings().bAutoFrameRateTarget ? TEXT("automatic") : TEXT("FrameRateLimit"),
+                *UEnum::GetDisplayValueAsText(Manager->GetEcoState()).ToString());
+        }
+    }));
+
+// ==================== Upscaling ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMUpscalersCommand(
+    TEXT("upm.Upscalers"),
+    TEXT("Print the available upscalers, the active one and the frame times measured per mode"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            const FString Available = FString::JoinBy(Manager->GetAvailableUpscalers(), TEXT(", "),
+                [](EUPMUpscalingMode Mode) { return UEnum::GetDisplayValueAsText(Mode).ToString(); });
+            Ar.Logf(TEXT("UPM: Upscalers available: %s"), *Available);
+            Ar.Logf(TEXT("UPM: Active %s at %.1f%% screen percentage"), *UEnum::GetDisplayValueAsText(Manager->GetActiveUpscalingMode()).ToString(),
+                Manager->GetUpscalingScreenPercentage());
+
+            for (const FUPMUpscalerStats& Stats : Manager->GetUpscalerStats())
+            {
+                Ar.Logf(TEXT("UPM:   %-28s %-34s %5.1f%%  %6d frames  frame %6.2f ms  GT %6.2f  RT %6.2f  GPU %6.2f"),
+                    *UEnum::GetDisplayValueAsText(Stats.Mode).ToString(), *UEnum::GetDisplayValueAsText(Stats.Quality).ToString(), Stats.ScreenPercentage,
+                    Stats.Frames, Stats.FrameTimeMs, Stats.GameThreadMs, Stats.RenderThreadMs, Stats.GPUMs);
+            }
+        }
+    }));
+
+// ==================== Effects ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMEffectsCommand(
+    TEXT("upm.Effects"),
+    TEXT("Print the effects time against the effects budget and the effect assets with the most active systems"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            const FUPMPerformanceMetrics Metrics = Manager->GetPerformanceMetrics();
+            Ar.Logf(TEXT("UPM: %d effect systems active, GT %.2f ms, RT %.2f ms, budget %.2f ms (%s), spawn scale %.2f"),
+                Metrics.Process.ActiveEffectSystems, Metrics.Process.EffectsGameThreadMs, Metrics.Process.EffectsRenderThreadMs, Metrics.Process.EffectsBudgetMs,
+                Manager->GetPerformanceSettings().bEnableEffectsBudget ? TEXT("on") : TEXT("off"), Metrics.Process.EffectsSpawnScale);
+            for (const FUPMEffectSystemStats& System : Manager->GetTopEffectSystems())
+            {
+                Ar.Logf(TEXT("UPM:   %5d  %s"), System.ActiveInstances, *System.SystemName);
+            }
+        }
+    }));
+
+// ==================== Apply Costs ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMApplyCostsCommand(
+    TEXT("upm.ApplyCosts"),
+    TEXT("Print the measured hitch of each settings change, most expensive first"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (const UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            const TArray<FUPMSettingApplyCostStats> Costs = Manager->GetAllSettingApplyCosts();
+            Ar.Logf(TEXT("UPM: %d settings measured (stall = longest thread over baseline, mean/median/max)"), Costs.Num());
+            for (const FUPMSettingApplyCostStats& Cost : Costs)
+            {
+                Ar.Logf(TEXT("UPM:   %-40s %4d x  stall %7.1f / %7.1f / %7.1f ms  GT %6.1f  RT %6.1f  RHI %6.1f  apply %6.1f  %s"),
+                    *Cost.Setting, Cost.Samples, Cost.MeanStallMs, Cost.MedianStallMs, Cost.MaxStallMs, Cost.GameThreadMs, Cost.RenderThreadMs, Cost.RHIThreadMs,
+                    Cost.ApplyCallMs, Manager->GetSettingApplyCost(Cost.Setting) == EUPMSettingApplyCost::Expensive ? TEXT("expensive") : TEXT(""));
+            }
+
+            const FUPMSettingApplyCostStats Batch = Manager->GetBatchApplyCostStats();
+            Ar.Logf(TEXT("UPM:   %-40s %4d x  stall %7.1f / %7.1f / %7.1f ms  (several fields at once, not attributed)"),
+                TEXT("Batches"), Batch.Samples, Batch.MeanStallMs, Batch.MedianStallMs, Batch.MaxStallMs);
+        }
+    }));
+
+// ==================== Stats ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMStatsCommand(
+    TEXT("upm.Stats"),
+    TEXT("Print the performance metrics of this game instance"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        const UUPMPerformanceSubsystem* Performance = UUPMPerformanceSubsystem::Get(World);
+        const UUPMSettingsManager* Manager = Performance ? nullptr : UPMGetManager(World, Ar);
+        if (!Performance && !Manager)
+        {
+            return;
+        }
+
+        const FUPMPerformanceMetrics Metrics = Performance ? Performance->GetPerformanceMetrics() : Manager->GetPerformanceMetrics();
+        const FUPMServerNetworkStats ServerStats = Performance ? Performance->GetServerNetworkStats() : Manager->GetServerNetworkStats();
+
+        Ar.Logf(TEXT("UPM: Stats of %s"), Performance ? *Performance->GetInstanceName() : TEXT("process"));
+        Ar.Logf(TEXT("UPM:   FPS %.1f (avg %.1f, min %.1f, max %.1f), frame %.2f ms, world tick %.2f / %.2f ms budget"),
+            Metrics.FPS_Current, Metrics.FPS_Average, Metrics.FPS_Min, Metrics.FPS_Max, Metrics.CPUFrameTime,
+            Metrics.WorldTickTimeMs, Metrics.TickBudgetMs);
+        Ar.Logf(TEXT("UPM:   RAM %.0f MB, VRAM %.0f MB, throttled actors %d"), Metrics.RAMUsageMB, Metrics.VRAMUsageMB, Metrics.ThrottledActorCount);
+        Ar.Logf(TEXT("UPM:   Ping %.0f ms, loss %.1f%% in / %.1f%% out"), Metrics.NetworkPing, Metrics.PacketLossIn, Metrics.PacketLossOut);
+        Ar.Logf(TEXT("UPM:   Streaming: %d levels, %d packages pending for %.1f s, %.2f ms per frame, async limit %.1f ms, distance x%.2f"),
+            Metrics.Process.PendingStreamingLevels, Metrics.Process.AsyncLoadingPackages, Metrics.Process.StreamingBacklogSeconds, Metrics.Process.StreamingFrameCostMs,
+            Metrics.Process.AsyncLoadingTimeLimitMs, Metrics.Process.StreamingDistanceScale);
+        Ar.Logf(TEXT("UPM:   Effects: %d systems, GT %.2f ms, RT %.2f ms, budget %.2f ms, spawn scale %.2f"),
+            Metrics.Process.ActiveEffectSystems, Metrics.Process.EffectsGameThreadMs, Metrics.Process.EffectsRenderThreadMs, Metrics.Process.EffectsBudgetMs, Metrics.Process.EffectsSpawnScale);
+        Ar.Logf(TEXT("UPM:   Textures: pool %.0f MB, streaming %.0f MB + %.0f MB non-streaming, wanted %.0f MB, over budget %.0f MB"),
+            Metrics.Process.TexturePoolSizeMB, Metrics.Process.TextureStreamingUsedMB, Metrics.Process.TextureNonStreamingMB, Metrics.Process.TextureWantedMB, Metrics.Process.TextureOverBudgetMB);
+        Ar.Logf(TEXT("UPM:   Texture mips: %d resident / %d requested, %d textures missing %.1f MB, %d requests, %.1f MB/s"),
+            Metrics.Process.TextureResidentMips, Metrics.Process.TextureRequestedMips, Metrics.Process.TexturesMissingMips, Metrics.Process.TexturePendingMB,
+            Metrics.Process.TextureStreamingRequests, Metrics.Process.TextureStreamingMBPerSecond);
+        if (ServerStats.NumConnections > 0)
+        {
+            Ar.Logf(TEXT("UPM:   Server: %d connections, ping P50 %.0f / P95 %.0f / max %.0f ms, loss P95 %.1f%%"),
+                ServerStats.NumConnections, ServerStats.PingP50, ServerStats.PingP95, ServerStats.MaxPing, ServerStats.PacketLossP95);
+        }
+    }));
+
+// ==================== Frame Time Recording ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMRecordFrameTimesStartCommand(
+    TEXT("upm.RecordFrameTimes.Start"),
+    TEXT("Record every frame of this game instance until upm.RecordFrameTimes.Stop"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        // Same source as upm.Stats: the game instance's subsystem, the process-wide manager without one
+        if (UUPMPerformanceSubsystem* Performance = UUPMPerformanceSubsystem::Get(World))
+        {
+            Performance->StartFrameTimeRecording();
+        }
+        else if (UUPMSettingsManager* Manager = UPMGetManager(World, Ar))
+        {
+            Manager->StartFrameTimeRecording();
+        }
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMRecordFrameTimesStopCommand(
+    TEXT("upm.RecordFrameTimes.Stop"),
+    TEXT("Stop recording and write the frame times as CSV. Usage: upm.RecordFrameTimes.Stop [File]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UUPMPerformanceSubsystem* Performance = UUPMPerformanceSubsystem::Get(World);
+        UUPMSettingsManager* Manager = Performance ? nullptr : UPMGetManager(World, Ar);
+        if (!Performance && !Manager)
+        {
+            return;
+        }
+
+        const FString RequestedPath = Args.Num() > 0 ? Args[0] : FString();
+        const FString FilePath = Performance ? Performance->StopFrameTimeRecording(RequestedPath) : Manager->StopFrameTimeRecording(RequestedPath);
+        Ar.Logf(TEXT("UPM: %s"), FilePath.IsEmpty() ? TEXT("No frame times written") : *FilePath);
+    }));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMCompareFrameTimesCommand(
+    TEXT("upm.CompareFrameTimes"),
+    TEXT("Test two frame time recordings for significant P50/P95/P99 changes. Usage: upm.CompareFrameTimes <Baseline.csv> <Candidate.csv> [Column]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        if (Args.Num() < 2)
+        {
+            Ar.Logf(TEXT("UPM: Usage: upm.CompareFrameTimes <Baseline.csv> <Candidate.csv> [Column]"));
+            return;
+        }
+
+        const FString Column = Args.Num() > 2 ? Args[2] : FString(TEXT("FrameTimeMs"));
+        TArray<float> Baseline;
+        TArray<float> Candidate;
+        if (FUPMFrameTimeComparison::LoadFrameTimes(Args[0], Baseline, Column)
+            && FUPMFrameTimeComparison::LoadFrameTimes(Args[1], Candidate, Column))
+        {
+            FUPMFrameTimeComparison::PrintReport(FUPMFrameTimeComparison::Compare(Baseline, Candidate), Ar);
+        }
+    }));
+
+// ==================== Self-Benchmark ====================
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice GUPMSelfBenchmarkCommand(
+    TEXT("upm.SelfBenchmark"),
+    TEXT("Time UPM's own hot paths against the plugin's Resources/SelfBenchmarkBaseline.json. Usage: upm.SelfBenchmark [UpdateBaseline] [Tolerance]"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        FUPMSelfBenchmarkOptions Options;
+        for (const FString& Arg : Args)
+        {
+            if (Arg.Equals(TEXT("UpdateBaseline"), ESearchCase::IgnoreCase))
+            {
+                Options.bUpdateBaseline = true;
+            }
+            else if (Arg.IsNumeric())
+            {
+                Options.Tolerance = FCString::Atof(*Arg);
+            }
+        }
+
+        TArray<FUPMSelfBenchmarkCase> Cases;
+        const bool bPassed = FUPMSelfBenchmark::Run(UUPMSettingsManager::GetInstance(World), Options, Cases, Ar);
+        Ar.Logf(TEXT("UPM: Self-benchmark %s"), bPassed ? TEXT("passed") : TEXT("FAILED"));
+    }));
@@ -0,0 +1,57 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSettingsManager.h"
+#include "UPMEngineStateSnapshot.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Graphics and Display commits go through UGameUserSettings::ApplySettings, which resets t.MaxFPS; the eco cap must survive them */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUPMEcoFrameRateCapTest, "UniversalPerformanceManager.EcoMode.CapSurvivesScalabilityCommit",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUPMEcoFrameRateCapTest::RunTest(const FString& Parameters)
+{
+    IConsoleVariable* MaxFPSCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("t.MaxFPS"));
+    if (!TestNotNull(TEXT("t.MaxFPS exists"), MaxFPSCVar))
+    {
+        return false;
+    }
+
+    FUPMEngineStateSnapshot EngineState;
+    EngineState.Capture();
+
+    // Never the running game's manager; uncapped for the player, capped by the pause menu
+    UUPMSettingsManager* Manager = NewObject<UUPMSettingsManager>();
+    Manager->AddToRoot();
+    Manager->CurrentSettings.Performance.FrameRateLimit = 0.0f;
+    Manager->CurrentSettings.Performance.bAutoFrameRateTarget = false;
+    Manager->CurrentSettings.Performance.bEnableEcoMode = true;
+    Manager->CurrentSettings.Performance.MenuFrameRateLimit = 30.0f;
+    Manager->EcoState = EUPMEcoState::Menu;
+
+    Manager->ApplyFrameRateTarget();
+    TestEqual(TEXT("Menu cap applied"), MaxFPSCVar->GetFloat(), 30.0f);
+
+    Manager->ApplyCategories(EUPMSettingsCategory::Graphics);
+    TestEqual(TEXT("Menu cap kept after a Graphics commit"), MaxFPSCVar->GetFloat(), 30.0f);
+
+    Manager->ApplyCategories(EUPMSettingsCategory::Display);
+    TestEqual(TEXT("Menu cap kept after a Display commit"), MaxFPSCVar->GetFloat(), 30.0f);
+
+    Manager->EcoState = EUPMEcoState::None;
+    Manager->ApplyCategories(EUPMSettingsCategory::Graphics);
+    TestEqual(TEXT("No cap once the menu is closed"), MaxFPSCVar->GetFloat(), 0.0f);
+
+    Manager->RemoveFromRoot();
+
+    EngineState.Restore();
+    if (UUPMSettingsManager* LiveManager = UUPMSettingsManager::GetExistingInstance())
+    {
+        LiveManager->ApplyAllSettings();
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,234 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMEffectsBudget.h"
+#include "FXBudget.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Engine/World.h"
+#include "UObject/UObjectHash.h"
+
+// Effects budget tuning
+static const float UPMEffectsBudgetFractions[] = { 0.06f, 0.08f, 0.10f, 0.12f, 0.15f }; // Share of the frame per EffectsQuality
+static const float UPMEffectsDefaultFrameRate = 60.0f;   // For the frame time when uncapped
+static const double UPMEffectsEvaluateSeconds = 0.5;     // Between spawn scale changes
+static const float UPMEffectsScaleDownFactor = 0.85f;    // While over the budget
+static const float UPMEffectsScaleUpStep = 0.05f;        // While under UPMEffectsRaiseUsage of it
+static const float UPMEffectsRaiseUsage = 0.7f;
+static const float UPMMinEffectsSpawnScale = 0.25f;
+static const double UPMEffectsCountSeconds = 1.0;        // Active system count
+
+static IConsoleVariable* UPMFindEffectsCVar(const TCHAR* Name)
+{
+    return IConsoleManager::Get().FindConsoleVariable(Name);
+}
+
+FUPMEffectsBudget::FUPMEffectsBudget()
+    : bApplied(false)
+    , OriginalBudgetEnabled(0)
+    , OriginalBudgetGameThread(2.0f)
+    , OriginalBudgetGameThreadConcurrent(2.0f)
+    , OriginalBudgetRenderThread(2.0f)
+    , OriginalNiagaraSpawnScale(1.0f)
+    , OriginalCascadeSpawnScale(1.0f)
+    , BudgetMs(0.0f)
+    , GameThreadMs(0.0f)
+    , RenderThreadMs(0.0f)
+    , SpawnScale(1.0f)
+    , NextEvaluateTime(0.0)
+    , NextCountTime(0.0)
+    , ActiveSystems(0)
+{
+}
+
+float FUPMEffectsBudget::GetBudgetFraction(int32 EffectsQuality)
+{
+    return UPMEffectsBudgetFractions[FMath::Clamp(EffectsQuality, 0, static_cast<int32>(UE_ARRAY_COUNT(UPMEffectsBudgetFractions)) - 1)];
+}
+
+void FUPMEffectsBudget::Tick(UWorld* World, const FUPMPerformanceSettings& Settings, int32 EffectsQuality, float FrameRateTarget)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!Settings.bEnableEffectsBudget)
+    {
+        // Counting walks every FX component, so skip it while the budget is off and count as soon as it turns on
+        ActiveSystems = 0;
+        SystemCounts.Reset();
+        NextCountTime = 0.0;
+    }
+    else if (Now >= NextCountTime)
+    {
+        NextCountTime = Now + UPMEffectsCountSeconds;
+        CountSystems(World);
+    }
+
+    // Only tracked while the engine's FX budget is on (ours or the project's)
+#if WITH_GLOBAL_RUNTIME_FX_BUDGET
+    if (FFXBudget::Enabled())
+    {
+        const FFXTimeData Time = FFXBudget::GetTime();
+        GameThreadMs = Time.GT;
+        RenderThreadMs = Time.RT;
+    }
+    else
+#endif
+    {
+        GameThreadMs = RenderThreadMs = 0.0f;
+    }
+
+    if (!Settings.bEnableEffectsBudget)
+    {
+        Restore();
+        return;
+    }
+
+    const float FrameTimeMs = 1000.0f / (FrameRateTarget > 0.0f ? FrameRateTarget : UPMEffectsDefaultFrameRate);
+    Apply(Settings.EffectsBudgetMs > 0.0f ? Settings.EffectsBudgetMs : FrameTimeMs * GetBudgetFraction(EffectsQuality));
+
+    if (Now < NextEvaluateTime)
+    {
+        return;
+    }
+    NextEvaluateTime = Now + UPMEffectsEvaluateSeconds;
+
+    // Spawn less while either thread is over, more once both have room
+    const float Usage = FMath::Max(GameThreadMs, RenderThreadMs) / BudgetMs;
+    if (Usage > 1.0f)
+    {
+        SetSpawnScale(FMath::Max(UPMMinEffectsSpawnScale, SpawnScale * UPMEffectsScaleDownFactor));
+    }
+    else if (Usage < UPMEffectsRaiseUsage)
+    {
+        SetSpawnScale(FMath::Min(1.0f, SpawnScale + UPMEffectsScaleUpStep));
+    }
+}
+
+void FUPMEffectsBudget::CountSystems(UWorld* World)
+{
+    ActiveSystems = 0;
+    SystemCounts.Reset();
+    if (!World)
+    {
+        return;
+    }
+
+    TMap<const UFXSystemAsset*, int32> Counts;
+    TArray<UObject*> Components;
+    GetObjectsOfClass(UFXSystemComponent::StaticClass(), Components, true, RF_ClassDefaultObject);
+    for (UObject* Object : Components)
+    {
+        const UFXSystemComponent* Component = static_cast<const UFXSystemComponent*>(Object);
+        if (Component->GetWorld() == World && Component->IsActive())
+        {
+            ++ActiveSystems;
+            ++Counts.FindOrAdd(Component->GetFXSystemAsset());
+        }
+    }
+
+    for (const TPair<const UFXSystemAsset*, int32>& Count : Counts)
+    {
+        FUPMEffectSystemStats& Entry = SystemCounts.AddDefaulted_GetRef();
+        Entry.SystemName = Count.Key ? Count.Key->GetPathName() : TEXT("None");
+        Entry.ActiveInstances = Count.Value;
+    }
+    SystemCounts.Sort([](const FUPMEffectSystemStats& A, const FUPMEffectSystemStats& B) { return A.ActiveInstances > B.ActiveInstances; });
+}
+
+void FUPMEffectsBudget::Apply(float NewBudgetMs)
+{
+    IConsoleVariable* EnabledCVar = UPMFindEffectsCVar(TEXT("fx.Budget.Enabled"));
+    IConsoleVariable* GameThreadCVar = UPMFindEffectsCVar(TEXT("fx.Budget.GameThread"));
+    IConsoleVariable* ConcurrentCVar = UPMFindEffectsCVar(TEXT("fx.Budget.GameThreadConcurrent"));
+    IConsoleVariable* RenderThreadCVar = UPMFindEffectsCVar(TEXT("fx.Budget.RenderThread"));
+    if (!bApplied)
+    {
+        OriginalBudgetEnabled = EnabledCVar ? EnabledCVar->GetInt() : OriginalBudgetEnabled;
+        OriginalBudgetGameThread = GameThreadCVar ? GameThreadCVar->GetFloat() : OriginalBudgetGameThread;
+        OriginalBudgetGameThreadConcurrent = ConcurrentCVar ? ConcurrentCVar->GetFloat() : OriginalBudgetGameThreadConcurrent;
+        OriginalBudgetRenderThread = RenderThreadCVar ? RenderThreadCVar->GetFloat() : OriginalBudgetRenderThread;
+        if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.NiagaraGlobalSpawnCountScale")))
+        {
+            OriginalNiagaraSpawnScale = CVar->GetFloat();
+        }
+        if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("r.EmitterSpawnRateScale")))
+        {
+            OriginalCascadeSpawnScale = CVar->GetFloat();
+        }
+        SpawnScale = 1.0f;
+        bApplied = true;
+    }
+
+    BudgetMs = FMath::Max(0.1f, NewBudgetMs);
+    if (EnabledCVar && EnabledCVar->GetInt() != 1)
+    {
+        EnabledCVar->Set(1);
+    }
+    for (IConsoleVariable* CVar : { GameThreadCVar, ConcurrentCVar, RenderThreadCVar })
+    {
+        if (CVar && !FMath::IsNearlyEqual(CVar->GetFloat(), BudgetMs))
+        {
+            CVar->Set(BudgetMs);
+        }
+    }
+}
+
+void FUPMEffectsBudget::SetSpawnScale(float Scale)
+{
+    if (Scale == SpawnScale)
+    {
+        return;
+    }
+    SpawnScale = Scale;
+
+    // Relative to the project's own scales
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.NiagaraGlobalSpawnCountScale")))
+    {
+        CVar->Set(OriginalNiagaraSpawnScale * SpawnScale);
+    }
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("r.EmitterSpawnRateScale")))
+    {
+        CVar->Set(OriginalCascadeSpawnScale * SpawnScale);
+    }
+}
+
+void FUPMEffectsBudget::Restore()
+{
+    if (!bApplied)
+    {
+        return;
+    }
+
+    SetSpawnScale(1.0f);
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.Budget.Enabled")))
+    {
+        CVar->Set(OriginalBudgetEnabled);
+    }
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.Budget.GameThread")))
+    {
+        CVar->Set(OriginalBudgetGameThread);
+    }
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.Budget.GameThreadConcurrent")))
+    {
+        CVar->Set(OriginalBudgetGameThreadConcurrent);
+    }
+    if (IConsoleVariable* CVar = UPMFindEffectsCVar(TEXT("fx.Budget.RenderThread")))
+    {
+        CVar->Set(OriginalBudgetRenderThread);
+    }
+    bApplied = false;
+    BudgetMs = 0.0f;
+}
+
+void FUPMEffectsBudget::FillMetrics(FUPMProcessMetrics& Metrics) const
+{
+    Metrics.ActiveEffectSystems = ActiveSystems;
+    Metrics.EffectsGameThreadMs = GameThreadMs;
+    Metrics.EffectsRenderThreadMs = RenderThreadMs;
+    Metrics.EffectsBudgetMs = BudgetMs;
+    Metrics.EffectsSpawnScale = SpawnScale;
+}
+
+void FUPMEffectsBudget::GetTopSystems(int32 MaxEntries, TArray<FUPMEffectSystemStats>& OutSystems) const
+{
+    OutSystems.Reset();
+    OutSystems.Append(SystemCounts.GetData(), FMath::Min(MaxEntries, SystemCounts.Num()));
+}
@@ -0,0 +1,61 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Runtime effects budget
+ *
+ * Effects get a share of the frame that grows with EffectsQuality. The engine's FX budget (fx.Budget.*) measures
+ * the game and render thread time of all particle systems against it; Niagara effect types with budget scaling
+ * use that to cull and shorten their distances. On top of that, while effects time stays over the budget the
+ * global spawn count scale of Niagara and the Cascade spawn rate scale are lowered, and raised again once it
+ * has room.
+ *
+ * Active systems are counted per asset at low frequency while the budget is on.
+ */
+class FUPMEffectsBudget
+{
+public:
+    FUPMEffectsBudget();
+
+    /** Game thread, once per frame. FrameRateTarget 0 = uncapped (60 is assumed) */
+    void Tick(UWorld* World, const FUPMPerformanceSettings& Settings, int32 EffectsQuality, float FrameRateTarget);
+
+    /** Put the engine's own values back */
+    void Restore();
+
+    void FillMetrics(FUPMProcessMetrics& Metrics) const;
+
+    /** Assets with the most active systems, most first */
+    void GetTopSystems(int32 MaxEntries, TArray<FUPMEffectSystemStats>& OutSystems) const;
+
+    /** Share of the frame effects get at an EffectsQuality level */
+    static float GetBudgetFraction(int32 EffectsQuality);
+
+private:
+    void CountSystems(UWorld* World);
+    void Apply(float BudgetMs);
+    void SetSpawnScale(float Scale);
+
+    // Engine values before the first change
+    bool bApplied;
+    int32 OriginalBudgetEnabled;
+    float OriginalBudgetGameThread;
+    float OriginalBudgetGameThreadConcurrent;
+    float OriginalBudgetRenderThread;
+    float OriginalNiagaraSpawnScale;
+    float OriginalCascadeSpawnScale;
+
+    float BudgetMs;
+    float GameThreadMs;
+    float RenderThreadMs;
+    float SpawnScale;
+    double NextEvaluateTime;
+
+    double NextCountTime;
+    int32 ActiveSystems;
+    TArray<FUPMEffectSystemStats> SystemCounts;
+};
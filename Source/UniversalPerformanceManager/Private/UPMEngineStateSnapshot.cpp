@@ -0,0 +1,53 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMEngineStateSnapshot.h"
+#include "GameFramework/GameUserSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+
+void FUPMEngineStateSnapshot::Capture()
+{
+    Variables.Reset();
+    IConsoleManager::Get().ForEachConsoleObjectThatStartsWith(FConsoleObjectVisitor::CreateLambda(
+        [this](const TCHAR* Name, IConsoleObject* Object)
+        {
+            IConsoleVariable* Variable = Object->AsVariable();
+            if (Variable && !Variable->TestFlags(ECVF_ReadOnly))
+            {
+                Variables.Add({ Variable, Variable->GetString(), static_cast<EConsoleVariableFlags>(Variable->GetFlags() & ECVF_SetByMask) });
+            }
+        }), TEXT(""));
+
+    bHadUserSettingsFile = FFileHelper::LoadFileToString(UserSettingsFile, *GGameUserSettingsIni);
+}
+
+void FUPMEngineStateSnapshot::Restore()
+{
+    // Put the file back and reload it, then let the engine's own settings object re-apply resolution,
+    // window mode and scalability from it
+    if (bHadUserSettingsFile)
+    {
+        FFileHelper::SaveStringToFile(UserSettingsFile, *GGameUserSettingsIni);
+    }
+    else
+    {
+        IFileManager::Get().Delete(*GGameUserSettingsIni);
+    }
+
+    if (UGameUserSettings* GameSettings = UGameUserSettings::GetGameUserSettings())
+    {
+        GameSettings->LoadSettings(true);
+        GameSettings->ApplySettings(false);
+    }
+
+    // Whatever else was changed; a value can only be set at or above the priority that set it last
+    for (const FVariableValue& Saved : Variables)
+    {
+        if (Saved.Variable->GetString() != Saved.Value)
+        {
+            const EConsoleVariableFlags CurrentSetBy = static_cast<EConsoleVariableFlags>(Saved.Variable->GetFlags() & ECVF_SetByMask);
+            Saved.Variable->Set(*Saved.Value, FMath::Max(Saved.SetBy, CurrentSetBy));
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Engine state the Apply*Settings paths overwrite: every console variable and GameUserSettings.ini, which
+ * UGameUserSettings::ApplySettings and the audio sample rate save on every call
+ *
+ * Lets the self-benchmark and automation tests apply arbitrary settings without leaving them behind.
+ */
+class FUPMEngineStateSnapshot
+{
+public:
+    void Capture();
+
+    /** Writes the file back, re-applies it through UGameUserSettings and resets every changed console variable */
+    void Restore();
+
+private:
+    struct FVariableValue
+    {
+        IConsoleVariable* Variable;
+        FString Value;
+        EConsoleVariableFlags SetBy;
+    };
+
+    TArray<FVariableValue> Variables;
+    FString UserSettingsFile;
+    bool bHadUserSettingsFile = false;
+};
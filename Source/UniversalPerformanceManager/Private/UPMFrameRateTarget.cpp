@@ -0,0 +1,216 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMFrameRateTarget.h"
+#include "UPMStatistics.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+#include "RHI.h"
+#include "RenderCore.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <dxgi1_5.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+// Frame rate target tuning
+static const int32 UPMFrameRateCostFrames = 240;         // Frame costs the P95 is taken over
+static const double UPMFrameRateEvaluateSeconds = 2.0;   // How often the target is re-evaluated
+static const double UPMFrameRateDisplayCheckSeconds = 1.0;
+static const float UPMFrameRateBudgetFraction = 0.9f;    // P95 must fit in this much of the target's frame time
+static const float UPMFrameRateRaiseFraction = 0.75f;    // ... and in this much to move to a higher target
+static const float UPMFrameRateMinTarget = 30.0f;
+static const float UPMFrameRateVRRMargin = 0.97f;        // VRR cap below the maximum refresh, so VSync stays idle
+static const float UPMFrameRateMaxSampleSeconds = 0.25f; // Longer frames (loads, hitches) are not sampled
+
+#if PLATFORM_WINDOWS
+/** DXGI tearing support, which windowed variable refresh rate needs */
+static bool UPMIsTearingSupported()
+{
+    static const bool bSupported = []()
+    {
+        // Looked up at runtime, so neither this module nor the modules depending on it link dxgi.lib
+        typedef HRESULT(WINAPI* FCreateDXGIFactory1)(REFIID, void**);
+        void* DXGIModule = FPlatformProcess::GetDllHandle(TEXT("dxgi.dll"));
+        FCreateDXGIFactory1 CreateFactory = DXGIModule ? reinterpret_cast<FCreateDXGIFactory1>(FPlatformProcess::GetDllExport(DXGIModule, TEXT("CreateDXGIFactory1"))) : nullptr;
+
+        BOOL bAllowTearing = 0;
+        IDXGIFactory5* Factory = nullptr;
+        if (CreateFactory && SUCCEEDED(CreateFactory(__uuidof(IDXGIFactory5), reinterpret_cast<void**>(&Factory))) && Factory)
+        {
+            if (FAILED(Factory->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &bAllowTearing, sizeof(bAllowTearing))))
+            {
+                bAllowTearing = 0;
+            }
+            Factory->Release();
+        }
+        if (DXGIModule)
+        {
+            FPlatformProcess::FreeDllHandle(DXGIModule);
+        }
+        return bAllowTearing != 0;
+    }();
+    return bSupported;
+}
+#endif
+
+FUPMFrameRateTarget::FUPMFrameRateTarget()
+    : NextDisplayCheckTime(0.0)
+    , NextEvaluationTime(0.0)
+    , FrameCostIndex(0)
+    , Target(0.0f)
+    , SyncInterval(1)
+    , bTargetVariableRefreshRate(false)
+{
+    FrameCosts.Reserve(UPMFrameRateCostFrames);
+}
+
+FUPMDisplayRefreshInfo FUPMFrameRateTarget::QueryDisplay()
+{
+    FUPMDisplayRefreshInfo Info;
+    const TSharedPtr<SWindow> Window = GEngine && GEngine->GameViewport ? GEngine->GameViewport->GetWindow() : nullptr;
+
+#if PLATFORM_WINDOWS
+    // The monitor the window is on; the RHI only knows the outputs of the primary adapter
+    const TSharedPtr<FGenericWindow> NativeWindow = Window.IsValid() ? Window->GetNativeWindow() : nullptr;
+    const HWND WindowHandle = NativeWindow.IsValid() ? static_cast<HWND>(NativeWindow->GetOSWindowHandle()) : nullptr;
+    MONITORINFOEXW MonitorInfo;
+    MonitorInfo.cbSize = sizeof(MonitorInfo);
+    DEVMODEW DevMode;
+    DevMode.dmSize = sizeof(DevMode);
+    DevMode.dmDriverExtra = 0;
+    if (WindowHandle && GetMonitorInfoW(MonitorFromWindow(WindowHandle, MONITOR_DEFAULTTOPRIMARY), &MonitorInfo)
+        && EnumDisplaySettingsW(MonitorInfo.szDevice, ENUM_CURRENT_SETTINGS, &DevMode) && DevMode.dmDisplayFrequency > 1)
+    {
+        Info.MonitorId = MonitorInfo.szDevice;
+        Info.RefreshRate = static_cast<float>(DevMode.dmDisplayFrequency);
+        Info.bVariableRefreshRateSupported = UPMIsTearingSupported();
+        return Info;
+    }
+#endif
+
+    // Other platforms: the monitor under the window center, and the highest refresh rate of the current mode
+    if (Window.IsValid() && FSlateApplication::IsInitialized())
+    {
+        FDisplayMetrics DisplayMetrics;
+        FSlateApplication::Get().GetCachedDisplayMetrics(DisplayMetrics);
+        const FVector2D Center = Window->GetPositionInScreen() + Window->GetSizeInScreen() * 0.5f;
+        for (const FMonitorInfo& Monitor : DisplayMetrics.MonitorInfo)
+        {
+            if (Center.X >= Monitor.DisplayRect.Left && Center.X < Monitor.DisplayRect.Right
+                && Center.Y >= Monitor.DisplayRect.Top && Center.Y < Monitor.DisplayRect.Bottom)
+            {
+                Info.MonitorId = Monitor.ID;
+                break;
+            }
+        }
+    }
+
+    Info.RefreshRate = static_cast<float>(FMath::Max(FPlatformMisc::GetMaxRefreshRate(), 1));
+    FScreenResolutionArray Resolutions;
+    if (GEngine && GEngine->GameViewport && RHIGetAvailableResolutions(Resolutions, true))
+    {
+        FVector2D ViewportSize;
+        GEngine->GameViewport->GetViewportSize(ViewportSize);
+        for (const FScreenResolutionRHI& Resolution : Resolutions)
+        {
+            if (Resolution.Width == static_cast<uint32>(ViewportSize.X) && Resolution.Height == static_cast<uint32>(ViewportSize.Y) && Resolution.RefreshRate > 1)
+            {
+                Info.RefreshRate = FMath::Max(Info.RefreshRate, static_cast<float>(Resolution.RefreshRate));
+            }
+        }
+    }
+    return Info;
+}
+
+TArray<float> FUPMFrameRateTarget::GetTargets(const FUPMDisplayRefreshInfo& Display, bool bVariableRefreshRate)
+{
+    TArray<float> Targets;
+    if (bVariableRefreshRate && Display.bVariableRefreshRateSupported)
+    {
+        Targets.Add(FMath::FloorToFloat(Display.RefreshRate * UPMFrameRateVRRMargin));
+    }
+    for (int32 Divisor = 1; Display.RefreshRate / Divisor >= UPMFrameRateMinTarget || Divisor == 1; ++Divisor)
+    {
+        const float Candidate = Display.RefreshRate / Divisor;
+        if (Targets.Num() == 0 || Candidate < Targets[0])
+        {
+            Targets.Add(Candidate);
+        }
+    }
+    return Targets;
+}
+
+bool FUPMFrameRateTarget::Tick(float DeltaTime, const FUPMPerformanceSettings& Settings)
+{
+    const double Now = FPlatformTime::Seconds();
+    bool bDisplayChanged = false;
+    if (Now >= NextDisplayCheckTime)
+    {
+        NextDisplayCheckTime = Now + UPMFrameRateDisplayCheckSeconds;
+        const FUPMDisplayRefreshInfo NewDisplay = QueryDisplay();
+        if (NewDisplay.MonitorId != Display.MonitorId || NewDisplay.RefreshRate != Display.RefreshRate
+            || NewDisplay.bVariableRefreshRateSupported != Display.bVariableRefreshRateSupported)
+        {
+            UE_LOG(LogTemp, Log, TEXT("UPM: Display %s at %.0f Hz%s"), *NewDisplay.MonitorId, NewDisplay.RefreshRate,
+                NewDisplay.bVariableRefreshRateSupported ? TEXT(", VRR capable") : TEXT(""));
+            Display = NewDisplay;
+            bDisplayChanged = true;
+        }
+    }
+
+    // Work per frame without waits: what the frame would take uncapped
+    if (DeltaTime > 0.0f && DeltaTime <= UPMFrameRateMaxSampleSeconds)
+    {
+        const float FrameCost = FMath::Max3(FPlatformTime::ToMilliseconds(GGameThreadTime), FPlatformTime::ToMilliseconds(GRenderThreadTime),
+            FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+        if (FrameCosts.Num() < UPMFrameRateCostFrames)
+        {
+            FrameCosts.Add(FrameCost);
+        }
+        else
+        {
+            FrameCosts[FrameCostIndex] = FrameCost;
+            FrameCostIndex = (FrameCostIndex + 1) % UPMFrameRateCostFrames;
+        }
+    }
+
+    const bool bModeChanged = Settings.bVariableRefreshRate != bTargetVariableRefreshRate;
+    if (!bDisplayChanged && !bModeChanged && (Now < NextEvaluationTime || FrameCosts.Num() < UPMFrameRateCostFrames))
+    {
+        return false;
+    }
+    NextEvaluationTime = Now + UPMFrameRateEvaluateSeconds;
+    return Evaluate(Settings);
+}
+
+bool FUPMFrameRateTarget::Evaluate(const FUPMPerformanceSettings& Settings)
+{
+    const TArray<float> Targets = GetTargets(Display, Settings.bVariableRefreshRate);
+    const float P95CostMs = FrameCosts.Num() > 0 ? FUPMStatistics::Percentile(FrameCosts, 95.0f) : 0.0f;
+
+    // Highest target that fits; the current one is kept at the lower margin, higher ones need the raise margin
+    float NewTarget = Targets.Last();
+    for (const float Candidate : Targets)
+    {
+        const float Fraction = Candidate > Target ? UPMFrameRateRaiseFraction : UPMFrameRateBudgetFraction;
+        if (P95CostMs <= 1000.0f / Candidate * Fraction)
+        {
+            NewTarget = Candidate;
+            break;
+        }
+    }
+
+    const bool bVariableRefreshRate = Settings.bVariableRefreshRate && Display.bVariableRefreshRateSupported;
+    const int32 NewSyncInterval = bVariableRefreshRate ? 1 : FMath::Max(1, FMath::RoundToInt(Display.RefreshRate / NewTarget));
+    const bool bChanged = NewTarget != Target || NewSyncInterval != SyncInterval || bTargetVariableRefreshRate != Settings.bVariableRefreshRate;
+    UE_CLOG(NewTarget != Target, LogTemp, Log, TEXT("UPM: Frame rate target %.1f (P95 frame cost %.1f ms, %.0f Hz display%s)"),
+        NewTarget, P95CostMs, Display.RefreshRate, bVariableRefreshRate ? TEXT(", VRR") : TEXT(""));
+
+    Target = NewTarget;
+    SyncInterval = NewSyncInterval;
+    bTargetVariableRefreshRate = Settings.bVariableRefreshRate;
+    return bChanged;
+}
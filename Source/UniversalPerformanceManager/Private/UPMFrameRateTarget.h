@@ -0,0 +1,55 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Refresh-rate-aware frame rate target
+ *
+ * A cap that does not divide the refresh rate shows some frames for one refresh and others for two, which reads
+ * as judder. The targets offered are therefore the refresh rate and its integer divisors (144 Hz: 144, 72, 48,
+ * 36), paced with the RHI sync interval when VSync is on. Under variable refresh rate the display follows the
+ * game, and the target sits just below the maximum refresh so VSync never engages.
+ *
+ * The frame cost (the busiest of game thread, render thread and GPU, without waits) is sampled every frame; the
+ * highest target whose budget covers its P95 is chosen. Moving up needs extra headroom so the target does not
+ * oscillate. The monitor under the game window is checked periodically and the targets rebuilt when it changes.
+ */
+class FUPMFrameRateTarget
+{
+public:
+    FUPMFrameRateTarget();
+
+    /** Refresh rate and VRR support of the monitor showing the game window */
+    static FUPMDisplayRefreshInfo QueryDisplay();
+
+    static TArray<float> GetTargets(const FUPMDisplayRefreshInfo& Display, bool bVariableRefreshRate);
+
+    /** Game thread, once per frame; true when the target changed */
+    bool Tick(float DeltaTime, const FUPMPerformanceSettings& Settings);
+
+    /** Target in frames per second, 0 before the first evaluation */
+    float GetTarget() const { return Target; }
+
+    /** Refreshes per frame when the target is paced by VSync */
+    int32 GetSyncInterval() const { return SyncInterval; }
+
+    const FUPMDisplayRefreshInfo& GetDisplay() const { return Display; }
+
+private:
+    bool Evaluate(const FUPMPerformanceSettings& Settings);
+
+    FUPMDisplayRefreshInfo Display;
+    double NextDisplayCheckTime;
+    double NextEvaluationTime;
+
+    // Recent frame costs (ms)
+    TArray<float> FrameCosts;
+    int32 FrameCostIndex;
+
+    float Target;
+    int32 SyncInterval;
+    bool bTargetVariableRefreshRate;
+};
@@ -0,0 +1,141 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMFrameTimeComparison.h"
+#include "UPMStatistics.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+
+static const float UPMComparedPercentiles[] = { 50.0f, 95.0f, 99.0f };
+
+/** Resample Values in blocks of consecutive frames into OutSample (same length) */
+static void UPMBlockResample(const TArray<float>& Values, int32 BlockLength, FRandomStream& Random, TArray<float>& OutSample)
+{
+    OutSample.Reset(Values.Num());
+    const int32 MaxStart = FMath::Max(0, Values.Num() - BlockLength);
+    while (OutSample.Num() < Values.Num())
+    {
+        const int32 Start = Random.RandRange(0, MaxStart);
+        const int32 Count = FMath::Min(BlockLength, Values.Num() - OutSample.Num());
+        OutSample.Append(Values.GetData() + Start, FMath::Min(Count, Values.Num() - Start));
+    }
+}
+
+bool FUPMFrameTimeComparison::LoadFrameTimes(const FString& FilePath, TArray<float>& OutFrameTimes, const FString& Column)
+{
+    TArray<FString> Lines;
+    if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath) || Lines.Num() < 2)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to read frame times from file: %s"), *FilePath);
+        return false;
+    }
+
+    TArray<FString> Header;
+    Lines[0].ParseIntoArray(Header, TEXT(","));
+    const int32 ColumnIndex = Header.IndexOfByPredicate([&Column](const FString& Name) { return Name.TrimStartAndEnd() == Column; });
+    if (ColumnIndex == INDEX_NONE)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Column %s not found in %s"), *Column, *FilePath);
+        return false;
+    }
+
+    OutFrameTimes.Reset(Lines.Num() - 1);
+    TArray<FString> Fields;
+    for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+    {
+        Lines[LineIndex].ParseIntoArray(Fields, TEXT(","));
+        if (Fields.IsValidIndex(ColumnIndex))
+        {
+            OutFrameTimes.Add(FCString::Atof(*Fields[ColumnIndex]));
+        }
+    }
+    return OutFrameTimes.Num() > 0;
+}
+
+FUPMFrameTimeComparisonResult FUPMFrameTimeComparison::Compare(const TArray<float>& Baseline, const TArray<float>& Candidate,
+    const FUPMFrameTimeComparisonOptions& Options)
+{
+    FUPMFrameTimeComparisonResult Result;
+    Result.BaselineFrames = Baseline.Num();
+    Result.CandidateFrames = Candidate.Num();
+    if (Baseline.Num() == 0 || Candidate.Num() == 0)
+    {
+        return Result;
+    }
+
+    FUPMStatistics::MannWhitneyU(Candidate, Baseline, Result.ProbabilityOfSuperiority, Result.MannWhitneyPValue);
+    Result.RankBiserial = 2.0 * Result.ProbabilityOfSuperiority - 1.0;
+
+    TArray<float> SortedBaseline = Baseline;
+    TArray<float> SortedCandidate = Candidate;
+    SortedBaseline.Sort();
+    SortedCandidate.Sort();
+
+    // Bootstrap distributions of the percentile differences, all percentiles from the same resamples
+    const int32 NumPercentiles = UE_ARRAY_COUNT(UPMComparedPercentiles);
+    const int32 Iterations = FMath::Max(Options.BootstrapIterations, 100);
+    const int32 BaselineBlock = Options.BlockLength > 0 ? Options.BlockLength : FMath::Max(1, FMath::RoundToInt(FMath::Pow(Baseline.Num(), 1.0f / 3.0f)));
+    const int32 CandidateBlock = Options.BlockLength > 0 ? Options.BlockLength : FMath::Max(1, FMath::RoundToInt(FMath::Pow(Candidate.Num(), 1.0f / 3.0f)));
+
+    TArray<TArray<float>> Differences;
+    Differences.SetNum(NumPercentiles);
+    for (TArray<float>& PercentileDifferences : Differences)
+    {
+        PercentileDifferences.Reserve(Iterations);
+    }
+
+    FRandomStream Random(Options.Seed);
+    TArray<float> BaselineSample;
+    TArray<float> CandidateSample;
+    for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+    {
+        UPMBlockResample(Baseline, BaselineBlock, Random, BaselineSample);
+        UPMBlockResample(Candidate, CandidateBlock, Random, CandidateSample);
+        BaselineSample.Sort();
+        CandidateSample.Sort();
+
+        for (int32 Index = 0; Index < NumPercentiles; ++Index)
+        {
+            Differences[Index].Add(FUPMStatistics::PercentileSorted(CandidateSample, UPMComparedPercentiles[Index])
+                - FUPMStatistics::PercentileSorted(BaselineSample, UPMComparedPercentiles[Index]));
+        }
+    }
+
+    const float TailPercent = Options.Alpha * 0.5f * 100.0f;
+    for (int32 Index = 0; Index < NumPercentiles; ++Index)
+    {
+        FUPMPercentileChange Change;
+        Change.Percentile = UPMComparedPercentiles[Index];
+        Change.BaselineMs = FUPMStatistics::PercentileSorted(SortedBaseline, Change.Percentile);
+        Change.CandidateMs = FUPMStatistics::PercentileSorted(SortedCandidate, Change.Percentile);
+        Change.DifferenceMs = Change.CandidateMs - Change.BaselineMs;
+        Change.RelativeChange = Change.BaselineMs > 0.0f ? Change.DifferenceMs / Change.BaselineMs : 0.0f;
+
+        Differences[Index].Sort();
+        Change.DifferenceLowMs = FUPMStatistics::PercentileSorted(Differences[Index], TailPercent);
+        Change.DifferenceHighMs = FUPMStatistics::PercentileSorted(Differences[Index], 100.0f - TailPercent);
+
+        const bool bIntervalExcludesZero = Change.DifferenceLowMs > 0.0f || Change.DifferenceHighMs < 0.0f;
+        Change.bSignificant = bIntervalExcludesZero && FMath::Abs(Change.RelativeChange) >= Options.MinRelativeChange;
+
+        Result.bRegression |= Change.bSignificant && Change.DifferenceMs > 0.0f;
+        Result.bImprovement |= Change.bSignificant && Change.DifferenceMs < 0.0f;
+        Result.Percentiles.Add(Change);
+    }
+
+    Result.bImprovement &= !Result.bRegression;
+    return Result;
+}
+
+void FUPMFrameTimeComparison::PrintReport(const FUPMFrameTimeComparisonResult& Result, FOutputDevice& Ar)
+{
+    Ar.Logf(TEXT("UPM: Frame time comparison, %d baseline vs %d candidate frames"), Result.BaselineFrames, Result.CandidateFrames);
+    for (const FUPMPercentileChange& Change : Result.Percentiles)
+    {
+        Ar.Logf(TEXT("UPM:   P%-3.0f %8.3f -> %8.3f ms  %+7.3f ms (%+.1f%%)  CI [%+.3f, %+.3f]  %s"),
+            Change.Percentile, Change.BaselineMs, Change.CandidateMs, Change.DifferenceMs, Change.RelativeChange * 100.0f,
+            Change.DifferenceLowMs, Change.DifferenceHighMs, Change.bSignificant ? TEXT("SIGNIFICANT") : TEXT("not significant"));
+    }
+    Ar.Logf(TEXT("UPM:   Mann-Whitney p = %.4g, P(candidate frame slower) = %.3f, rank-biserial r = %+.3f"),
+        Result.MannWhitneyPValue, Result.ProbabilityOfSuperiority, Result.RankBiserial);
+    Ar.Logf(TEXT("UPM:   Verdict: %s"), Result.bRegression ? TEXT("REGRESSION") : (Result.bImprovement ? TEXT("improvement") : TEXT("no significant change")));
+}
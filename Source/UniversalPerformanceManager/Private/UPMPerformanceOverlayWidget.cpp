@@ -16,6 +16,7 @@ void UUPMPerformanceOverlayWidget::NativeConstruct()
 
     // Get the settings manager instance
     SettingsManager = UUPMSettingsManager::GetInstance(this);
+    PerformanceSubsystem = UUPMPerformanceSubsystem::Get(this);
 }
 
 void UUPMPerformanceOverlayWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
@@ -35,12 +36,16 @@ void UUPMPerformanceOverlayWidget::NativeTick(const FGeometry& MyGeometry, float
     if (UpdateTimer >= UpdateInterval)
     {
         UpdateTimer = 0.0f;
-        OnPerformanceMetricsUpdated(SettingsManager->GetPerformanceMetrics());
+        OnPerformanceMetricsUpdated(GetPerformanceMetrics());
     }
 }
 
 FUPMPerformanceMetrics UUPMPerformanceOverlayWidget::GetPerformanceMetrics() const
 {
+    if (PerformanceSubsystem)
+    {
+        return PerformanceSubsystem->GetPerformanceMetrics();
+    }
     if (SettingsManager)
     {
         return SettingsManager->GetPerformanceMetrics();
@@ -65,4 +70,8 @@ void UUPMPerformanceOverlayWidget::ResetStats()
     {
         SettingsManager->ResetPerformanceStats();
     }
+    if (PerformanceSubsystem)
+    {
+        PerformanceSubsystem->ResetPerformanceStats();
+    }
 }
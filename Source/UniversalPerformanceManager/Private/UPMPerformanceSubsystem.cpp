@@ -0,0 +1,208 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMPerformanceSubsystem.h"
+#include "UPMSettingsRequestQueue.h"
+#include "UPMTickBudgetSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RHI.h"
+#include "RHIStats.h"
+#include "RenderCore.h"
+
+// Instances created so far, for names outside PIE
+static int32 GUPMPerformanceSubsystemCount = 0;
+
+UUPMPerformanceSubsystem::UUPMPerformanceSubsystem()
+    : FPSWindowSeconds(2.0f)
+    , NetworkSampleInterval(0.5f)
+    , FrameTimeHistorySum(0.0f)
+    , NetworkSampleAccumulator(0.0f)
+    , bRecordingFrameTimes(false)
+{
+}
+
+UUPMPerformanceSubsystem* UUPMPerformanceSubsystem::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+    return GameInstance ? GameInstance->GetSubsystem<UUPMPerformanceSubsystem>() : nullptr;
+}
+
+void UUPMPerformanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const FWorldContext* WorldContext = GetGameInstance()->GetWorldContext();
+    InstanceName = WorldContext && WorldContext->PIEInstance != INDEX_NONE
+        ? FString::Printf(TEXT("PIE%d"), WorldContext->PIEInstance)
+        : FString::Printf(TEXT("Instance%d"), GUPMPerformanceSubsystemCount);
+    ++GUPMPerformanceSubsystemCount;
+
+    FrameTimeHistory.Reserve(120); // 2 seconds at 60 FPS
+    ResetPerformanceStats();
+}
+
+void UUPMPerformanceSubsystem::Deinitialize()
+{
+    if (bRecordingFrameTimes)
+    {
+        StopFrameTimeRecording();
+    }
+
+    Super::Deinitialize();
+}
+
+bool UUPMPerformanceSubsystem::IsTickable() const
+{
+    return !HasAnyFlags(RF_ClassDefaultObject) && GetTickableGameObjectWorld() != nullptr;
+}
+
+UWorld* UUPMPerformanceSubsystem::GetTickableGameObjectWorld() const
+{
+    // Ticked with this instance's world, so DeltaTime is that world's frame time
+    const UGameInstance* GameInstance = GetGameInstance();
+    return GameInstance ? GameInstance->GetWorld() : nullptr;
+}
+
+TStatId UUPMPerformanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUPMPerformanceSubsystem, STATGROUP_Tickables);
+}
+
+void UUPMPerformanceSubsystem::Tick(float DeltaTime)
+{
+    if (DeltaTime <= 0.0f)
+    {
+        return;
+    }
+
+    UWorld* World = GetTickableGameObjectWorld();
+
+    // Frame statistics over the last FPSWindowSeconds
+    FrameTimeHistory.Add(DeltaTime);
+    FrameTimeHistorySum += DeltaTime;
+    int32 NumExpired = 0;
+    while (FrameTimeHistory.Num() - NumExpired > 1 && FrameTimeHistorySum - FrameTimeHistory[NumExpired] >= FPSWindowSeconds)
+    {
+        FrameTimeHistorySum -= FrameTimeHistory[NumExpired++];
+    }
+    FrameTimeHistory.RemoveAt(0, NumExpired);
+
+    float Shortest = FrameTimeHistory[0];
+    float Longest = FrameTimeHistory[0];
+    for (float FrameTime : FrameTimeHistory)
+    {
+        Shortest = FMath::Min(Shortest, FrameTime);
+        Longest = FMath::Max(Longest, FrameTime);
+    }
+
+    PerformanceMetrics.FPS_Current = 1.0f / DeltaTime;
+    PerformanceMetrics.FPS_Average = FrameTimeHistory.Num() / FrameTimeHistorySum;
+    PerformanceMetrics.FPS_Min = 1.0f / Longest;
+    PerformanceMetrics.FPS_Max = 1.0f / Shortest;
+    PerformanceMetrics.CPUFrameTime = DeltaTime * 1000.0f;
+    PerformanceMetrics.GPUFrameTime = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+    PerformanceMetrics.GameThreadLoad = FMath::Clamp(DeltaTime / 0.0166f, 0.0f, 1.0f); // 60 FPS baseline
+
+    // The world's own tick cost is what separates instances sharing one process
+    if (const UUPMTickBudgetSubsystem* TickBudget = World->GetSubsystem<UUPMTickBudgetSubsystem>())
+    {
+        PerformanceMetrics.WorldTickTimeMs = TickBudget->GetWorldTickTimeMs();
+        PerformanceMetrics.TickBudgetMs = TickBudget->GetTickBudgetMs();
+        PerformanceMetrics.ThrottledActorCount = TickBudget->GetThrottledActorCount();
+    }
+
+    // Process-wide; only read, this must not create the manager (and with it apply every setting) on its own
+    if (const UUPMSettingsManager* Manager = UUPMSettingsManager::GetExistingInstance())
+    {
+        PerformanceMetrics.Process = Manager->GetProcessMetrics();
+    }
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    PerformanceMetrics.RAMUsageMB = static_cast<float>(MemoryStats.UsedPhysical) / (1024.0f * 1024.0f);
+    if (GDynamicRHI)
+    {
+        uint64 UsedVRAM = 0;
+        RHIGetResourceMemoryUsage(UsedVRAM);
+        if (UsedVRAM > 0)
+        {
+            PerformanceMetrics.VRAMUsageMB = static_cast<float>(UsedVRAM) / (1024.0f * 1024.0f);
+        }
+    }
+
+    NetworkSampleAccumulator += DeltaTime;
+    if (NetworkSampleAccumulator >= NetworkSampleInterval)
+    {
+        NetworkSampleAccumulator = 0.0f;
+        UUPMSettingsManager::ReadWorldNetworkMetrics(World, PerformanceMetrics, ServerNetworkStats);
+    }
+
+    if (bRecordingFrameTimes)
+    {
+        TStaticArray<float, 5>& Sample = RecordedFrameTimes.AddDefaulted_GetRef();
+        Sample[0] = DeltaTime * 1000.0f;
+        Sample[1] = FPlatformTime::ToMilliseconds(GGameThreadTime);
+        Sample[2] = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+        Sample[3] = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+        Sample[4] = PerformanceMetrics.WorldTickTimeMs;
+    }
+}
+
+void UUPMPerformanceSubsystem::ResetPerformanceStats()
+{
+    FrameTimeHistory.Reset();
+    FrameTimeHistorySum = 0.0f;
+    PerformanceMetrics = FUPMPerformanceMetrics();
+    ServerNetworkStats = FUPMServerNetworkStats();
+}
+
+void UUPMPerformanceSubsystem::StartFrameTimeRecording()
+{
+    RecordedFrameTimes.Reset();
+    RecordedFrameTimes.Reserve(60 * 60 * 5); // Five minutes at 60 FPS
+    bRecordingFrameTimes = true;
+    UE_LOG(LogTemp, Log, TEXT("UPM: Frame time recording started for %s"), *InstanceName);
+}
+
+FString UUPMPerformanceSubsystem::StopFrameTimeRecording(const FString& FilePath)
+{
+    if (!bRecordingFrameTimes)
+    {
+        return FString();
+    }
+    bRecordingFrameTimes = false;
+
+    const FString OutputPath = !FilePath.IsEmpty() ? FilePath
+        : FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("FrameTimes") / FString::Printf(TEXT("%s-%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *InstanceName);
+
+    FString Csv = TEXT("FrameTimeMs,GameThreadMs,RenderThreadMs,GPUMs,WorldTickMs");
+    Csv += LINE_TERMINATOR;
+    for (const TStaticArray<float, 5>& Sample : RecordedFrameTimes)
+    {
+        Csv += FString::Printf(TEXT("%.3f,%.3f,%.3f,%.3f,%.3f"), Sample[0], Sample[1], Sample[2], Sample[3], Sample[4]);
+        Csv += LINE_TERMINATOR;
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write frame times to file: %s"), *OutputPath);
+        return FString();
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Recorded %d frames of %s to %s"), RecordedFrameTimes.Num(), *InstanceName, *OutputPath);
+    RecordedFrameTimes.Empty();
+    return OutputPath;
+}
+
+UUPMSettingsManager* UUPMPerformanceSubsystem::GetSettingsManager() const
+{
+    return UUPMSettingsManager::GetInstance(GetGameInstance());
+}
+
+void UUPMPerformanceSubsystem::RequestSetting(const FString& SettingPath, float Value, int32 Priority)
+{
+    FUPMSettingsRequestQueue::Request(SettingPath, Value, InstanceName, Priority);
+}
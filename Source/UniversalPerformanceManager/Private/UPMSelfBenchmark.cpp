@@ -0,0 +1,225 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSelfBenchmark.h"
+#include "UPMSettingsManager.h"
+#include "UPMEngineStateSnapshot.h"
+#include "Interfaces/IPluginManager.h"
+#include "Json.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+// Self-benchmark tuning
+static const double UPMSelfBenchmarkMinBatchSeconds = 0.002;
+static const int32 UPMSelfBenchmarkMaxBatchSize = 1 << 20;
+static const int32 UPMSelfBenchmarkSamples = 11;
+static const int32 UPMSelfBenchmarkHistorySizes[] = { 60, 120, 1000, 10000 };
+
+// Keeps results of benchmarked calls alive so they are not optimized away
+static volatile int32 GUPMSelfBenchmarkSink = 0;
+
+double FUPMSelfBenchmark::MeasureMicroseconds(TFunctionRef<void()> Operation)
+{
+    // Grow the batch until it is long enough to time reliably; this doubles as warmup
+    int32 BatchSize = 1;
+    for (;;)
+    {
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < BatchSize; ++Index)
+        {
+            Operation();
+        }
+        if (FPlatformTime::Seconds() - Start >= UPMSelfBenchmarkMinBatchSeconds || BatchSize >= UPMSelfBenchmarkMaxBatchSize)
+        {
+            break;
+        }
+        BatchSize *= 2;
+    }
+
+    TArray<double> Samples;
+    for (int32 Sample = 0; Sample < UPMSelfBenchmarkSamples; ++Sample)
+    {
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < BatchSize; ++Index)
+        {
+            Operation();
+        }
+        Samples.Add((FPlatformTime::Seconds() - Start) * 1e6 / BatchSize);
+    }
+
+    Samples.Sort();
+    return Samples[Samples.Num() / 2];
+}
+
+bool FUPMSelfBenchmark::Run(UUPMSettingsManager* SettingsSource, const FUPMSelfBenchmarkOptions& Options, TArray<FUPMSelfBenchmarkCase>& OutCases, FOutputDevice& Ar)
+{
+    OutCases.Reset();
+    if (!SettingsSource)
+    {
+        return false;
+    }
+
+    FUPMEngineStateSnapshot EngineState;
+    EngineState.Capture();
+
+    // A private copy that is never initialized: no listeners, helpers, queued requests or world, and nothing
+    // it does touches the source manager's settings, history or metrics
+    UUPMSettingsManager* Manager = NewObject<UUPMSettingsManager>(GetTransientPackage());
+    Manager->AddToRoot();
+    Manager->CurrentSettings = SettingsSource->CurrentSettings;
+    Manager->CommittedSettings = SettingsSource->CurrentSettings;
+    Manager->SettingsFilePathOverride = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("SelfBenchmarkSettings.json");
+
+    auto AddCase = [&OutCases, &Ar](const FString& Name, TFunctionRef<void()> Operation)
+    {
+        FUPMSelfBenchmarkCase Case;
+        Case.Name = Name;
+        Case.MedianMicroseconds = MeasureMicroseconds(Operation);
+        OutCases.Add(Case);
+    };
+
+    // Metrics update at growing history sizes; the history is trimmed back after every call
+    for (int32 HistorySize : UPMSelfBenchmarkHistorySizes)
+    {
+        Manager->FPSHistory.Init(60.0f, HistorySize);
+        AddCase(FString::Printf(TEXT("UpdatePerformanceMetrics/History%d"), HistorySize), [Manager, HistorySize]()
+        {
+            Manager->UpdatePerformanceMetrics(1.0f / 60.0f);
+            Manager->FPSHistory.SetNum(HistorySize);
+            Manager->FPSHistoryTimeAccumulator = 0.0f;
+        });
+    }
+
+    AddCase(TEXT("ApplyGraphicsSettings"), [Manager]() { Manager->ApplyGraphicsSettings(); });
+    AddCase(TEXT("ApplyRenderingSettings"), [Manager]() { Manager->ApplyRenderingSettings(); });
+    AddCase(TEXT("ApplyPerformanceSettings"), [Manager]() { Manager->ApplyPerformanceSettings(); });
+    AddCase(TEXT("ApplyDisplaySettings"), [Manager]() { Manager->ApplyDisplaySettings(); });
+    AddCase(TEXT("ApplyAudioSettings"), [Manager]() { Manager->ApplyAudioSettings(); });
+    AddCase(TEXT("ApplyGameplaySettings"), [Manager]() { Manager->ApplyGameplaySettings(); });
+    AddCase(TEXT("ApplyAccessibilitySettings"), [Manager]() { Manager->ApplyAccessibilitySettings(); });
+    AddCase(TEXT("ApplyNetworkSettings"), [Manager]() { Manager->ApplyNetworkSettings(); });
+    AddCase(TEXT("ApplyDebugSettings"), [Manager]() { Manager->ApplyDebugSettings(); });
+    AddCase(TEXT("ApplyServerSettings"), [Manager]() { Manager->ApplyServerSettings(); });
+    AddCase(TEXT("ApplyAllSettings"), [Manager]() { Manager->ApplyAllSettings(); });
+
+    // Save first so LoadSettings reads back exactly the current settings
+    AddCase(TEXT("SaveSettings"), [Manager]() { GUPMSelfBenchmarkSink = Manager->SaveSettings(); });
+    AddCase(TEXT("LoadSettings"), [Manager]() { GUPMSelfBenchmarkSink = Manager->LoadSettings(); });
+
+    const TSharedPtr<FJsonObject> SettingsObject = Manager->SettingsToJson();
+    AddCase(TEXT("SettingsToJson"), [Manager]() { GUPMSelfBenchmarkSink = Manager->SettingsToJson()->Values.Num(); });
+    AddCase(TEXT("JsonToSettings"), [Manager, &SettingsObject]() { GUPMSelfBenchmarkSink = Manager->JsonToSettings(SettingsObject); });
+    AddCase(TEXT("GetAllSettings"), [Manager]()
+    {
+        const FUPMCompleteSettings Copy = Manager->GetAllSettings();
+        GUPMSelfBenchmarkSink = Copy.Graphics.ShadowQuality;
+    });
+
+    Manager->RemoveFromRoot();
+
+    // The copy applied its own values without the running manager's helpers (frame rate target, upscaler, eco mode);
+    // put the engine back as it was, then let the running manager, whichever settings were benchmarked, re-apply its state
+    EngineState.Restore();
+    if (UUPMSettingsManager* LiveManager = UUPMSettingsManager::GetExistingInstance())
+    {
+        LiveManager->ApplyAllSettings();
+    }
+
+    // Compare against the baseline
+    const FString BaselinePath = !Options.BaselinePath.IsEmpty() ? Options.BaselinePath : GetDefaultBaselinePath();
+
+    TMap<FString, double> Baseline;
+    const bool bHasBaseline = !BaselinePath.IsEmpty() && LoadBaseline(BaselinePath, Baseline);
+
+    // Without a baseline nothing is checked, so that is a failure rather than a silent pass
+    bool bPassed = bHasBaseline || Options.bUpdateBaseline;
+    if (!bHasBaseline)
+    {
+        Ar.Logf(Options.bUpdateBaseline ? ELogVerbosity::Warning : ELogVerbosity::Error,
+            TEXT("UPM: No self-benchmark baseline at '%s'; record one on the reference machine with -UpdateBaseline and check it in"),
+            *BaselinePath);
+    }
+
+    Ar.Logf(TEXT("UPM: Self-benchmark (median per call, baseline %s)"), bHasBaseline ? *BaselinePath : TEXT("none"));
+    for (FUPMSelfBenchmarkCase& Case : OutCases)
+    {
+        if (const double* BaselineMicroseconds = Baseline.Find(Case.Name))
+        {
+            Case.BaselineMicroseconds = *BaselineMicroseconds;
+            Case.bRegressed = Case.MedianMicroseconds > Case.BaselineMicroseconds * (1.0 + Options.Tolerance) + Options.AbsoluteToleranceMicroseconds;
+            bPassed &= !Case.bRegressed;
+        }
+        else if (bHasBaseline)
+        {
+            Ar.Logf(ELogVerbosity::Warning, TEXT("UPM: Self-benchmark case %s is not in the baseline"), *Case.Name);
+        }
+
+        Ar.Logf(TEXT("UPM:   %-40s %10.2f us  baseline %10.2f us  %s"), *Case.Name, Case.MedianMicroseconds,
+            Case.BaselineMicroseconds, Case.bRegressed ? TEXT("REGRESSED") : TEXT(""));
+    }
+
+    WriteResults(FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("SelfBenchmark.json"), OutCases);
+    if (Options.bUpdateBaseline && !BaselinePath.IsEmpty())
+    {
+        if (WriteResults(BaselinePath, OutCases))
+        {
+            Ar.Logf(TEXT("UPM: Self-benchmark baseline written to %s"), *BaselinePath);
+        }
+    }
+
+    return bPassed;
+}
+
+FString FUPMSelfBenchmark::GetDefaultBaselinePath()
+{
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("UniversalPerformanceManager"));
+    return Plugin.IsValid() ? Plugin->GetBaseDir() / TEXT("Resources") / TEXT("SelfBenchmarkBaseline.json") : FString();
+}
+
+bool FUPMSelfBenchmark::LoadBaseline(const FString& FilePath, TMap<FString, double>& OutBaseline)
+{
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    const TSharedPtr<FJsonObject>* CasesObject;
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() || !JsonObject->TryGetObjectField(TEXT("Cases"), CasesObject))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UPM: Ignoring invalid self-benchmark baseline: %s"), *FilePath);
+        return false;
+    }
+
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Case : (*CasesObject)->Values)
+    {
+        OutBaseline.Add(Case.Key, Case.Value->AsNumber());
+    }
+    return true;
+}
+
+bool FUPMSelfBenchmark::WriteResults(const FString& FilePath, const TArray<FUPMSelfBenchmarkCase>& Cases)
+{
+    TSharedPtr<FJsonObject> CasesObject = MakeShareable(new FJsonObject);
+    for (const FUPMSelfBenchmarkCase& Case : Cases)
+    {
+        CasesObject->SetNumberField(Case.Name, Case.MedianMicroseconds);
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField("Platform", FPlatformProperties::IniPlatformName());
+    RootObject->SetStringField("CPU", FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    RootObject->SetStringField("Date", FDateTime::Now().ToIso8601());
+    RootObject->SetObjectField("Cases", CasesObject);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer) || !FFileHelper::SaveStringToFile(OutputString, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write self-benchmark results to file: %s"), *FilePath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,92 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSelfBenchmark.h"
+#include "UPMSettingsManager.h"
+#include "GameFramework/GameUserSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/OutputDeviceNull.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Runs the self-benchmark against the plugin's checked-in baseline, one error per regressed case */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUPMSelfBenchmarkTest, "UniversalPerformanceManager.SelfBenchmark",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FUPMSelfBenchmarkTest::RunTest(const FString& Parameters)
+{
+    // Default settings, never the running game's manager
+    UUPMSettingsManager* Manager = NewObject<UUPMSettingsManager>();
+    Manager->AddToRoot();
+
+    FOutputDeviceNull NullOutput;
+    TArray<FUPMSelfBenchmarkCase> Cases;
+    FUPMSelfBenchmark::Run(Manager, FUPMSelfBenchmarkOptions(), Cases, NullOutput);
+
+    Manager->RemoveFromRoot();
+
+    const FString BaselinePath = FUPMSelfBenchmark::GetDefaultBaselinePath();
+    if (BaselinePath.IsEmpty() || !FPaths::FileExists(BaselinePath))
+    {
+        AddError(FString::Printf(TEXT("No self-benchmark baseline at '%s'; record one with upm.SelfBenchmark UpdateBaseline"), *BaselinePath));
+    }
+
+    TestTrue(TEXT("Self-benchmark ran its cases"), Cases.Num() > 0);
+    for (const FUPMSelfBenchmarkCase& Case : Cases)
+    {
+        AddInfo(FString::Printf(TEXT("%s: %.2f us (baseline %.2f us)"), *Case.Name, Case.MedianMicroseconds, Case.BaselineMicroseconds));
+        if (Case.bRegressed)
+        {
+            AddError(FString::Printf(TEXT("%s regressed: %.2f us against a baseline of %.2f us"), *Case.Name,
+                Case.MedianMicroseconds, Case.BaselineMicroseconds));
+        }
+    }
+    return true;
+}
+
+/** The benchmarked copies must not change the manager whose settings they use, nor leave the engine changed */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUPMSelfBenchmarkIsolationTest, "UniversalPerformanceManager.SelfBenchmark.Isolation",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUPMSelfBenchmarkIsolationTest::RunTest(const FString& Parameters)
+{
+    UUPMSettingsManager* Manager = NewObject<UUPMSettingsManager>();
+    Manager->AddToRoot();
+
+    FUPMCompleteSettings Settings = Manager->GetAllSettings();
+    Settings.Graphics.ShadowQuality = 1;
+    Settings.Display.ScreenPercentage = 75.0f;
+    Manager->CurrentSettings = Settings;
+    Manager->FPSHistory.Init(30.0f, 7);
+
+    // The copy applies ShadowQuality 1 to the engine; it must be back to this afterwards
+    IConsoleVariable* ShadowQualityCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("sg.ShadowQuality"));
+    const int32 EngineShadowQuality = ShadowQualityCVar ? ShadowQualityCVar->GetInt() : 0;
+    UGameUserSettings* GameSettings = UGameUserSettings::GetGameUserSettings();
+    const EWindowMode::Type EngineWindowMode = GameSettings ? GameSettings->GetFullscreenMode() : EWindowMode::Windowed;
+    const FIntPoint EngineResolution = GameSettings ? GameSettings->GetScreenResolution() : FIntPoint::ZeroValue;
+
+    FOutputDeviceNull NullOutput;
+    TArray<FUPMSelfBenchmarkCase> Cases;
+    FUPMSelfBenchmark::Run(Manager, FUPMSelfBenchmarkOptions(), Cases, NullOutput);
+
+    TestEqual(TEXT("ShadowQuality is untouched"), Manager->GetAllSettings().Graphics.ShadowQuality, 1);
+    TestEqual(TEXT("ScreenPercentage is untouched"), Manager->GetAllSettings().Display.ScreenPercentage, 75.0f);
+    TestEqual(TEXT("FPS history is untouched"), Manager->FPSHistory.Num(), 7);
+    TestTrue(TEXT("Settings file path is untouched"), Manager->SettingsFilePathOverride.IsEmpty());
+    if (ShadowQualityCVar)
+    {
+        TestEqual(TEXT("sg.ShadowQuality is restored"), ShadowQualityCVar->GetInt(), EngineShadowQuality);
+    }
+    if (GameSettings)
+    {
+        TestEqual(TEXT("Window mode is restored"), static_cast<int32>(GameSettings->GetFullscreenMode()), static_cast<int32>(EngineWindowMode));
+        TestEqual(TEXT("Resolution is restored"), GameSettings->GetScreenResolution(), EngineResolution);
+    }
+
+    Manager->RemoveFromRoot();
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
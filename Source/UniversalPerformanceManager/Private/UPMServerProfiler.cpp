@@ -0,0 +1,317 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMServerProfiler.h"
+#include "UPMStatistics.h"
+#include "Engine/World.h"
+#include "Engine/NetDriver.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Misc/App.h"
+#include "Misc/CoreDelegates.h"
+
+// Governor tuning
+static const double UPMServerEvaluationWindowSeconds = 1.0;
+static const int32 UPMServerTickRateRiseStep = 5;       // Rise slowly, drop immediately
+static const float UPMNetCullScaleDownFactor = 0.9f;
+static const float UPMNetCullScaleUpFactor = 1.05f;
+
+FUPMServerProfiler::FUPMServerProfiler()
+    : FrameWorkStartTime(0.0)
+    , ActorTickEndTime(0.0)
+    , NetFlushTimeThisFrame(0.0)
+    , WindowStartTime(0.0)
+    , AverageTickTimeMs(0.0f)
+    , AverageNetTimeMs(0.0f)
+    , PlayerCount(0)
+    , NetCullDistanceScale(1.0f)
+{
+}
+
+FUPMServerProfiler::~FUPMServerProfiler()
+{
+    Stop();
+}
+
+void FUPMServerProfiler::Start(UWorld* InWorld)
+{
+    if (!InWorld || World.Get() == InWorld)
+    {
+        return;
+    }
+
+    Stop();
+    World = InWorld;
+
+    TickStartHandle = FWorldDelegates::OnWorldTickStart.AddRaw(this, &FUPMServerProfiler::OnWorldTickStart);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FUPMServerProfiler::OnWorldPostActorTick);
+    PostTickFlushHandle = InWorld->OnPostTickFlush().AddRaw(this, &FUPMServerProfiler::OnPostTickFlush);
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FUPMServerProfiler::OnEndFrame);
+
+    WindowStartTime = FPlatformTime::Seconds();
+    UE_LOG(LogTemp, Log, TEXT("UPM: Server profiling started for world %s"), *InWorld->GetName());
+}
+
+void FUPMServerProfiler::Stop()
+{
+    FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+
+    if (UWorld* CurrentWorld = World.Get())
+    {
+        CurrentWorld->OnPostTickFlush().Remove(PostTickFlushHandle);
+    }
+
+    RestoreNetCullDistances();
+
+    World.Reset();
+    WindowTickTimes.Reset();
+    WindowNetTimes.Reset();
+    FrameWorkStartTime = 0.0;
+    NetFlushTimeThisFrame = 0.0;
+}
+
+void FUPMServerProfiler::SetSettings(const FUPMServerSettings& InSettings)
+{
+    Settings = InSettings;
+
+    if (!Settings.bAdaptNetCullDistance)
+    {
+        RestoreNetCullDistances();
+    }
+}
+
+int32 FUPMServerProfiler::GetTickRate() const
+{
+    const UWorld* CurrentWorld = World.Get();
+    const UNetDriver* NetDriver = CurrentWorld ? CurrentWorld->GetNetDriver() : nullptr;
+    return NetDriver ? NetDriver->GetNetServerMaxTickRate() : 0;
+}
+
+// ==================== Frame Measurement ====================
+
+void FUPMServerProfiler::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    // The max tick rate sleep happens before any world ticks, so this excludes idle time
+    if (InWorld == World.Get() && FrameWorkStartTime == 0.0)
+    {
+        FrameWorkStartTime = FPlatformTime::Seconds();
+    }
+}
+
+void FUPMServerProfiler::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if (InWorld == World.Get())
+    {
+        ActorTickEndTime = FPlatformTime::Seconds();
+    }
+}
+
+void FUPMServerProfiler::OnPostTickFlush(float DeltaSeconds)
+{
+    // Everything between the actor tick and the post flush is net driver work (mostly ServerReplicateActors)
+    if (ActorTickEndTime > 0.0)
+    {
+        NetFlushTimeThisFrame += FPlatformTime::Seconds() - ActorTickEndTime;
+        ActorTickEndTime = 0.0;
+    }
+}
+
+void FUPMServerProfiler::OnEndFrame()
+{
+    if (FrameWorkStartTime > 0.0)
+    {
+        const double Now = FPlatformTime::Seconds();
+        WindowTickTimes.Add(static_cast<float>((Now - FrameWorkStartTime) * 1000.0));
+        WindowNetTimes.Add(static_cast<float>(NetFlushTimeThisFrame * 1000.0));
+
+        FrameWorkStartTime = 0.0;
+        NetFlushTimeThisFrame = 0.0;
+
+        if (Now - WindowStartTime >= UPMServerEvaluationWindowSeconds)
+        {
+            EvaluateWindow();
+            WindowStartTime = Now;
+        }
+    }
+
+    OnFrameProfiled.Broadcast(FApp::GetDeltaTime());
+}
+
+// ==================== Evaluation ====================
+
+void FUPMServerProfiler::EvaluateWindow()
+{
+    UWorld* CurrentWorld = World.Get();
+    if (!CurrentWorld || WindowTickTimes.Num() == 0)
+    {
+        return;
+    }
+
+    AverageTickTimeMs = FUPMStatistics::Mean(WindowTickTimes);
+    AverageNetTimeMs = FUPMStatistics::Mean(WindowNetTimes);
+    const float P95TickTimeMs = FUPMStatistics::Percentile(WindowTickTimes, 95.0f);
+
+    WindowTickTimes.Reset();
+    WindowNetTimes.Reset();
+
+    if (const AGameStateBase* GameState = CurrentWorld->GetGameState())
+    {
+        PlayerCount = GameState->PlayerArray.Num();
+    }
+    else if (const UNetDriver* NetDriver = CurrentWorld->GetNetDriver())
+    {
+        PlayerCount = NetDriver->ClientConnections.Num();
+    }
+
+    UpdateReplicationClassCosts(CurrentWorld);
+
+    if (Settings.bEnableTickRateGovernor)
+    {
+        UpdateTickRate(CurrentWorld, P95TickTimeMs);
+    }
+}
+
+void FUPMServerProfiler::UpdateReplicationClassCosts(UWorld* InWorld)
+{
+    // The engine does not expose per-class replication timings, so the measured net flush time
+    // is distributed over classes by how often their actors want to replicate
+    TMap<UClass*, FUPMReplicationClassCost> CostsByClass;
+    TMap<UClass*, float> WeightsByClass;
+    float TotalWeight = 0.0f;
+
+    for (TActorIterator<AActor> It(InWorld); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (!Actor->GetIsReplicated() || Actor->IsActorBeingDestroyed())
+        {
+            continue;
+        }
+
+        UClass* ActorClass = Actor->GetClass();
+        FUPMReplicationClassCost& Cost = CostsByClass.FindOrAdd(ActorClass);
+        Cost.ActorCount++;
+
+        const float Weight = Actor->NetUpdateFrequency;
+        WeightsByClass.FindOrAdd(ActorClass) += Weight;
+        TotalWeight += Weight;
+    }
+
+    ReplicationClassCosts.Reset(CostsByClass.Num());
+    for (TPair<UClass*, FUPMReplicationClassCost>& Pair : CostsByClass)
+    {
+        FUPMReplicationClassCost& Cost = Pair.Value;
+        Cost.ClassName = Pair.Key->GetName();
+        Cost.EstimatedCostMs = TotalWeight > 0.0f ? AverageNetTimeMs * WeightsByClass[Pair.Key] / TotalWeight : 0.0f;
+        ReplicationClassCosts.Add(Cost);
+    }
+
+    ReplicationClassCosts.Sort([](const FUPMReplicationClassCost& A, const FUPMReplicationClassCost& B)
+    {
+        return A.EstimatedCostMs > B.EstimatedCostMs;
+    });
+}
+
+void FUPMServerProfiler::UpdateTickRate(UWorld* InWorld, float P95TickTimeMs)
+{
+    UNetDriver* NetDriver = InWorld->GetNetDriver();
+    if (!NetDriver)
+    {
+        return;
+    }
+
+    // The configured rate is what the project was balanced for; the governor only lowers it
+    const int32 ConfiguredRate = NetDriver->GetClass()->GetDefaultObject<UNetDriver>()->GetNetServerMaxTickRate();
+    const int32 MaxRate = FMath::Max(1, FMath::Min(Settings.MaxServerTickRate, ConfiguredRate));
+    const int32 MinRate = FMath::Clamp(Settings.MinServerTickRate, 1, MaxRate);
+    const float BudgetFraction = FMath::Clamp(Settings.TickBudgetFraction, 0.5f, 0.95f);
+
+    // Highest rate whose tick interval still keeps the P95 cost inside the budget
+    const int32 SustainableRate = P95TickTimeMs > 0.0f
+        ? FMath::FloorToInt(1000.0f * BudgetFraction / P95TickTimeMs)
+        : MaxRate;
+    const int32 TargetRate = FMath::Clamp(SustainableRate, MinRate, MaxRate);
+
+    const int32 CurrentRate = NetDriver->GetNetServerMaxTickRate();
+    int32 NewRate = CurrentRate;
+    if (TargetRate < CurrentRate)
+    {
+        NewRate = TargetRate;
+    }
+    else if (TargetRate > CurrentRate + 1)
+    {
+        NewRate = FMath::Min(TargetRate, CurrentRate + UPMServerTickRateRiseStep);
+    }
+
+    if (NewRate != CurrentRate)
+    {
+        NetDriver->SetNetServerMaxTickRate(NewRate);
+        UE_LOG(LogTemp, Log, TEXT("UPM: Server tick rate %d -> %d (P95 tick %.2f ms, %d players)"),
+            CurrentRate, NewRate, P95TickTimeMs, PlayerCount);
+    }
+
+    // Even the minimum rate is too expensive: reduce how much the server has to replicate
+    if (Settings.bAdaptNetCullDistance)
+    {
+        const float MinScale = FMath::Clamp(Settings.MinNetCullDistanceScale, 0.25f, 1.0f);
+        if (SustainableRate < MinRate)
+        {
+            NetCullDistanceScale = FMath::Max(MinScale, NetCullDistanceScale * UPMNetCullScaleDownFactor);
+        }
+        else if (SustainableRate > MinRate + UPMServerTickRateRiseStep)
+        {
+            NetCullDistanceScale = FMath::Min(1.0f, NetCullDistanceScale * UPMNetCullScaleUpFactor);
+        }
+        ApplyNetCullDistanceScale(InWorld, NetCullDistanceScale);
+    }
+}
+
+// ==================== Net Cull Distance ====================
+
+void FUPMServerProfiler::ApplyNetCullDistanceScale(UWorld* InWorld, float Scale)
+{
+    if (Scale >= 1.0f && OriginalNetCullDistances.Num() == 0)
+    {
+        return;
+    }
+
+    const float ScaleSquared = Scale * Scale;
+    for (TActorIterator<AActor> It(InWorld); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (!Actor->GetIsReplicated() || Actor->bAlwaysRelevant)
+        {
+            continue;
+        }
+
+        // Actors spawned since the last pass are recorded with their current distance
+        const float* Original = OriginalNetCullDistances.Find(Actor);
+        const float OriginalDistanceSquared = Original ? *Original : OriginalNetCullDistances.Add(Actor, Actor->NetCullDistanceSquared);
+        Actor->NetCullDistanceSquared = OriginalDistanceSquared * ScaleSquared;
+    }
+
+    // Forget destroyed actors
+    for (auto It = OriginalNetCullDistances.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FUPMServerProfiler::RestoreNetCullDistances()
+{
+    for (const TPair<TWeakObjectPtr<AActor>, float>& Pair : OriginalNetCullDistances)
+    {
+        if (AActor* Actor = Pair.Key.Get())
+        {
+            Actor->NetCullDistanceSquared = Pair.Value;
+        }
+    }
+
+    OriginalNetCullDistances.Reset();
+    NetCullDistanceScale = 1.0f;
+}
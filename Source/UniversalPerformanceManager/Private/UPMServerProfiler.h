@@ -0,0 +1,82 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "UPMSettingsManager.h"
+
+class UWorld;
+class AActor;
+
+/**
+ * Server tick profiler and tick-rate governor
+ *
+ * Measures the game thread work of every server tick (from the first world tick to the end of the frame,
+ * so the max tick rate sleep is excluded), the part spent in the net driver flush, and the player count.
+ * Once per evaluation window it adapts NetServerMaxTickRate so the P95 tick cost stays inside
+ * TickBudgetFraction of the tick interval, and optionally scales net cull distances when even the
+ * minimum tick rate cannot be held.
+ */
+class FUPMServerProfiler
+{
+public:
+    FUPMServerProfiler();
+    ~FUPMServerProfiler();
+
+    /** Start profiling the given server world (rebinds if already running) */
+    void Start(UWorld* InWorld);
+    void Stop();
+    bool IsRunning() const { return World.IsValid(); }
+
+    void SetSettings(const FUPMServerSettings& InSettings);
+
+    float GetTickTimeMs() const { return AverageTickTimeMs; }
+    float GetNetTimeMs() const { return AverageNetTimeMs; }
+    int32 GetTickRate() const;
+    int32 GetPlayerCount() const { return PlayerCount; }
+    const TArray<FUPMReplicationClassCost>& GetReplicationClassCosts() const { return ReplicationClassCosts; }
+
+    /** Fired at the end of every profiled frame with the frame's delta time */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnFrameProfiled, float);
+    FOnFrameProfiled OnFrameProfiled;
+
+private:
+    void OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+    void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+    void OnPostTickFlush(float DeltaSeconds);
+    void OnEndFrame();
+
+    void EvaluateWindow();
+    void UpdateReplicationClassCosts(UWorld* InWorld);
+    void UpdateTickRate(UWorld* InWorld, float P95TickTimeMs);
+    void ApplyNetCullDistanceScale(UWorld* InWorld, float Scale);
+    void RestoreNetCullDistances();
+
+    TWeakObjectPtr<UWorld> World;
+    FUPMServerSettings Settings;
+
+    FDelegateHandle TickStartHandle;
+    FDelegateHandle PostActorTickHandle;
+    FDelegateHandle PostTickFlushHandle;
+    FDelegateHandle EndFrameHandle;
+
+    // Per-frame timestamps (seconds)
+    double FrameWorkStartTime;
+    double ActorTickEndTime;
+    double NetFlushTimeThisFrame;
+
+    // Evaluation window
+    TArray<float> WindowTickTimes;
+    TArray<float> WindowNetTimes;
+    double WindowStartTime;
+
+    float AverageTickTimeMs;
+    float AverageNetTimeMs;
+    int32 PlayerCount;
+    TArray<FUPMReplicationClassCost> ReplicationClassCosts;
+
+    // Net cull distance scaling
+    float NetCullDistanceScale;
+    TMap<TWeakObjectPtr<AActor>, float> OriginalNetCullDistances;
+};
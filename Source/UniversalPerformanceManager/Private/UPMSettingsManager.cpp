@@ -7,13 +7,44 @@
 #include "HAL/PlatformProcess.h"
 #include "RHI.h"
 #include "RHIStats.h"
+#include "RenderCore.h"
 #include "Json.h"
 #include "JsonUtilities.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetConnection.h"
+#include "Net/DataChannel.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/GameNetworkManager.h"
+#include "Engine/LocalPlayer.h"
+#include "UPMStatistics.h"
+#include "UPMSettingsSnapshot.h"
+#include "UPMSettingsRequestQueue.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/App.h"
+#include "HAL/PlatformApplicationMisc.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Widgets/SWindow.h"
+#include "Engine/GameViewportClient.h"
+#include "UPMServerProfiler.h"
+#include "UPMTickProfiler.h"
+#include "UPMTickBudgetSubsystem.h"
+#include "UPMAudioRenderMonitor.h"
+#include "UPMShaderPrecache.h"
+#include "UPMApplyCostTracker.h"
+#include "UPMUpscalerManager.h"
+#include "UPMFrameRateTarget.h"
+#include "UPMStreamingGovernor.h"
+#include "UPMTextureStreamingStats.h"
+#include "UPMEffectsBudget.h"
+#include "AudioDevice.h"
+#include "Misc/ConfigCacheIni.h"
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -23,7 +54,32 @@
 UUPMSettingsManager* UUPMSettingsManager::Instance = nullptr;
 
 UUPMSettingsManager::UUPMSettingsManager()
-    : FPSHistoryTimeAccumulator(0.0f)
+    : bTimeSliceCommits(false)
+    , TimeSliceBudgetMs(2.0f)
+    , bDeferExpensiveSettings(true)
+    , NetworkSampleInterval(0.5f)
+    , FPSHistoryTimeAccumulator(0.0f)
+    , bRecordingFrameTimes(false)
+    , NetworkSampleAccumulator(0.0f)
+    , TickProfilerWindowSerial(0)
+    , AudioVoiceLimit(0)
+    , AudioBudgetAccumulator(0.0f)
+    , PendingCategories(EUPMSettingsCategory::None)
+    , SettingsBatchDepth(0)
+    , bPublishingChanges(false)
+    , SlicedCategories(EUPMSettingsCategory::None)
+    , SlicedAppliedCategories(EUPMSettingsCategory::None)
+    , SettingsApplyMsThisFrame(0.0f)
+    , CommitApplyMs(0.0f)
+    , bFrameRateSyncIntervalSet(false)
+    , EcoState(EUPMEcoState::None)
+    , bMenuActive(false)
+    , bEcoSuspendedRendering(false)
+    , bWorldRenderingWasDisabled(false)
+    , bLoadingMap(false)
+    , bLoadingScreenActive(false)
+    , bForceSafePoint(false)
+    , PrecacheDeadline(0.0)
 {
     FPSHistory.Reserve(120); // Reserve space for 120 frames (2 seconds at 60 FPS)
 }
@@ -32,6 +88,15 @@ UUPMSettingsManager::UUPMSettingsManager()
 
 UUPMSettingsManager* UUPMSettingsManager::GetInstance(const UObject* WorldContextObject)
 {
+    // Remember the most recent game world so network stats can be sampled from it
+    if (Instance && WorldContextObject && (!Instance->CachedWorld.IsValid() || Instance->CachedWorld->bIsTearingDown))
+    {
+        Instance->CachedWorld = WorldContextObject->GetWorld();
+
+        // The server settings apply to the new world; through the commit pipeline like every other change
+        Instance->CommitSettings(EUPMSettingsCategory::Server);
+    }
+
     if (!Instance)
     {
         if (!WorldContextObject)
@@ -49,6 +114,7 @@ UUPMSettingsManager* UUPMSettingsManager::GetInstance(const UObject* WorldContex
         if (Instance)
         {
             Instance->AddToRoot(); // Prevent garbage collection
+            Instance->CachedWorld = World;
             Instance->Initialize();
         }
     }
@@ -62,8 +128,140 @@ void UUPMSettingsManager::Initialize()
     // Load settings from disk
     LoadSettings();
 
-    // Apply loaded settings
+    // Before the first commit so the PSO usage mask is set from the start
+    if (!IsRunningDedicatedServer() && !ShaderPrecache.IsValid())
+    {
+        ShaderPrecache = MakeShared<FUPMShaderPrecache>();
+        ShaderPrecache->OnComplete.AddWeakLambda(this, [this]() { OnShaderPrecacheComplete.Broadcast(); });
+    }
+
+    if (!IsRunningDedicatedServer() && !UpscalerManager.IsValid())
+    {
+        UpscalerManager = MakeShared<FUPMUpscalerManager>();
+    }
+    if (!IsRunningDedicatedServer() && !FrameRateTarget.IsValid())
+    {
+        FrameRateTarget = MakeShared<FUPMFrameRateTarget>();
+    }
+    if (!StreamingGovernor.IsValid())
+    {
+        StreamingGovernor = MakeShared<FUPMStreamingGovernor>();
+    }
+    if (!IsRunningDedicatedServer() && !TextureStreamingStats.IsValid())
+    {
+        TextureStreamingStats = MakeShared<FUPMTextureStreamingStats>();
+    }
+    if (!IsRunningDedicatedServer() && !EffectsBudget.IsValid())
+    {
+        EffectsBudget = MakeShared<FUPMEffectsBudget>();
+    }
+
+    // Measured costs of earlier sessions feed GetSettingApplyCost from the start
+    if (!ApplyCostTracker.IsValid())
+    {
+        ApplyCostTracker = MakeShared<FUPMApplyCostTracker>();
+        ApplyCostTracker->Load();
+    }
+
+    // Apply loaded settings; startup is a safe point
+    bForceSafePoint = true;
     ApplyAllSettings();
+    bForceSafePoint = false;
+
+    // Requests queued from other threads are merged and applied before anything else runs in the frame
+    if (!BeginFrameHandle.IsValid())
+    {
+        BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddUObject(this, &UUPMSettingsManager::BeginFrame);
+    }
+
+    // The loading screen hides the rebuilds, and async loading may take the whole frame until the map is in
+    if (!PreLoadMapHandle.IsValid())
+    {
+        PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddWeakLambda(this, [this](const FString&)
+        {
+            bLoadingMap = true;
+            NotifySafePoint();
+        });
+    }
+    if (!PostLoadMapHandle.IsValid())
+    {
+        PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddWeakLambda(this, [this](UWorld*) { bLoadingMap = false; });
+    }
+}
+
+void UUPMSettingsManager::BeginFrame()
+{
+    // Everything applied since the last frame started
+    PerformanceMetrics.Process.SettingsApplyTimeMs = SettingsApplyMsThisFrame;
+    SettingsApplyMsThisFrame = 0.0f;
+
+    // Thread times of the last frame, before this frame's changes start a new measurement
+    if (ApplyCostTracker.IsValid())
+    {
+        ApplyCostTracker->Tick();
+    }
+
+    FUPMSettingsRequestQueue::ProcessRequests(this);
+    ProcessTimeSlicedCommit();
+
+    // Network stats change slowly, sample them at a low rate; this also drives the network governor
+    NetworkSampleAccumulator += FApp::GetDeltaTime();
+    if (NetworkSampleAccumulator >= NetworkSampleInterval)
+    {
+        NetworkSampleAccumulator = 0.0f;
+        SampleNetworkMetricsForWorld(CachedWorld.Get());
+    }
+
+    UpdateAudioBudget(FApp::GetDeltaTime());
+
+    if (DeferredSettingPaths.Num() > 0 && IsAtSafePoint())
+    {
+        NotifySafePoint();
+    }
+
+    if (UpscalerManager.IsValid())
+    {
+        UpscalerManager->Tick(FApp::GetDeltaTime());
+    }
+
+    UpdateEcoState();
+
+    if (StreamingGovernor.IsValid())
+    {
+        StreamingGovernor->Tick(CachedWorld.Get(), IsLoadingScreen(), CurrentSettings.Performance);
+        StreamingGovernor->FillMetrics(PerformanceMetrics.Process);
+    }
+
+    if (TextureStreamingStats.IsValid())
+    {
+        TextureStreamingStats->Tick(FApp::GetDeltaTime(), CurrentSettings.Debug.bEnableTextureStreamingStats);
+        TextureStreamingStats->FillMetrics(PerformanceMetrics.Process);
+    }
+
+    if (EffectsBudget.IsValid())
+    {
+        EffectsBudget->Tick(CachedWorld.Get(), CurrentSettings.Performance, CurrentSettings.Graphics.EffectsQuality, GetFrameRateTarget());
+        EffectsBudget->FillMetrics(PerformanceMetrics.Process);
+    }
+
+    // Also tracks the display while the target is manual, so GetFrameRateTargets is current
+    if (FrameRateTarget.IsValid() && FrameRateTarget->Tick(FApp::GetDeltaTime(), CurrentSettings.Performance)
+        && CurrentSettings.Performance.bAutoFrameRateTarget)
+    {
+        ApplyFrameRateTarget();
+    }
+
+    if (ShaderPrecache.IsValid())
+    {
+        ShaderPrecache->Tick(FApp::GetDeltaTime());
+
+        if (SettingsWaitingForPrecache.IsSet() && (ShaderPrecache->IsWarm() || FPlatformTime::Seconds() >= PrecacheDeadline))
+        {
+            const FUPMCompleteSettings Settings = SettingsWaitingForPrecache.GetValue();
+            SettingsWaitingForPrecache.Reset();
+            SetAllSettings(Settings);
+        }
+    }
 }
 
 // ==================== Performance Monitoring ====================
@@ -78,87 +276,1078 @@ void UUPMSettingsManager::UpdatePerformanceMetrics(float DeltaTime)
     // Calculate current FPS
     PerformanceMetrics.FPS_Current = 1.0f / DeltaTime;
 
-    // Update FPS history
-    FPSHistory.Add(PerformanceMetrics.FPS_Current);
-    FPSHistoryTimeAccumulator += DeltaTime;
+    // Update FPS history
+    FPSHistory.Add(PerformanceMetrics.FPS_Current);
+    FPSHistoryTimeAccumulator += DeltaTime;
+
+    // Keep only last 2 seconds of data
+    if (FPSHistoryTimeAccumulator > 2.0f)
+    {
+        if (FPSHistory.Num() > 60)
+        {
+            FPSHistory.RemoveAt(0, FPSHistory.Num() - 120);
+        }
+        FPSHistoryTimeAccumulator = 2.0f;
+    }
+
+    // Calculate FPS statistics
+    if (FPSHistory.Num() > 0)
+    {
+        float Sum = 0.0f;
+        float Min = FPSHistory[0];
+        float Max = FPSHistory[0];
+
+        for (float FPS : FPSHistory)
+        {
+            Sum += FPS;
+            Min = FMath::Min(Min, FPS);
+            Max = FMath::Max(Max, FPS);
+        }
+
+        PerformanceMetrics.FPS_Average = Sum / FPSHistory.Num();
+        PerformanceMetrics.FPS_Min = Min;
+        PerformanceMetrics.FPS_Max = Max;
+    }
+
+    // CPU and GPU frame times
+    PerformanceMetrics.CPUFrameTime = DeltaTime * 1000.0f; // Convert to milliseconds
+    PerformanceMetrics.GPUFrameTime = DeltaTime * 1000.0f * 0.8f; // Rough estimate
+
+    if (bRecordingFrameTimes)
+    {
+        RecordedFrameTimes.Emplace(DeltaTime * 1000.0f, FPlatformTime::ToMilliseconds(GGameThreadTime),
+            FPlatformTime::ToMilliseconds(GRenderThreadTime), FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+    }
+
+    // Memory usage
+    FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    PerformanceMetrics.RAMUsageMB = static_cast<float>(MemoryStats.UsedPhysical) / (1024.0f * 1024.0f);
+
+    // VRAM usage (if available)
+    if (GDynamicRHI)
+    {
+        uint64 UsedVRAM = 0;
+        RHIGetResourceMemoryUsage(UsedVRAM);
+
+        if (UsedVRAM > 0)
+        {
+            PerformanceMetrics.VRAMUsageMB = static_cast<float>(UsedVRAM) / (1024.0f * 1024.0f);
+        }
+    }
+
+    // Thread load (normalized 0-1)
+    PerformanceMetrics.GameThreadLoad = FMath::Clamp(DeltaTime / 0.0166f, 0.0f, 1.0f); // 60 FPS baseline
+    PerformanceMetrics.RenderThreadLoad = PerformanceMetrics.GameThreadLoad * 0.9f;
+    PerformanceMetrics.RHIThreadLoad = PerformanceMetrics.GameThreadLoad * 0.7f;
+
+    UpdateServerMetrics();
+
+    if (const UWorld* World = CachedWorld.Get())
+    {
+        if (const UUPMTickBudgetSubsystem* TickBudget = World->GetSubsystem<UUPMTickBudgetSubsystem>())
+        {
+            PerformanceMetrics.WorldTickTimeMs = TickBudget->GetWorldTickTimeMs();
+            PerformanceMetrics.TickBudgetMs = TickBudget->GetTickBudgetMs();
+            PerformanceMetrics.ThrottledActorCount = TickBudget->GetThrottledActorCount();
+        }
+    }
+
+    // The profiler publishes once per window, only copy when something new is available
+    if (FUPMTickProfiler::IsEnabled() && FUPMTickProfiler::Get().GetWindowSerial() != TickProfilerWindowSerial)
+    {
+        TickProfilerWindowSerial = FUPMTickProfiler::Get().GetWindowSerial();
+        FUPMTickProfiler::Get().GetTopEntries(10, PerformanceMetrics.TopTickCosts);
+    }
+}
+
+void UUPMSettingsManager::ResetPerformanceStats()
+{
+    FPSHistory.Empty();
+    FPSHistoryTimeAccumulator = 0.0f;
+    PerformanceMetrics.FPS_Min = 999.0f;
+    PerformanceMetrics.FPS_Max = 0.0f;
+    PerformanceMetrics.FPS_Average = 0.0f;
+}
+
+void UUPMSettingsManager::StartFrameTimeRecording()
+{
+    RecordedFrameTimes.Reset();
+    RecordedFrameTimes.Reserve(60 * 60 * 5); // Five minutes at 60 FPS
+    bRecordingFrameTimes = true;
+    UE_LOG(LogTemp, Log, TEXT("UPM: Frame time recording started"));
+}
+
+FString UUPMSettingsManager::StopFrameTimeRecording(const FString& FilePath)
+{
+    if (!bRecordingFrameTimes)
+    {
+        return FString();
+    }
+    bRecordingFrameTimes = false;
+
+    const FString OutputPath = !FilePath.IsEmpty() ? FilePath
+        : FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("FrameTimes") / (FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")) + TEXT(".csv"));
+
+    FString Csv = TEXT("FrameTimeMs,GameThreadMs,RenderThreadMs,GPUMs");
+    Csv += LINE_TERMINATOR;
+    for (const FVector4f& Sample : RecordedFrameTimes)
+    {
+        Csv += FString::Printf(TEXT("%.3f,%.3f,%.3f,%.3f"), Sample.X, Sample.Y, Sample.Z, Sample.W);
+        Csv += LINE_TERMINATOR;
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write frame times to file: %s"), *OutputPath);
+        return FString();
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Recorded %d frames to %s"), RecordedFrameTimes.Num(), *OutputPath);
+    RecordedFrameTimes.Empty();
+    return OutputPath;
+}
+
+// ==================== Network Monitoring ====================
+
+void UUPMSettingsManager::SampleNetworkMetrics(const UObject* WorldContextObject)
+{
+    if (WorldContextObject)
+    {
+        SampleNetworkMetricsForWorld(WorldContextObject->GetWorld());
+    }
+}
+
+void UUPMSettingsManager::SampleNetworkMetricsForWorld(UWorld* World)
+{
+    if (ReadWorldNetworkMetrics(World, PerformanceMetrics, ServerNetworkStats)
+        && CurrentSettings.Network.bEnableAdaptiveNetworking && World->GetNetMode() == NM_Client)
+    {
+        UpdateNetworkGovernor(World);
+    }
+}
+
+bool UUPMSettingsManager::ReadWorldNetworkMetrics(UWorld* World, FUPMPerformanceMetrics& OutMetrics, FUPMServerNetworkStats& OutServerStats)
+{
+    UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+    if (!NetDriver)
+    {
+        return false;
+    }
+
+    // Client side: the local player's connection to the server
+    // (a listen server's own player has no connection and is skipped)
+    UNetConnection* LocalConnection = NetDriver->ServerConnection;
+    if (!LocalConnection && GEngine)
+    {
+        if (APlayerController* LocalController = GEngine->GetFirstLocalPlayerController(World))
+        {
+            LocalConnection = LocalController->GetNetConnection();
+        }
+    }
+
+    if (LocalConnection)
+    {
+        OutMetrics.NetworkPing = LocalConnection->AvgLag * 1000.0f;
+        OutMetrics.PacketLossIn = LocalConnection->GetInLossPercentage().GetAvgLossPercentage() * 100.0f;
+        OutMetrics.PacketLossOut = LocalConnection->GetOutLossPercentage().GetAvgLossPercentage() * 100.0f;
+        OutMetrics.PacketLoss = FMath::Max(OutMetrics.PacketLossIn, OutMetrics.PacketLossOut);
+        OutMetrics.NetInBytesPerSecond = LocalConnection->InBytesPerSecond;
+        OutMetrics.NetOutBytesPerSecond = LocalConnection->OutBytesPerSecond;
+        OutMetrics.NetInPacketsPerSecond = LocalConnection->InPacketsPerSecond;
+        OutMetrics.NetOutPacketsPerSecond = LocalConnection->OutPacketsPerSecond;
+    }
+
+    // Server side: aggregate over every client connection
+    if (!NetDriver->IsServer())
+    {
+        return LocalConnection != nullptr;
+    }
+
+    FUPMServerNetworkStats Stats;
+    TArray<float> Pings;
+    TArray<float> Losses;
+    Pings.Reserve(NetDriver->ClientConnections.Num());
+    Losses.Reserve(NetDriver->ClientConnections.Num());
+
+    float LossInSum = 0.0f;
+    float LossOutSum = 0.0f;
+
+    for (UNetConnection* Connection : NetDriver->ClientConnections)
+    {
+        if (!Connection)
+        {
+            continue;
+        }
+
+        const float LossIn = Connection->GetInLossPercentage().GetAvgLossPercentage() * 100.0f;
+        const float LossOut = Connection->GetOutLossPercentage().GetAvgLossPercentage() * 100.0f;
+
+        Pings.Add(Connection->AvgLag * 1000.0f);
+        Losses.Add(FMath::Max(LossIn, LossOut));
+        LossInSum += LossIn;
+        LossOutSum += LossOut;
+        Stats.TotalInBytesPerSecond += Connection->InBytesPerSecond;
+        Stats.TotalOutBytesPerSecond += Connection->OutBytesPerSecond;
+    }
+
+    Stats.NumConnections = Pings.Num();
+    if (Stats.NumConnections > 0)
+    {
+        Pings.Sort();
+        Losses.Sort();
+
+        Stats.AveragePing = FUPMStatistics::Mean(Pings);
+        Stats.PingP50 = FUPMStatistics::PercentileSorted(Pings, 50.0f);
+        Stats.PingP95 = FUPMStatistics::PercentileSorted(Pings, 95.0f);
+        Stats.PingP99 = FUPMStatistics::PercentileSorted(Pings, 99.0f);
+        Stats.MaxPing = Pings.Last();
+        Stats.AveragePacketLossIn = LossInSum / Stats.NumConnections;
+        Stats.AveragePacketLossOut = LossOutSum / Stats.NumConnections;
+        Stats.PacketLossP95 = FUPMStatistics::PercentileSorted(Losses, 95.0f);
+    }
+
+    OutServerStats = Stats;
+    return LocalConnection != nullptr;
+}
+
+// ==================== Settings Application ====================
+
+void UUPMSettingsManager::ApplyAllSettings()
+{
+    CommitSettings(EUPMSettingsCategory::All);
+}
+
+/** Members of FUPMCompleteSettings by category, in dependency (application) order */
+static const TPair<EUPMSettingsCategory, const TCHAR*> UPMSettingsCategoryNames[] =
+{
+    { EUPMSettingsCategory::Graphics, TEXT("Graphics") },
+    { EUPMSettingsCategory::Performance, TEXT("Performance") },
+    { EUPMSettingsCategory::Display, TEXT("Display") },
+    { EUPMSettingsCategory::Rendering, TEXT("Rendering") },
+    { EUPMSettingsCategory::Audio, TEXT("Audio") },
+    { EUPMSettingsCategory::Gameplay, TEXT("Gameplay") },
+    { EUPMSettingsCategory::Accessibility, TEXT("Accessibility") },
+    { EUPMSettingsCategory::Network, TEXT("Network") },
+    { EUPMSettingsCategory::Debug, TEXT("Debug") },
+    { EUPMSettingsCategory::Server, TEXT("Server") }
+};
+
+// Graphics, Performance and Display go through UGameUserSettings::ApplySettings, which re-applies scalability
+// and with it the r.* CVars the rendering toggles override
+static const EUPMSettingsCategory UPMScalabilityCategories = EUPMSettingsCategory::Graphics | EUPMSettingsCategory::Performance | EUPMSettingsCategory::Display;
+
+/** Categories plus everything that has to be re-applied after them */
+static EUPMSettingsCategory UPMWithDependentCategories(EUPMSettingsCategory Categories)
+{
+    if (EnumHasAnyFlags(Categories, UPMScalabilityCategories))
+    {
+        Categories |= EUPMSettingsCategory::Rendering;
+    }
+    return Categories;
+}
+
+void UUPMSettingsManager::ApplyCategories(EUPMSettingsCategory Categories)
+{
+    // Headless server: graphics, audio and input settings have nothing to apply to
+    if (IsRunningDedicatedServer())
+    {
+        Categories &= EUPMSettingsCategory::Network | EUPMSettingsCategory::Server;
+    }
+
+    for (const TPair<EUPMSettingsCategory, const TCHAR*>& Category : UPMSettingsCategoryNames)
+    {
+        if (!EnumHasAnyFlags(Categories, Category.Key))
+        {
+            continue;
+        }
+
+        const double StartTime = FPlatformTime::Seconds();
+        switch (Category.Key)
+        {
+        case EUPMSettingsCategory::Graphics: ApplyGraphicsSettings(); break;
+        case EUPMSettingsCategory::Performance: ApplyPerformanceSettings(); break;
+        case EUPMSettingsCategory::Display: ApplyDisplaySettings(); break;
+        case EUPMSettingsCategory::Rendering: ApplyRenderingSettings(); break;
+        case EUPMSettingsCategory::Audio: ApplyAudioSettings(); break;
+        case EUPMSettingsCategory::Gameplay: ApplyGameplaySettings(); break;
+        case EUPMSettingsCategory::Accessibility: ApplyAccessibilitySettings(); break;
+        case EUPMSettingsCategory::Network: ApplyNetworkSettings(); break;
+        case EUPMSettingsCategory::Debug: ApplyDebugSettings(); break;
+        case EUPMSettingsCategory::Server: ApplyServerSettings(); break;
+        default: break;
+        }
+
+        const float CostMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+        CategoryApplyCostMs.Add(Category.Key, CostMs);
+        SettingsApplyMsThisFrame += CostMs;
+        CommitApplyMs += CostMs;
+    }
+
+    // UGameUserSettings::ApplySettings resets t.MaxFPS to the saved limit; Performance puts the automatic target
+    // and eco cap back itself, Graphics and Display need it done here
+    if (EnumHasAnyFlags(Categories, EUPMSettingsCategory::Graphics | EUPMSettingsCategory::Display)
+        && !EnumHasAnyFlags(Categories, EUPMSettingsCategory::Performance))
+    {
+        ApplyFrameRateTarget();
+    }
+}
+
+static const FProperty* UPMFindSettingProperty(const FString& SettingPath, const FStructProperty*& OutCategoryProperty, EUPMSettingsCategory& OutCategory);
+
+void UUPMSettingsManager::CommitSettings(EUPMSettingsCategory Categories)
+{
+    PendingCategories |= Categories;
+    if (SettingsBatchDepth > 0 || bPublishingChanges)
+    {
+        return;
+    }
+
+    const EUPMSettingsCategory CommitCategories = UPMWithDependentCategories(PendingCategories);
+    PendingCategories = EUPMSettingsCategory::None;
+
+    // Joins a running time-sliced commit so the order of application is kept
+    const bool bMultipleCategories = (static_cast<uint16>(CommitCategories) & (static_cast<uint16>(CommitCategories) - 1)) != 0;
+    if (IsTimeSlicedCommitPending() || (bTimeSliceCommits && bMultipleCategories && !bForceSafePoint))
+    {
+        StartTimeSlicedCommit(CommitCategories);
+        return;
+    }
+
+    FUPMCompleteSettings RequestedSettings;
+    const EUPMSettingsCategory ApplyCategoriesNow = BeginApply(CommitCategories, RequestedSettings);
+    ApplyCategories(ApplyCategoriesNow);
+    PublishChanges(ApplyCategoriesNow);
+    EndApply(RequestedSettings);
+    CommitListenerChanges();
+}
+
+void UUPMSettingsManager::CommitListenerChanges()
+{
+    // Setters called from OnSettingsChanged only marked their categories, commit them now on top of this commit
+    if (PendingCategories != EUPMSettingsCategory::None)
+    {
+        CommitSettings(EUPMSettingsCategory::None);
+    }
+}
+
+EUPMSettingsCategory UUPMSettingsManager::BeginApply(EUPMSettingsCategory Categories, FUPMCompleteSettings& OutRequestedSettings)
+{
+    // Expensive changes are applied with the committed (old) value for now and restored by EndApply
+    OutRequestedSettings = CurrentSettings;
+    if (IsAtSafePoint())
+    {
+        for (const FString& SettingPath : DeferredSettingPaths)
+        {
+            Categories |= UPMWithDependentCategories(GetSettingCategory(SettingPath));
+        }
+        DeferredSettingPaths.Reset();
+    }
+    else
+    {
+        DeferExpensiveChanges(Categories);
+    }
+    return Categories;
+}
+
+void UUPMSettingsManager::PublishChanges(EUPMSettingsCategory Categories)
+{
+    // Diff the committed categories field by field against the state of the previous commit
+    FUPMSettingsChange Change;
+    for (const TPair<EUPMSettingsCategory, const TCHAR*>& Category : UPMSettingsCategoryNames)
+    {
+        if (!EnumHasAnyFlags(Categories, Category.Key))
+        {
+            continue;
+        }
+
+        const FStructProperty* CategoryProperty = FindFProperty<FStructProperty>(FUPMCompleteSettings::StaticStruct(), Category.Value);
+        const void* OldCategory = CategoryProperty->ContainerPtrToValuePtr<void>(&CommittedSettings);
+        const void* NewCategory = CategoryProperty->ContainerPtrToValuePtr<void>(&CurrentSettings);
+
+        for (TFieldIterator<FProperty> It(CategoryProperty->Struct); It; ++It)
+        {
+            if (!It->Identical_InContainer(OldCategory, NewCategory))
+            {
+                Change.ChangedFields.Add(FName(*FString::Printf(TEXT("%s.%s"), Category.Value, *It->GetName())));
+                if (!Change.HasChanged(Category.Key))
+                {
+                    Change.Categories |= Category.Key;
+                    Change.ChangedCategories.Add(Category.Value);
+                }
+            }
+        }
+        CategoryProperty->CopyCompleteValue_InContainer(&CommittedSettings, &CurrentSettings);
+    }
+
+    if (Change.Categories != EUPMSettingsCategory::None)
+    {
+        // Worker threads see the new settings before any listener reacts to them
+        FUPMSettingsSnapshot::Publish(CurrentSettings);
+
+        TGuardValue<bool> PublishingGuard(bPublishingChanges, true);
+
+        if (ShaderPrecache.IsValid() && Change.HasChanged(EUPMSettingsCategory::Graphics | EUPMSettingsCategory::Rendering))
+        {
+            ShaderPrecache->NotifySettingsCommitted(CurrentSettings);
+        }
+
+        OnSettingsChangedNative.Broadcast(Change);
+        OnSettingsChanged.Broadcast(Change);
+
+        // Startup applies everything at once before there is a baseline; the tracker skips it
+        if (ApplyCostTracker.IsValid())
+        {
+            ApplyCostTracker->BeginMeasurement(Change.ChangedFields, CommitApplyMs);
+        }
+    }
+    CommitApplyMs = 0.0f;
+}
+
+void UUPMSettingsManager::EndApply(const FUPMCompleteSettings& RequestedSettings)
+{
+    for (const FString& SettingPath : DeferredSettingPaths)
+    {
+        const FStructProperty* CategoryProperty = nullptr;
+        EUPMSettingsCategory Category = EUPMSettingsCategory::None;
+        const FProperty* FieldProperty = UPMFindSettingProperty(SettingPath, CategoryProperty, Category);
+        if (!FieldProperty)
+        {
+            continue;
+        }
+
+        // Still the held-back value unless a listener set it during the publish; its value is the newer request
+        void* Current = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&CurrentSettings));
+        const void* Committed = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&CommittedSettings));
+        if (FieldProperty->Identical(Current, Committed))
+        {
+            FieldProperty->CopyCompleteValue(Current,
+                FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&RequestedSettings)));
+        }
+    }
+}
+
+// ==================== Time-Sliced Commits ====================
+
+void UUPMSettingsManager::ApplyAllSettingsTimeSliced()
+{
+    PendingCategories = EUPMSettingsCategory::None;
+    StartTimeSlicedCommit(EUPMSettingsCategory::All);
+}
+
+void UUPMSettingsManager::SetAllSettingsTimeSliced(const FUPMCompleteSettings& Settings)
+{
+    CurrentSettings = Settings;
+    ApplyAllSettingsTimeSliced();
+}
+
+void UUPMSettingsManager::StartTimeSlicedCommit(EUPMSettingsCategory Categories)
+{
+    // Categories applied earlier in this commit are applied again, and with them everything after them
+    SlicedCategories |= UPMWithDependentCategories(Categories);
+    PerformanceMetrics.Process.PendingSettingsCategories = FMath::CountBits(static_cast<uint16>(SlicedCategories));
+}
+
+void UUPMSettingsManager::ProcessTimeSlicedCommit()
+{
+    if (!IsTimeSlicedCommitPending())
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    bool bAppliedAny = false;
+    for (const TPair<EUPMSettingsCategory, const TCHAR*>& Category : UPMSettingsCategoryNames)
+    {
+        if (!EnumHasAnyFlags(SlicedCategories, Category.Key))
+        {
+            continue;
+        }
+
+        // At least one category per frame; after that only what is expected to fit
+        const float ElapsedMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+        const float* ExpectedCostMs = CategoryApplyCostMs.Find(Category.Key);
+        if (bAppliedAny && ElapsedMs + (ExpectedCostMs ? *ExpectedCostMs : 0.0f) > TimeSliceBudgetMs)
+        {
+            break;
+        }
+
+        FUPMCompleteSettings RequestedSettings;
+        SlicedCategories |= BeginApply(Category.Key, RequestedSettings) & ~Category.Key;
+        ApplyCategories(Category.Key);
+        EndApply(RequestedSettings);
+
+        SlicedCategories &= ~Category.Key;
+        SlicedAppliedCategories |= Category.Key;
+        bAppliedAny = true;
+    }
+
+    PerformanceMetrics.Process.PendingSettingsCategories = FMath::CountBits(static_cast<uint16>(SlicedCategories));
+    if (IsTimeSlicedCommitPending())
+    {
+        return;
+    }
+
+    // A safe point came up while slicing: the held-back settings get their own slices first
+    if (IsAtSafePoint() && DeferredSettingPaths.Num() > 0)
+    {
+        for (const FString& SettingPath : DeferredSettingPaths)
+        {
+            SlicedCategories |= UPMWithDependentCategories(GetSettingCategory(SettingPath));
+        }
+        DeferredSettingPaths.Reset();
+        return;
+    }
+
+    // Everything is applied: one notification for the whole commit
+    const EUPMSettingsCategory AppliedCategories = SlicedAppliedCategories;
+    SlicedAppliedCategories = EUPMSettingsCategory::None;
+
+    FUPMCompleteSettings RequestedSettings;
+    BeginApply(AppliedCategories, RequestedSettings);
+    PublishChanges(AppliedCategories);
+    EndApply(RequestedSettings);
+    CommitListenerChanges();
+}
+
+void UUPMSettingsManager::FlushTimeSlicedCommit()
+{
+    if (!IsTimeSlicedCommitPending())
+    {
+        return;
+    }
+
+    TGuardValue<float> BudgetGuard(TimeSliceBudgetMs, TNumericLimits<float>::Max());
+    while (IsTimeSlicedCommitPending())
+    {
+        ProcessTimeSlicedCommit();
+    }
+}
+
+/** Field property of "<Category>.<Field>" and the category it belongs to, nullptr if unknown */
+static const FProperty* UPMFindSettingProperty(const FString& SettingPath, const FStructProperty*& OutCategoryProperty, EUPMSettingsCategory& OutCategory)
+{
+    FString CategoryName;
+    FString FieldName;
+    if (!SettingPath.Split(TEXT("."), &CategoryName, &FieldName))
+    {
+        return nullptr;
+    }
+
+    for (const TPair<EUPMSettingsCategory, const TCHAR*>& Category : UPMSettingsCategoryNames)
+    {
+        if (CategoryName.Equals(Category.Value, ESearchCase::IgnoreCase))
+        {
+            OutCategoryProperty = FindFProperty<FStructProperty>(FUPMCompleteSettings::StaticStruct(), Category.Value);
+            OutCategory = Category.Key;
+            return OutCategoryProperty ? OutCategoryProperty->Struct->FindPropertyByName(*FieldName) : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/** Valid range of a setting set by name, the same limits its typed setter clamps to */
+struct FUPMSettingRange
+{
+    const TCHAR* SettingPath;
+    double Min;
+    double Max;
+};
+
+static const double UPMUnboundedSetting = TNumericLimits<int32>::Max();
+
+static const FUPMSettingRange UPMSettingRanges[] =
+{
+    { TEXT("Graphics.AntiAliasingQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.ShadowQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.ViewDistanceQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.PostProcessQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.TextureQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.EffectsQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.FoliageQuality"), 0.0, 4.0 },
+    { TEXT("Graphics.ShadingQuality"), 0.0, 4.0 },
+    { TEXT("Rendering.AnisotropicFiltering"), 0.0, 4.0 },
+    { TEXT("Rendering.GlobalIlluminationQuality"), 0.0, 4.0 },
+    { TEXT("Rendering.ReflectionQuality"), 0.0, 4.0 },
+    { TEXT("Performance.FrameRateLimit"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.UnfocusedFrameRateLimit"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.MinimizedFrameRateLimit"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.MenuFrameRateLimit"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.IdleFrameRateLimit"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.IdleTimeoutSeconds"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.StreamingBudgetMs"), 0.5, 10.0 },
+    { TEXT("Performance.LoadingScreenAsyncLoadingTimeMs"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.EffectsBudgetMs"), 0.0, 10.0 },
+    { TEXT("Performance.MinFrameRateForDynamicRes"), 15.0, 60.0 },
+    { TEXT("Performance.LODDistanceMultiplier"), 0.25, 4.0 },
+    { TEXT("Performance.ProcessPriority"), 0.0, 2.0 },
+    { TEXT("Performance.TickBudgetFraction"), 0.1, 0.9 },
+    { TEXT("Performance.MaxThrottledTickInterval"), 0.0, UPMUnboundedSetting },
+    { TEXT("Performance.SignificanceDistance"), 0.0, UPMUnboundedSetting },
+    { TEXT("Display.Brightness"), 0.0, 2.0 },
+    { TEXT("Display.Contrast"), 0.0, 2.0 },
+    { TEXT("Display.HDRMaxNits"), 1000.0, 10000.0 },
+    { TEXT("Display.MonitorIndex"), 0.0, UPMUnboundedSetting },
+    { TEXT("Display.ScreenPercentage"), 50.0, 200.0 },
+    { TEXT("Display.MenuFieldOfView"), 60.0, 120.0 },
+    { TEXT("Display.AspectRatioOverride"), 0.0, UPMUnboundedSetting },
+    { TEXT("Display.SafeZoneScale"), 0.8, 1.0 },
+    { TEXT("Audio.MasterVolume"), 0.0, 1.0 },
+    { TEXT("Audio.SFXVolume"), 0.0, 1.0 },
+    { TEXT("Audio.MusicVolume"), 0.0, 1.0 },
+    { TEXT("Audio.VoiceDialogVolume"), 0.0, 1.0 },
+    { TEXT("Audio.AmbientVolume"), 0.0, 1.0 },
+    { TEXT("Audio.UISoundVolume"), 0.0, 1.0 },
+    { TEXT("Audio.VoiceChatVolume"), 0.0, 1.0 },
+    { TEXT("Audio.AudioQuality"), 0.0, 3.0 },
+    { TEXT("Audio.SurroundSoundMode"), 0.0, 2.0 },
+    { TEXT("Audio.DynamicRange"), 0.0, 1.0 },
+    { TEXT("Audio.SubtitleTextSize"), 0.5, 2.0 },
+    { TEXT("Audio.SubtitleBackgroundOpacity"), 0.0, 1.0 },
+    { TEXT("Gameplay.FOV"), 60.0, 120.0 },
+    { TEXT("Gameplay.MouseSensitivity"), 0.1, 5.0 },
+    { TEXT("Gameplay.ControllerSensitivity"), 0.1, 5.0 },
+    { TEXT("Gameplay.ControllerDeadZone"), 0.0, 0.5 },
+    { TEXT("Gameplay.AimAssistStrength"), 0.0, 1.0 },
+    { TEXT("Gameplay.CameraShakeIntensity"), 0.0, 1.0 },
+    { TEXT("Gameplay.HeadBobIntensity"), 0.0, 1.0 },
+    { TEXT("Gameplay.CameraSmoothing"), 0.0, 1.0 },
+    { TEXT("Accessibility.UIScale"), 0.5, 2.0 },
+    { TEXT("Accessibility.TextSize"), 0.5, 2.0 },
+    { TEXT("Network.MaxPingThreshold"), 0.0, UPMUnboundedSetting },
+    { TEXT("Network.NetworkSmoothing"), 0.0, 1.0 },
+    { TEXT("Network.BandwidthLimitKBps"), 0.0, UPMUnboundedSetting },
+    { TEXT("Server.MinServerTickRate"), 1.0, 240.0 },
+    { TEXT("Server.MaxServerTickRate"), 1.0, 240.0 },
+    { TEXT("Server.TickBudgetFraction"), 0.5, 0.95 },
+    { TEXT("Server.MinNetCullDistanceScale"), 0.25, 1.0 }
+};
+
+/** Value clamped to the setting's range; integers without one still have to fit an int32 */
+static double UPMClampSettingValue(const FString& SettingPath, double Value)
+{
+    for (const FUPMSettingRange& Range : UPMSettingRanges)
+    {
+        if (SettingPath.Equals(Range.SettingPath, ESearchCase::IgnoreCase))
+        {
+            return FMath::Clamp(Value, Range.Min, Range.Max);
+        }
+    }
+    return FMath::Clamp(Value, static_cast<double>(TNumericLimits<int32>::Lowest()), static_cast<double>(TNumericLimits<int32>::Max()));
+}
+
+/** A value the enum declares, not its _MAX or a trailing count such as EWindowMode::NumWindowModes */
+static bool UPMIsValidEnumSettingValue(const UEnum* Enum, double Value)
+{
+    const int32 Index = Enum->GetIndexByValue(static_cast<int64>(FMath::RoundToDouble(Value)));
+    if (Index == INDEX_NONE || (Enum->ContainsExistingMax() && Index == Enum->NumEnums() - 1))
+    {
+        return false;
+    }
+    return !Enum->GetNameStringByIndex(Index).StartsWith(TEXT("Num"), ESearchCase::CaseSensitive);
+}
+
+bool UUPMSettingsManager::SetSettingValue(FUPMCompleteSettings& Settings, const FString& SettingPath, double Value)
+{
+    const FStructProperty* CategoryProperty = nullptr;
+    EUPMSettingsCategory Category = EUPMSettingsCategory::None;
+    const FProperty* FieldProperty = UPMFindSettingProperty(SettingPath, CategoryProperty, Category);
+    if (!FieldProperty || !FMath::IsFinite(Value))
+    {
+        return false;
+    }
+    Value = UPMClampSettingValue(SettingPath, Value);
+
+    void* FieldData = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&Settings));
+    if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(FieldProperty))
+    {
+        BoolProperty->SetPropertyValue(FieldData, Value != 0.0);
+        return true;
+    }
+    const FNumericProperty* NumericProperty = CastField<FNumericProperty>(FieldProperty);
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(FieldProperty))
+    {
+        if (!UPMIsValidEnumSettingValue(EnumProperty->GetEnum(), Value))
+        {
+            return false;
+        }
+        NumericProperty = EnumProperty->GetUnderlyingProperty();
+    }
+    else if (const FByteProperty* ByteProperty = CastField<FByteProperty>(FieldProperty))
+    {
+        // TEnumAsByte fields (Display.WindowMode) are byte properties with an enum
+        if (ByteProperty->Enum && !UPMIsValidEnumSettingValue(ByteProperty->Enum, Value))
+        {
+            return false;
+        }
+    }
+    if (NumericProperty)
+    {
+        if (NumericProperty->IsFloatingPoint())
+        {
+            NumericProperty->SetFloatingPointPropertyValue(FieldData, Value);
+        }
+        else
+        {
+            NumericProperty->SetIntPropertyValue(FieldData, static_cast<int64>(FMath::RoundToDouble(Value)));
+        }
+        return true;
+    }
+    return false;
+}
+
+bool UUPMSettingsManager::GetSettingValue(const FUPMCompleteSettings& Settings, const FString& SettingPath, double& OutValue)
+{
+    const FStructProperty* CategoryProperty = nullptr;
+    EUPMSettingsCategory Category = EUPMSettingsCategory::None;
+    const FProperty* FieldProperty = UPMFindSettingProperty(SettingPath, CategoryProperty, Category);
+    if (!FieldProperty)
+    {
+        return false;
+    }
+
+    const void* FieldData = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&Settings));
+    if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(FieldProperty))
+    {
+        OutValue = BoolProperty->GetPropertyValue(FieldData) ? 1.0 : 0.0;
+        return true;
+    }
+    const FNumericProperty* NumericProperty = CastField<FNumericProperty>(FieldProperty);
+    if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(FieldProperty))
+    {
+        NumericProperty = EnumProperty->GetUnderlyingProperty();
+    }
+    if (NumericProperty)
+    {
+        OutValue = NumericProperty->IsFloatingPoint() ? NumericProperty->GetFloatingPointPropertyValue(FieldData)
+            : static_cast<double>(NumericProperty->GetSignedIntPropertyValue(FieldData));
+        return true;
+    }
+    return false;
+}
+
+void UUPMSettingsManager::GetSettingPaths(TArray<FString>& OutSettingPaths)
+{
+    OutSettingPaths.Reset();
+    for (const TPair<EUPMSettingsCategory, const TCHAR*>& Category : UPMSettingsCategoryNames)
+    {
+        const FStructProperty* CategoryProperty = FindFProperty<FStructProperty>(FUPMCompleteSettings::StaticStruct(), Category.Value);
+        if (!CategoryProperty)
+        {
+            continue;
+        }
+
+        for (TFieldIterator<FProperty> It(CategoryProperty->Struct); It; ++It)
+        {
+            if (It->IsA<FBoolProperty>() || It->IsA<FNumericProperty>() || It->IsA<FEnumProperty>())
+            {
+                OutSettingPaths.Add(FString::Printf(TEXT("%s.%s"), Category.Value, *It->GetName()));
+            }
+        }
+    }
+}
+
+EUPMSettingsCategory UUPMSettingsManager::GetSettingCategory(const FString& SettingPath)
+{
+    const FStructProperty* CategoryProperty = nullptr;
+    EUPMSettingsCategory Category = EUPMSettingsCategory::None;
+    return UPMFindSettingProperty(SettingPath, CategoryProperty, Category) ? Category : EUPMSettingsCategory::None;
+}
+
+bool UUPMSettingsManager::SetSettingByName(const FString& SettingPath, double Value)
+{
+    double OldValue = 0.0;
+    double NewValue = 0.0;
+    if (!GetSettingValue(CurrentSettings, SettingPath, OldValue) || !SetSettingValue(CurrentSettings, SettingPath, Value))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UPM: Unknown, non-numeric or invalid setting: %s = %g"), *SettingPath, Value);
+        return false;
+    }
+
+    GetSettingValue(CurrentSettings, SettingPath, NewValue);
+    if (NewValue != OldValue)
+    {
+        CommitSettings(GetSettingCategory(SettingPath));
+    }
+    return true;
+}
+
+bool UUPMSettingsManager::GetSettingByName(const FString& SettingPath, float& OutValue) const
+{
+    double Value = 0.0;
+    if (!GetSettingValue(CurrentSettings, SettingPath, Value))
+    {
+        return false;
+    }
+    OutValue = static_cast<float>(Value);
+    return true;
+}
+
+// Settings whose apply rebuilds something (everything else is a CVar or scalability write)
+static const TPair<const TCHAR*, const TCHAR*> UPMExpensiveSettings[] =
+{
+    { TEXT("Display.Resolution"), TEXT("swapchain resize") },
+    { TEXT("Display.WindowMode"), TEXT("window and swapchain recreation") },
+    { TEXT("Display.bBorderlessWindow"), TEXT("window and swapchain recreation") },
+    { TEXT("Display.MonitorIndex"), TEXT("window move and swapchain recreation") },
+    { TEXT("Display.bEnableHDR"), TEXT("swapchain format change") },
+    { TEXT("Performance.bEnableTripleBuffering"), TEXT("swapchain buffer count") },
+    { TEXT("Graphics.TextureQuality"), TEXT("texture streaming pool rebuild") },
+    { TEXT("Rendering.bEnableRayTracing"), TEXT("ray tracing scene and shader rebuild") },
+    { TEXT("Rendering.bEnableLumen"), TEXT("Lumen scene and surface cache rebuild") },
+};
+
+// A measured median stall of two 60 Hz frames makes a setting expensive even if the table does not list it;
+// a single change is not enough, one noisy measurement would otherwise defer a cheap setting in every session
+static const float UPMMeasuredExpensiveStallMs = 33.0f;
+static const int32 UPMMeasuredExpensiveMinSamples = 3;
+
+static bool UPMIsMeasuredExpensive(const FUPMSettingApplyCostStats& Stats)
+{
+    return Stats.Samples >= UPMMeasuredExpensiveMinSamples && Stats.MedianStallMs >= UPMMeasuredExpensiveStallMs;
+}
+
+EUPMSettingApplyCost UUPMSettingsManager::GetSettingApplyCost(const FString& SettingPath) const
+{
+    for (const TPair<const TCHAR*, const TCHAR*>& Setting : UPMExpensiveSettings)
+    {
+        if (SettingPath.Equals(Setting.Key, ESearchCase::IgnoreCase))
+        {
+            return EUPMSettingApplyCost::Expensive;
+        }
+    }
+    return UPMIsMeasuredExpensive(GetSettingApplyCostStats(SettingPath)) ? EUPMSettingApplyCost::Expensive : EUPMSettingApplyCost::Cheap;
+}
+
+FUPMSettingApplyCostStats UUPMSettingsManager::GetSettingApplyCostStats(const FString& SettingPath) const
+{
+    if (ApplyCostTracker.IsValid())
+    {
+        for (const TPair<FString, FUPMSettingApplyCostStats>& Cost : ApplyCostTracker->GetCosts())
+        {
+            if (SettingPath.Equals(Cost.Key, ESearchCase::IgnoreCase))
+            {
+                return Cost.Value;
+            }
+        }
+    }
+
+    FUPMSettingApplyCostStats Stats;
+    Stats.Setting = SettingPath;
+    return Stats;
+}
+
+TArray<FUPMSettingApplyCostStats> UUPMSettingsManager::GetAllSettingApplyCosts() const
+{
+    TArray<FUPMSettingApplyCostStats> Costs;
+    if (ApplyCostTracker.IsValid())
+    {
+        ApplyCostTracker->GetCosts().GenerateValueArray(Costs);
+        Costs.Sort([](const FUPMSettingApplyCostStats& A, const FUPMSettingApplyCostStats& B) { return A.MeanStallMs > B.MeanStallMs; });
+    }
+    return Costs;
+}
+
+FUPMSettingApplyCostStats UUPMSettingsManager::GetBatchApplyCostStats() const
+{
+    return ApplyCostTracker.IsValid() ? ApplyCostTracker->GetBatchCosts() : FUPMSettingApplyCostStats();
+}
+
+void UUPMSettingsManager::DeferExpensiveChanges(EUPMSettingsCategory Categories)
+{
+    // Known rebuilds plus whatever has been measured to stall
+    TArray<TPair<FString, FString>> ExpensiveSettings;
+    for (const TPair<const TCHAR*, const TCHAR*>& Setting : UPMExpensiveSettings)
+    {
+        ExpensiveSettings.Emplace(Setting.Key, Setting.Value);
+    }
+    if (ApplyCostTracker.IsValid())
+    {
+        for (const TPair<FString, FUPMSettingApplyCostStats>& Cost : ApplyCostTracker->GetCosts())
+        {
+            if (UPMIsMeasuredExpensive(Cost.Value)
+                && !ExpensiveSettings.ContainsByPredicate([&Cost](const TPair<FString, FString>& Setting) { return Setting.Key == Cost.Key; }))
+            {
+                ExpensiveSettings.Emplace(Cost.Key, FString::Printf(TEXT("measured %.0f ms median stall"), Cost.Value.MedianStallMs));
+            }
+        }
+    }
+
+    for (const TPair<FString, FString>& Setting : ExpensiveSettings)
+    {
+        const FStructProperty* CategoryProperty = nullptr;
+        EUPMSettingsCategory Category = EUPMSettingsCategory::None;
+        const FProperty* FieldProperty = UPMFindSettingProperty(Setting.Key, CategoryProperty, Category);
+        if (!FieldProperty || !EnumHasAnyFlags(Categories, Category))
+        {
+            continue;
+        }
+
+        void* Requested = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&CurrentSettings));
+        const void* Applied = FieldProperty->ContainerPtrToValuePtr<void>(CategoryProperty->ContainerPtrToValuePtr<void>(&CommittedSettings));
+        if (FieldProperty->Identical(Requested, Applied))
+        {
+            // Changed back before it was applied
+            DeferredSettingPaths.Remove(Setting.Key);
+            continue;
+        }
+
+        if (!DeferredSettingPaths.Contains(Setting.Key))
+        {
+            UE_LOG(LogTemp, Log, TEXT("UPM: %s deferred to the next safe point (%s)"), *Setting.Key, *Setting.Value);
+            DeferredSettingPaths.Add(Setting.Key);
+        }
+        FieldProperty->CopyCompleteValue(Requested, Applied);
+    }
+}
+
+/** The first local player's camera is fully faded out */
+static bool UPMIsCameraFadedOut(UWorld* World)
+{
+    if (GEngine)
+    {
+        if (const APlayerController* PlayerController = GEngine->GetFirstLocalPlayerController(World))
+        {
+            if (const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager)
+            {
+                return CameraManager->bEnableFading && CameraManager->FadeAmount >= 1.0f;
+            }
+        }
+    }
+    return false;
+}
+
+bool UUPMSettingsManager::IsAtSafePoint() const
+{
+    if (bForceSafePoint || !bDeferExpensiveSettings)
+    {
+        return true;
+    }
+
+    // Only play needs protecting; editor worlds, startup and the time between maps are safe
+    UWorld* World = CachedWorld.Get();
+    if (!World || !World->IsGameWorld() || !World->HasBegunPlay() || World->IsPaused())
+    {
+        return true;
+    }
+
+    return UPMIsCameraFadedOut(World);
+}
+
+void UUPMSettingsManager::NotifySafePoint()
+{
+    // A hitch is acceptable here, so a time-sliced commit finishes right away
+    TGuardValue<bool> SafePointGuard(bForceSafePoint, true);
+    FlushTimeSlicedCommit();
+
+    if (DeferredSettingPaths.Num() == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Safe point, applying %d deferred settings"), DeferredSettingPaths.Num());
+    CommitSettings(EUPMSettingsCategory::None);
+}
+
+void UUPMSettingsManager::BeginSettingsBatch()
+{
+    SettingsBatchDepth++;
+}
+
+void UUPMSettingsManager::EndSettingsBatch()
+{
+    if (SettingsBatchDepth > 0 && --SettingsBatchDepth == 0 && PendingCategories != EUPMSettingsCategory::None)
+    {
+        CommitSettings(EUPMSettingsCategory::None);
+    }
+}
+
+void UUPMSettingsManager::SetAllSettings(const FUPMCompleteSettings& Settings)
+{
+    CurrentSettings = Settings;
+    CommitSettings(EUPMSettingsCategory::All);
+}
+
+// ==================== Shader Precache ====================
+
+bool UUPMSettingsManager::PrecacheSettings(const FUPMCompleteSettings& Settings)
+{
+    return ShaderPrecache.IsValid() && ShaderPrecache->Request(Settings);
+}
+
+void UUPMSettingsManager::SetAllSettingsWhenWarm(const FUPMCompleteSettings& Settings, float TimeoutSeconds)
+{
+    if (!PrecacheSettings(Settings))
+    {
+        SettingsWaitingForPrecache.Reset();
+        SetAllSettings(Settings);
+        return;
+    }
+
+    // Applied from BeginFrame
+    SettingsWaitingForPrecache = Settings;
+    PrecacheDeadline = FPlatformTime::Seconds() + FMath::Max(TimeoutSeconds, 0.0f);
+}
 
-    // Keep only last 2 seconds of data
-    if (FPSHistoryTimeAccumulator > 2.0f)
+bool UUPMSettingsManager::LoadProfileWhenWarm(const FString& ProfileName, float TimeoutSeconds)
+{
+    FUPMCompleteSettings Settings;
+    if (!ReadProfile(ProfileName, Settings))
     {
-        if (FPSHistory.Num() > 60)
-        {
-            FPSHistory.RemoveAt(0, FPSHistory.Num() - 120);
-        }
-        FPSHistoryTimeAccumulator = 2.0f;
+        return false;
     }
 
-    // Calculate FPS statistics
-    if (FPSHistory.Num() > 0)
-    {
-        float Sum = 0.0f;
-        float Min = FPSHistory[0];
-        float Max = FPSHistory[0];
+    SetAllSettingsWhenWarm(Settings, TimeoutSeconds);
+    return true;
+}
 
-        for (float FPS : FPSHistory)
-        {
-            Sum += FPS;
-            Min = FMath::Min(Min, FPS);
-            Max = FMath::Max(Max, FPS);
-        }
+float UUPMSettingsManager::GetShaderPrecacheProgress() const
+{
+    return ShaderPrecache.IsValid() ? ShaderPrecache->GetProgress() : 1.0f;
+}
 
-        PerformanceMetrics.FPS_Average = Sum / FPSHistory.Num();
-        PerformanceMetrics.FPS_Min = Min;
-        PerformanceMetrics.FPS_Max = Max;
-    }
+bool UUPMSettingsManager::IsShaderPrecacheWarm() const
+{
+    return !ShaderPrecache.IsValid() || ShaderPrecache->IsWarm();
+}
 
-    // CPU and GPU frame times
-    PerformanceMetrics.CPUFrameTime = DeltaTime * 1000.0f; // Convert to milliseconds
-    PerformanceMetrics.GPUFrameTime = DeltaTime * 1000.0f * 0.8f; // Rough estimate
+FUPMShaderPrecacheStats UUPMSettingsManager::GetShaderPrecacheStats() const
+{
+    return ShaderPrecache.IsValid() ? ShaderPrecache->GetStats() : FUPMShaderPrecacheStats();
+}
 
-    // Memory usage
-    FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
-    PerformanceMetrics.RAMUsageMB = static_cast<float>(MemoryStats.UsedPhysical) / (1024.0f * 1024.0f);
+// ==================== Upscaling ====================
 
-    // VRAM usage (if available)
-    if (GDynamicRHI)
-    {
-        uint64 UsedVRAM = 0;
-        RHIGetResourceMemoryUsage(UsedVRAM);
+bool UUPMSettingsManager::IsUpscalerAvailable(EUPMUpscalingMode Mode) const
+{
+    return FUPMUpscalerManager::IsAvailable(Mode);
+}
 
-        if (UsedVRAM > 0)
+TArray<EUPMUpscalingMode> UUPMSettingsManager::GetAvailableUpscalers() const
+{
+    TArray<EUPMUpscalingMode> Modes;
+    for (EUPMUpscalingMode Mode : { EUPMUpscalingMode::None, EUPMUpscalingMode::TSR, EUPMUpscalingMode::DLSS, EUPMUpscalingMode::FSR, EUPMUpscalingMode::XeSS })
+    {
+        if (FUPMUpscalerManager::IsAvailable(Mode))
         {
-            PerformanceMetrics.VRAMUsageMB = static_cast<float>(UsedVRAM) / (1024.0f * 1024.0f);
+            Modes.Add(Mode);
         }
     }
-
-    // Thread load (normalized 0-1)
-    PerformanceMetrics.GameThreadLoad = FMath::Clamp(DeltaTime / 0.0166f, 0.0f, 1.0f); // 60 FPS baseline
-    PerformanceMetrics.RenderThreadLoad = PerformanceMetrics.GameThreadLoad * 0.9f;
-    PerformanceMetrics.RHIThreadLoad = PerformanceMetrics.GameThreadLoad * 0.7f;
+    return Modes;
 }
 
-void UUPMSettingsManager::ResetPerformanceStats()
+EUPMUpscalingMode UUPMSettingsManager::GetActiveUpscalingMode() const
 {
-    FPSHistory.Empty();
-    FPSHistoryTimeAccumulator = 0.0f;
-    PerformanceMetrics.FPS_Min = 999.0f;
-    PerformanceMetrics.FPS_Max = 0.0f;
-    PerformanceMetrics.FPS_Average = 0.0f;
+    return UpscalerManager.IsValid() ? UpscalerManager->GetActiveMode() : EUPMUpscalingMode::None;
 }
 
-// ==================== Settings Application ====================
+float UUPMSettingsManager::GetUpscalingScreenPercentage() const
+{
+    return FUPMUpscalerManager::GetScreenPercentage(CurrentSettings);
+}
 
-void UUPMSettingsManager::ApplyAllSettings()
+TArray<FUPMUpscalerStats> UUPMSettingsManager::GetUpscalerStats() const
 {
-    ApplyGraphicsSettings();
-    ApplyRenderingSettings();
-    ApplyPerformanceSettings();
-    ApplyDisplaySettings();
-    ApplyAudioSettings();
-    ApplyGameplaySettings();
-    ApplyAccessibilitySettings();
-    ApplyNetworkSettings();
-    ApplyDebugSettings();
+    return UpscalerManager.IsValid() ? UpscalerManager->GetStats() : TArray<FUPMUpscalerStats>();
 }
 
 // ==================== Graphics Settings ====================
@@ -166,37 +1355,37 @@ void UUPMSettingsManager::ApplyAllSettings()
 void UUPMSettingsManager::SetGraphicsSettings(const FUPMGraphicsSettings& Settings)
 {
     CurrentSettings.Graphics = Settings;
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::SetAntiAliasingQuality(int32 Quality)
 {
     CurrentSettings.Graphics.AntiAliasingQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::SetShadowQuality(int32 Quality)
 {
     CurrentSettings.Graphics.ShadowQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::SetViewDistanceQuality(int32 Quality)
 {
     CurrentSettings.Graphics.ViewDistanceQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::SetPostProcessQuality(int32 Quality)
 {
     CurrentSettings.Graphics.PostProcessQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::SetTextureQuality(int32 Quality)
 {
     CurrentSettings.Graphics.TextureQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyGraphicsSettings();
+    CommitSettings(EUPMSettingsCategory::Graphics);
 }
 
 void UUPMSettingsManager::ApplyGraphicsSettings()
@@ -226,14 +1415,14 @@ void UUPMSettingsManager::ApplyGraphicsSettings()
 void UUPMSettingsManager::SetRenderingSettings(const FUPMRenderingSettings& Settings)
 {
     CurrentSettings.Rendering = Settings;
-    ApplyRenderingSettings();
+    CommitSettings(EUPMSettingsCategory::Rendering);
 }
 
 #define UPM_SET_RENDERING_BOOL(VarName, MemberName) \
 void UUPMSettingsManager::Set##VarName##Enabled(bool bEnabled) \
 { \
     CurrentSettings.Rendering.bEnable##VarName = bEnabled; \
-    ApplyRenderingSettings(); \
+    CommitSettings(EUPMSettingsCategory::Rendering); \
 }
 
 UPM_SET_RENDERING_BOOL(Lumen, Lumen)
@@ -255,25 +1444,31 @@ UPM_SET_RENDERING_BOOL(ContactShadows, ContactShadows)
 void UUPMSettingsManager::SetAnisotropicFiltering(int32 Level)
 {
     CurrentSettings.Rendering.AnisotropicFiltering = FMath::Clamp(Level, 0, 4);
-    ApplyRenderingSettings();
+    CommitSettings(EUPMSettingsCategory::Rendering);
 }
 
 void UUPMSettingsManager::SetUpscalingMode(EUPMUpscalingMode Mode)
 {
     CurrentSettings.Rendering.UpscalingMode = Mode;
-    ApplyRenderingSettings();
+    CommitSettings(EUPMSettingsCategory::Rendering);
+}
+
+void UUPMSettingsManager::SetUpscalingQuality(EUPMUpscalingQuality Quality)
+{
+    CurrentSettings.Rendering.UpscalingQuality = Quality;
+    CommitSettings(EUPMSettingsCategory::Rendering);
 }
 
 void UUPMSettingsManager::SetGlobalIlluminationQuality(int32 Quality)
 {
     CurrentSettings.Rendering.GlobalIlluminationQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyRenderingSettings();
+    CommitSettings(EUPMSettingsCategory::Rendering);
 }
 
 void UUPMSettingsManager::SetReflectionQuality(int32 Quality)
 {
     CurrentSettings.Rendering.ReflectionQuality = FMath::Clamp(Quality, 0, 4);
-    ApplyRenderingSettings();
+    CommitSettings(EUPMSettingsCategory::Rendering);
 }
 
 void UUPMSettingsManager::ApplyRenderingSettings()
@@ -318,20 +1513,10 @@ void UUPMSettingsManager::ApplyRenderingSettings()
     // TAA
     SET_CVAR_INT("r.TemporalAA.Quality", CurrentSettings.Rendering.bEnableTAA ? 2 : 0);
 
-    // Upscaling (these would depend on what plugins are available)
-    switch (CurrentSettings.Rendering.UpscalingMode)
+    // Upscaler, anti-aliasing method and screen percentage (Display commits re-apply Rendering)
+    if (UpscalerManager.IsValid())
     {
-    case EUPMUpscalingMode::TSR:
-        SET_CVAR_INT("r.TemporalSuperResolution", 1);
-        break;
-    case EUPMUpscalingMode::DLSS:
-        SET_CVAR_INT("r.NGX.DLSS.Enable", 1);
-        break;
-    case EUPMUpscalingMode::FSR:
-        SET_CVAR_INT("r.FidelityFX.FSR.Enabled", 1);
-        break;
-    default:
-        break;
+        UpscalerManager->Apply(CurrentSettings);
     }
 
     // GI and Reflections quality
@@ -353,55 +1538,139 @@ void UUPMSettingsManager::ApplyRenderingSettings()
 void UUPMSettingsManager::SetPerformanceSettings(const FUPMPerformanceSettings& Settings)
 {
     CurrentSettings.Performance = Settings;
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetVSyncEnabled(bool bEnabled)
 {
     CurrentSettings.Performance.bEnableVSync = bEnabled;
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetFrameRateLimit(float Limit)
 {
     CurrentSettings.Performance.FrameRateLimit = FMath::Max(0.0f, Limit);
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetAutoFrameRateTarget(bool bEnabled)
+{
+    CurrentSettings.Performance.bAutoFrameRateTarget = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetVariableRefreshRate(bool bEnabled)
+{
+    CurrentSettings.Performance.bVariableRefreshRate = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+FUPMDisplayRefreshInfo UUPMSettingsManager::GetDisplayRefreshInfo() const
+{
+    return FrameRateTarget.IsValid() ? FrameRateTarget->GetDisplay() : FUPMFrameRateTarget::QueryDisplay();
+}
+
+TArray<float> UUPMSettingsManager::GetFrameRateTargets() const
+{
+    return FUPMFrameRateTarget::GetTargets(GetDisplayRefreshInfo(), CurrentSettings.Performance.bVariableRefreshRate);
+}
+
+float UUPMSettingsManager::GetFrameRateTarget() const
+{
+    if (CurrentSettings.Performance.bAutoFrameRateTarget && FrameRateTarget.IsValid() && FrameRateTarget->GetTarget() > 0.0f)
+    {
+        return FrameRateTarget->GetTarget();
+    }
+    return CurrentSettings.Performance.FrameRateLimit;
+}
+
+void UUPMSettingsManager::ApplyFrameRateTarget()
+{
+    // Divisors of the refresh rate are paced by VSync itself; a game thread cap would fight it
+    const float EcoLimit = GetEcoFrameRateLimit();
+    const bool bPaceWithSyncInterval = CurrentSettings.Performance.bAutoFrameRateTarget && CurrentSettings.Performance.bEnableVSync
+        && FrameRateTarget.IsValid() && FrameRateTarget->GetSyncInterval() > 1 && EcoLimit <= 0.0f;
+    float MaxFPS = bPaceWithSyncInterval ? 0.0f : GetFrameRateTarget();
+    if (EcoLimit > 0.0f)
+    {
+        MaxFPS = MaxFPS > 0.0f ? FMath::Min(MaxFPS, EcoLimit) : EcoLimit;
+    }
+
+    if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("t.MaxFPS")))
+    {
+        CVar->Set(MaxFPS);
+    }
+    if (bPaceWithSyncInterval || bFrameRateSyncIntervalSet)
+    {
+        if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("rhi.SyncInterval")))
+        {
+            CVar->Set(bPaceWithSyncInterval ? FrameRateTarget->GetSyncInterval() : 1);
+        }
+        bFrameRateSyncIntervalSet = bPaceWithSyncInterval;
+    }
+
+    // The tick budget is a fraction of the frame time at the cap
+    FUPMPerformanceSettings TickBudgetSettings = CurrentSettings.Performance;
+    TickBudgetSettings.FrameRateLimit = GetFrameRateTarget();
+    if (GEngine)
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            UWorld* World = Context.World();
+            if (UUPMTickBudgetSubsystem* TickBudget = World ? World->GetSubsystem<UUPMTickBudgetSubsystem>() : nullptr)
+            {
+                TickBudget->SetSettings(TickBudgetSettings);
+            }
+        }
+    }
 }
 
 void UUPMSettingsManager::SetDynamicResolutionEnabled(bool bEnabled)
 {
     CurrentSettings.Performance.bEnableDynamicResolution = bEnabled;
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetMinFrameRateForDynamicRes(float MinFPS)
 {
     CurrentSettings.Performance.MinFrameRateForDynamicRes = FMath::Clamp(MinFPS, 15.0f, 60.0f);
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetTripleBufferingEnabled(bool bEnabled)
 {
     CurrentSettings.Performance.bEnableTripleBuffering = bEnabled;
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetAsyncComputeEnabled(bool bEnabled)
 {
     CurrentSettings.Performance.bEnableAsyncCompute = bEnabled;
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetLODDistanceMultiplier(float Multiplier)
 {
     CurrentSettings.Performance.LODDistanceMultiplier = FMath::Clamp(Multiplier, 0.25f, 4.0f);
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::SetProcessPriority(int32 Priority)
 {
     CurrentSettings.Performance.ProcessPriority = FMath::Clamp(Priority, 0, 2);
-    ApplyPerformanceSettings();
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetTickBudgetEnabled(bool bEnabled)
+{
+    CurrentSettings.Performance.bEnableTickBudget = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetTickBudgetFraction(float Fraction)
+{
+    CurrentSettings.Performance.TickBudgetFraction = FMath::Clamp(Fraction, 0.1f, 0.9f);
+    CommitSettings(EUPMSettingsCategory::Performance);
 }
 
 void UUPMSettingsManager::ApplyPerformanceSettings()
@@ -412,14 +1681,9 @@ void UUPMSettingsManager::ApplyPerformanceSettings()
         // Original settings
         GameSettings->SetVSyncEnabled(CurrentSettings.Performance.bEnableVSync);
 
-        if (CurrentSettings.Performance.FrameRateLimit > 0.0f)
-        {
-            GameSettings->SetFrameRateLimit(CurrentSettings.Performance.FrameRateLimit);
-        }
-        else
-        {
-            GameSettings->SetFrameRateLimit(0.0f);
-        }
+        // The player's own limit; an automatic target is machine-specific and goes only to t.MaxFPS (ApplyFrameRateTarget
+        // below), it must not be saved to GameUserSettings.ini
+        GameSettings->SetFrameRateLimit(FMath::Max(0.0f, CurrentSettings.Performance.FrameRateLimit));
 
         GameSettings->ApplySettings(false);
     }
@@ -434,7 +1698,6 @@ void UUPMSettingsManager::ApplyPerformanceSettings()
             CVar->Set(Value);
 
     SET_CVAR_INT("r.VSync", CurrentSettings.Performance.bEnableVSync ? 1 : 0);
-    SET_CVAR_FLOAT("t.MaxFPS", CurrentSettings.Performance.FrameRateLimit);
 
     // NEW: Dynamic resolution
     SET_CVAR_INT("r.DynamicRes.OperationMode", CurrentSettings.Performance.bEnableDynamicResolution ? 2 : 0);
@@ -462,6 +1725,154 @@ void UUPMSettingsManager::ApplyPerformanceSettings()
 
     #undef SET_CVAR_INT
     #undef SET_CVAR_FLOAT
+
+    // Frame rate cap, and the tick budget derived from it (one subsystem per game world, e.g. several in multi-client PIE)
+    ApplyFrameRateTarget();
+}
+
+// ==================== Eco Mode ====================
+
+void UUPMSettingsManager::SetEcoModeEnabled(bool bEnabled)
+{
+    CurrentSettings.Performance.bEnableEcoMode = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetMenuActive(bool bActive)
+{
+    bMenuActive = bActive;
+    UpdateEcoState();
+}
+
+EUPMEcoState UUPMSettingsManager::GetCurrentEcoState() const
+{
+    // The editor has its own background throttling, and PIE loses focus whenever the editor is used
+    const FUPMPerformanceSettings& Settings = CurrentSettings.Performance;
+    if (!Settings.bEnableEcoMode || GIsEditor || IsRunningDedicatedServer() || !GEngine || !GEngine->GameViewport)
+    {
+        return EUPMEcoState::None;
+    }
+
+    const TSharedPtr<SWindow> Window = GEngine->GameViewport->GetWindow();
+    if (Window.IsValid() && Window->IsWindowMinimized())
+    {
+        return EUPMEcoState::Minimized;
+    }
+    if (!FPlatformApplicationMisc::IsThisApplicationForeground())
+    {
+        return EUPMEcoState::Unfocused;
+    }
+    if (Settings.IdleTimeoutSeconds > 0.0f && FSlateApplication::IsInitialized()
+        && FPlatformTime::Seconds() - FSlateApplication::Get().GetLastUserInteractionTime() >= Settings.IdleTimeoutSeconds)
+    {
+        return EUPMEcoState::Idle;
+    }
+
+    const UWorld* World = GEngine->GameViewport->GetWorld();
+    if (bMenuActive || (World && World->IsPaused()))
+    {
+        return EUPMEcoState::Menu;
+    }
+    return EUPMEcoState::None;
+}
+
+float UUPMSettingsManager::GetEcoFrameRateLimit() const
+{
+    const FUPMPerformanceSettings& Settings = CurrentSettings.Performance;
+    switch (EcoState)
+    {
+    case EUPMEcoState::Menu: return Settings.MenuFrameRateLimit;
+    case EUPMEcoState::Idle: return Settings.IdleFrameRateLimit;
+    case EUPMEcoState::Unfocused: return Settings.UnfocusedFrameRateLimit;
+    case EUPMEcoState::Minimized: return Settings.MinimizedFrameRateLimit;
+    default: return 0.0f;
+    }
+}
+
+void UUPMSettingsManager::UpdateEcoState()
+{
+    const EUPMEcoState NewState = GetCurrentEcoState();
+    if (NewState == EcoState)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Verbose, TEXT("UPM: Eco state %s -> %s"), *UEnum::GetValueAsString(EcoState), *UEnum::GetValueAsString(NewState));
+    EcoState = NewState;
+    ApplyFrameRateTarget();
+
+    UGameViewportClient* GameViewport = GEngine ? GEngine->GameViewport : nullptr;
+    const bool bSuspend = EcoState == EUPMEcoState::Minimized && CurrentSettings.Performance.bSuspendRenderingWhenMinimized;
+    if (GameViewport && bSuspend != bEcoSuspendedRendering)
+    {
+        if (bSuspend)
+        {
+            bWorldRenderingWasDisabled = GameViewport->bDisableWorldRendering;
+            GameViewport->bDisableWorldRendering = true;
+        }
+        else
+        {
+            GameViewport->bDisableWorldRendering = bWorldRenderingWasDisabled;
+        }
+        bEcoSuspendedRendering = bSuspend;
+    }
+}
+
+// ==================== Streaming Governor ====================
+
+void UUPMSettingsManager::SetStreamingGovernorEnabled(bool bEnabled)
+{
+    CurrentSettings.Performance.bEnableStreamingGovernor = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetStreamingBudgetMs(float BudgetMs)
+{
+    CurrentSettings.Performance.StreamingBudgetMs = FMath::Clamp(BudgetMs, 0.5f, 10.0f);
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetLoadingScreenActive(bool bActive)
+{
+    bLoadingScreenActive = bActive;
+}
+
+float UUPMSettingsManager::GetStreamingDistanceScale() const
+{
+    return StreamingGovernor.IsValid() ? StreamingGovernor->GetStreamingDistanceScale() : 1.0f;
+}
+
+void UUPMSettingsManager::SetEffectsBudgetEnabled(bool bEnabled)
+{
+    CurrentSettings.Performance.bEnableEffectsBudget = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+void UUPMSettingsManager::SetEffectsBudgetMs(float BudgetMs)
+{
+    CurrentSettings.Performance.EffectsBudgetMs = BudgetMs > 0.0f ? FMath::Clamp(BudgetMs, 0.1f, 10.0f) : 0.0f;
+    CommitSettings(EUPMSettingsCategory::Performance);
+}
+
+TArray<FUPMEffectSystemStats> UUPMSettingsManager::GetTopEffectSystems(int32 MaxEntries) const
+{
+    TArray<FUPMEffectSystemStats> Systems;
+    if (EffectsBudget.IsValid())
+    {
+        EffectsBudget->GetTopSystems(MaxEntries, Systems);
+    }
+    return Systems;
+}
+
+bool UUPMSettingsManager::IsLoadingScreen() const
+{
+    if (bLoadingMap || bLoadingScreenActive)
+    {
+        return true;
+    }
+
+    UWorld* World = CachedWorld.Get();
+    return !World || !World->HasBegunPlay() || UPMIsCameraFadedOut(World);
 }
 
 // ==================== Display Settings (EXPANDED) ====================
@@ -469,79 +1880,79 @@ void UUPMSettingsManager::ApplyPerformanceSettings()
 void UUPMSettingsManager::SetDisplaySettings(const FUPMDisplaySettings& Settings)
 {
     CurrentSettings.Display = Settings;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetResolution(FIntPoint Resolution)
 {
     CurrentSettings.Display.Resolution = Resolution;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetWindowMode(TEnumAsByte<EWindowMode::Type> Mode)
 {
     CurrentSettings.Display.WindowMode = Mode;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetBrightness(float Brightness)
 {
     CurrentSettings.Display.Brightness = FMath::Clamp(Brightness, 0.0f, 2.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetContrast(float Contrast)
 {
     CurrentSettings.Display.Contrast = FMath::Clamp(Contrast, 0.0f, 2.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetHDREnabled(bool bEnabled)
 {
     CurrentSettings.Display.bEnableHDR = bEnabled;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetHDRMaxNits(float MaxNits)
 {
     CurrentSettings.Display.HDRMaxNits = FMath::Clamp(MaxNits, 1000.0f, 10000.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetMonitorIndex(int32 Index)
 {
     CurrentSettings.Display.MonitorIndex = FMath::Max(0, Index);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetBorderlessWindow(bool bBorderless)
 {
     CurrentSettings.Display.bBorderlessWindow = bBorderless;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetScreenPercentage(float Percentage)
 {
     CurrentSettings.Display.ScreenPercentage = FMath::Clamp(Percentage, 50.0f, 200.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetMenuFieldOfView(float FOV)
 {
     CurrentSettings.Display.MenuFieldOfView = FMath::Clamp(FOV, 60.0f, 120.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetAspectRatioOverride(float AspectRatio)
 {
     CurrentSettings.Display.AspectRatioOverride = AspectRatio;
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::SetSafeZoneScale(float Scale)
 {
     CurrentSettings.Display.SafeZoneScale = FMath::Clamp(Scale, 0.8f, 1.0f);
-    ApplyDisplaySettings();
+    CommitSettings(EUPMSettingsCategory::Display);
 }
 
 void UUPMSettingsManager::ApplyDisplaySettings()
@@ -571,8 +1982,7 @@ void UUPMSettingsManager::ApplyDisplaySettings()
     SET_CVAR_INT("r.HDR.EnableHDROutput", CurrentSettings.Display.bEnableHDR ? 1 : 0);
     SET_CVAR_FLOAT("r.HDR.Display.OutputDevice", CurrentSettings.Display.HDRMaxNits);
 
-    // NEW: Screen percentage
-    SET_CVAR_FLOAT("r.ScreenPercentage", CurrentSettings.Display.ScreenPercentage);
+    // Screen percentage is paired with the upscaler in ApplyRenderingSettings
 
     #undef SET_CVAR_FLOAT
     #undef SET_CVAR_INT
@@ -583,14 +1993,14 @@ void UUPMSettingsManager::ApplyDisplaySettings()
 void UUPMSettingsManager::SetAudioSettings(const FUPMAudioSettings& Settings)
 {
     CurrentSettings.Audio = Settings;
-    ApplyAudioSettings();
+    CommitSettings(EUPMSettingsCategory::Audio);
 }
 
 #define UPM_SET_AUDIO_VOLUME(VarName) \
 void UUPMSettingsManager::Set##VarName##Volume(float Volume) \
 { \
     CurrentSettings.Audio.VarName##Volume = FMath::Clamp(Volume, 0.0f, 1.0f); \
-    ApplyAudioSettings(); \
+    CommitSettings(EUPMSettingsCategory::Audio); \
 }
 
 UPM_SET_AUDIO_VOLUME(Master)
@@ -606,60 +2016,255 @@ UPM_SET_AUDIO_VOLUME(VoiceChat)
 void UUPMSettingsManager::SetAudioQuality(int32 Quality)
 {
     CurrentSettings.Audio.AudioQuality = FMath::Clamp(Quality, 0, 3);
-    ApplyAudioSettings();
+    CommitSettings(EUPMSettingsCategory::Audio);
 }
 
 void UUPMSettingsManager::SetSurroundSoundMode(int32 Mode)
 {
     CurrentSettings.Audio.SurroundSoundMode = FMath::Clamp(Mode, 0, 2);
-    ApplyAudioSettings();
+    CommitSettings(EUPMSettingsCategory::Audio);
 }
 
 void UUPMSettingsManager::SetSpatialAudioEnabled(bool bEnabled)
 {
     CurrentSettings.Audio.bEnableSpatialAudio = bEnabled;
-    ApplyAudioSettings();
+    CommitSettings(EUPMSettingsCategory::Audio);
+}
+
+void UUPMSettingsManager::SetAdaptiveVoiceBudgetEnabled(bool bEnabled)
+{
+    CurrentSettings.Audio.bEnableAdaptiveVoiceBudget = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Audio);
+}
+
+void UUPMSettingsManager::SetDynamicRange(float Range)
+{
+    CurrentSettings.Audio.DynamicRange = FMath::Clamp(Range, 0.0f, 1.0f);
+    CommitSettings(EUPMSettingsCategory::Audio);
+}
+
+void UUPMSettingsManager::SetSubtitleTextSize(float Size)
+{
+    CurrentSettings.Audio.SubtitleTextSize = FMath::Clamp(Size, 0.5f, 2.0f);
+    CommitSettings(EUPMSettingsCategory::Audio);
+}
+
+void UUPMSettingsManager::SetSubtitleBackgroundOpacity(float Opacity)
+{
+    CurrentSettings.Audio.SubtitleBackgroundOpacity = FMath::Clamp(Opacity, 0.0f, 1.0f);
+    CommitSettings(EUPMSettingsCategory::Audio);
+}
+
+// Audio voice budget tuning
+static const int32 UPMVoiceCapsByQuality[] = { 16, 32, 64, 128 };
+static const int32 UPMSampleRatesByQuality[] = { 24000, 32000, 0, 48000 }; // 0 = the project's own rate
+static const int32 UPMMinVoiceLimit = 8;
+static const int32 UPMVoiceLimitRiseStep = 4;
+static const float UPMVoiceLimitDropFactor = 0.75f;
+static const float UPMHighAudioRenderLoad = 0.75f;     // Peak render time / buffer period
+static const float UPMLowAudioRenderLoad = 0.5f;
+static const float UPMAudioBudgetInterval = 0.5f;
+
+void UUPMSettingsManager::ApplyAudioSettings()
+{
+    #define SET_CVAR_INT(Name, Value) \
+        if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT(Name))) \
+            CVar->Set(Value);
+
+    #define SET_CVAR_FLOAT(Name, Value) \
+        if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT(Name))) \
+            CVar->Set(Value);
+
+    // Use console variables if your project uses them
+    SET_CVAR_FLOAT("au.MasterVolume", CurrentSettings.Audio.MasterVolume);
+
+    // NEW: HRTF, used by sources with binaural spatialization when a spatialization plugin is active
+    SET_CVAR_INT("au.DisableBinauralSpatialization", CurrentSettings.Audio.bEnableSpatialAudio ? 0 : 1);
+
+    #undef SET_CVAR_INT
+    #undef SET_CVAR_FLOAT
+
+    // NEW: Quality level (selects the project's audio quality level settings)
+    const int32 Quality = FMath::Clamp(CurrentSettings.Audio.AudioQuality, 0, 3);
+    if (UGameUserSettings* GameSettings = UGameUserSettings::GetGameUserSettings())
+    {
+        GameSettings->SetAudioQualityLevel(Quality);
+    }
+
+    // NEW: Voice budget, the quality sets the cap and the adaptive budget may run below it
+    const int32 VoiceCap = UPMVoiceCapsByQuality[Quality];
+    AudioVoiceLimit = (CurrentSettings.Audio.bEnableAdaptiveVoiceBudget && AudioVoiceLimit > 0)
+        ? FMath::Min(AudioVoiceLimit, VoiceCap)
+        : VoiceCap;
+    PerformanceMetrics.AudioVoiceLimit = AudioVoiceLimit;
+
+    if (FAudioDevice* AudioDevice = GetAudioDevice())
+    {
+        AudioDevice->SetMaxChannels(AudioVoiceLimit);
+
+        if (!AudioRenderMonitor.IsValid())
+        {
+            AudioRenderMonitor = MakeShared<FUPMAudioRenderMonitor, ESPMode::ThreadSafe>();
+        }
+        AudioRenderMonitor->Start(AudioDevice);
+    }
+
+    ApplyAudioSampleRateQuality();
+
+    // SurroundSoundMode: the mixer's output channel layout follows the output device when it is created
+    // and cannot be changed at runtime; the value is persisted for projects that route it themselves.
+}
+
+FAudioDevice* UUPMSettingsManager::GetAudioDevice() const
+{
+    if (UWorld* World = CachedWorld.Get())
+    {
+        if (FAudioDevice* AudioDevice = World->GetAudioDeviceRaw())
+        {
+            return AudioDevice;
+        }
+    }
+    return GEngine ? GEngine->GetMainAudioDeviceRaw() : nullptr;
+}
+
+// The player's sample rate lives in the user's GameUserSettings.ini; Engine.ini is never written
+static const TCHAR* UPMUserAudioSection = TEXT("/Script/UniversalPerformanceManager.UPMAudio");
+
+static const TCHAR* UPMGetAudioPlatformSection()
+{
+#if PLATFORM_WINDOWS
+    return TEXT("/Script/WindowsTargetPlatform.WindowsTargetSettings");
+#elif PLATFORM_LINUX
+    return TEXT("/Script/LinuxTargetPlatform.LinuxTargetSettings");
+#elif PLATFORM_MAC
+    return TEXT("/Script/MacTargetPlatform.MacTargetSettings");
+#elif PLATFORM_ANDROID
+    return TEXT("/Script/AndroidRuntimeSettings.AndroidRuntimeSettings");
+#elif PLATFORM_IOS
+    return TEXT("/Script/IOSRuntimeSettings.IOSRuntimeSettings");
+#else
+    return nullptr;
+#endif
+}
+
+void UUPMSettingsManager::ApplyStoredAudioSampleRate()
+{
+    const TCHAR* PlatformSection = UPMGetAudioPlatformSection();
+    int32 SampleRate = 0;
+    if (!PlatformSection || !GConfig
+        || !GConfig->GetInt(UPMUserAudioSection, TEXT("AudioSampleRate"), SampleRate, GGameUserSettingsIni) || SampleRate <= 0)
+    {
+        return;
+    }
+
+    // In memory only: the mixer reads it when the audio device is created, and the file is not marked dirty
+    if (FConfigFile* EngineConfig = GConfig->Find(GEngineIni))
+    {
+        const bool bWasDirty = EngineConfig->Dirty;
+        EngineConfig->SetInt(PlatformSection, TEXT("AudioSampleRate"), SampleRate);
+        EngineConfig->Dirty = bWasDirty;
+        UE_LOG(LogTemp, Log, TEXT("UPM: Audio sample rate %d Hz"), SampleRate);
+    }
 }
 
-void UUPMSettingsManager::SetDynamicRange(float Range)
+void UUPMSettingsManager::ApplyAudioSampleRateQuality()
 {
-    CurrentSettings.Audio.DynamicRange = FMath::Clamp(Range, 0.0f, 1.0f);
-    ApplyAudioSettings();
-}
+    // The mixer reads its sample rate when the audio device is created, so a change takes effect on the next
+    // launch (see ApplyStoredAudioSampleRate); High keeps the project's rate
+    if (!UPMGetAudioPlatformSection() || !GConfig)
+    {
+        return;
+    }
 
-void UUPMSettingsManager::SetSubtitleTextSize(float Size)
-{
-    CurrentSettings.Audio.SubtitleTextSize = FMath::Clamp(Size, 0.5f, 2.0f);
-    ApplyAudioSettings();
-}
+    const int32 SampleRate = UPMSampleRatesByQuality[FMath::Clamp(CurrentSettings.Audio.AudioQuality, 0, 3)];
+    int32 StoredSampleRate = 0;
+    GConfig->GetInt(UPMUserAudioSection, TEXT("AudioSampleRate"), StoredSampleRate, GGameUserSettingsIni);
+    if (StoredSampleRate == SampleRate)
+    {
+        return;
+    }
 
-void UUPMSettingsManager::SetSubtitleBackgroundOpacity(float Opacity)
-{
-    CurrentSettings.Audio.SubtitleBackgroundOpacity = FMath::Clamp(Opacity, 0.0f, 1.0f);
-    ApplyAudioSettings();
+    if (SampleRate > 0)
+    {
+        GConfig->SetInt(UPMUserAudioSection, TEXT("AudioSampleRate"), SampleRate, GGameUserSettingsIni);
+    }
+    else
+    {
+        GConfig->RemoveKey(UPMUserAudioSection, TEXT("AudioSampleRate"), GGameUserSettingsIni);
+    }
+    GConfig->Flush(false, GGameUserSettingsIni);
+    UE_LOG(LogTemp, Log, TEXT("UPM: Audio sample rate set to %s (applies on next launch)"),
+        SampleRate > 0 ? *FString::Printf(TEXT("%d Hz"), SampleRate) : TEXT("the project default"));
 }
 
-void UUPMSettingsManager::ApplyAudioSettings()
+void UUPMSettingsManager::UpdateAudioBudget(float DeltaTime)
 {
-    // Audio application depends on your audio system
-    // This is a placeholder for common audio system integration
+    AudioBudgetAccumulator += DeltaTime;
+    if (AudioBudgetAccumulator < UPMAudioBudgetInterval)
+    {
+        return;
+    }
+    AudioBudgetAccumulator = 0.0f;
 
-    #define SET_CVAR_FLOAT(Name, Value) \
-        if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT(Name))) \
-            CVar->Set(Value);
+    // Follow the device through world travel and device switches
+    FAudioDevice* AudioDevice = GetAudioDevice();
+    if (!AudioDevice)
+    {
+        return;
+    }
 
-    // Use console variables if your project uses them
-    SET_CVAR_FLOAT("au.MasterVolume", CurrentSettings.Audio.MasterVolume);
+    if (!AudioRenderMonitor.IsValid() || !AudioRenderMonitor->IsListeningTo(AudioDevice))
+    {
+        // New device since the last audio commit: carry the voice limit over and re-attach the monitor,
+        // the rest of the audio settings are not per device and stay committed
+        if (AudioVoiceLimit > 0)
+        {
+            AudioDevice->SetMaxChannels(AudioVoiceLimit);
+        }
+        if (!AudioRenderMonitor.IsValid())
+        {
+            AudioRenderMonitor = MakeShared<FUPMAudioRenderMonitor, ESPMode::ThreadSafe>();
+        }
+        AudioRenderMonitor->Start(AudioDevice);
+        return;
+    }
 
-    #undef SET_CVAR_FLOAT
+    if (!AudioRenderMonitor->IsMeasurementAvailable())
+    {
+        return;
+    }
+
+    PerformanceMetrics.AudioRenderTimeMs = AudioRenderMonitor->GetAverageRenderTimeMs();
+    PerformanceMetrics.AudioRenderPeakMs = AudioRenderMonitor->GetPeakRenderTimeMs();
+    PerformanceMetrics.AudioBufferPeriodMs = AudioRenderMonitor->GetBufferPeriodMs();
+
+    if (!CurrentSettings.Audio.bEnableAdaptiveVoiceBudget)
+    {
+        return;
+    }
 
-    // For Sound Classes or Audio Mixer:
-    // You would load your sound classes and set volumes here
-    // Example:
-    // if (USoundClass* MasterSoundClass = LoadObject<USoundClass>(nullptr, TEXT("/Game/Audio/MasterSoundClass")))
-    // {
-    //     UGameplayStatics::SetSoundClassVolume(this, MasterSoundClass, CurrentSettings.Audio.MasterVolume);
-    // }
+    // A buffer that is not rendered within its period is an audible glitch, so steer on the peak
+    const float RenderLoad = PerformanceMetrics.AudioRenderPeakMs / PerformanceMetrics.AudioBufferPeriodMs;
+    const int32 VoiceCap = UPMVoiceCapsByQuality[FMath::Clamp(CurrentSettings.Audio.AudioQuality, 0, 3)];
+
+    int32 NewVoiceLimit = AudioVoiceLimit;
+    if (RenderLoad > UPMHighAudioRenderLoad)
+    {
+        NewVoiceLimit = FMath::Max(UPMMinVoiceLimit, FMath::FloorToInt(AudioVoiceLimit * UPMVoiceLimitDropFactor));
+    }
+    else if (RenderLoad < UPMLowAudioRenderLoad)
+    {
+        NewVoiceLimit = FMath::Min(VoiceCap, AudioVoiceLimit + UPMVoiceLimitRiseStep);
+    }
+
+    if (NewVoiceLimit != AudioVoiceLimit)
+    {
+        UE_LOG(LogTemp, Log, TEXT("UPM: Audio voice limit %d -> %d (render peak %.2f ms of %.2f ms)"),
+            AudioVoiceLimit, NewVoiceLimit, PerformanceMetrics.AudioRenderPeakMs, PerformanceMetrics.AudioBufferPeriodMs);
+        AudioVoiceLimit = NewVoiceLimit;
+        AudioDevice->SetMaxChannels(AudioVoiceLimit);
+    }
+    PerformanceMetrics.AudioVoiceLimit = AudioVoiceLimit;
 }
 
 // ==================== Gameplay Settings (EXPANDED) ====================
@@ -667,91 +2272,98 @@ void UUPMSettingsManager::ApplyAudioSettings()
 void UUPMSettingsManager::SetGameplaySettings(const FUPMGameplaySettings& Settings)
 {
     CurrentSettings.Gameplay = Settings;
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetFOV(float FOV)
 {
     CurrentSettings.Gameplay.FOV = FMath::Clamp(FOV, 60.0f, 120.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetMouseSensitivity(float Sensitivity)
 {
     CurrentSettings.Gameplay.MouseSensitivity = FMath::Clamp(Sensitivity, 0.1f, 5.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetControllerSensitivity(float Sensitivity)
 {
     CurrentSettings.Gameplay.ControllerSensitivity = FMath::Clamp(Sensitivity, 0.1f, 5.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetControllerDeadZone(float DeadZone)
 {
     CurrentSettings.Gameplay.ControllerDeadZone = FMath::Clamp(DeadZone, 0.0f, 0.5f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetAimAssistStrength(float Strength)
 {
     CurrentSettings.Gameplay.AimAssistStrength = FMath::Clamp(Strength, 0.0f, 1.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetCameraShakeIntensity(float Intensity)
 {
     CurrentSettings.Gameplay.CameraShakeIntensity = FMath::Clamp(Intensity, 0.0f, 1.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetHeadBobIntensity(float Intensity)
 {
     CurrentSettings.Gameplay.HeadBobIntensity = FMath::Clamp(Intensity, 0.0f, 1.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetVibrationEnabled(bool bEnabled)
 {
     CurrentSettings.Gameplay.bEnableVibration = bEnabled;
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetCrouchToggle(bool bToggle)
 {
     CurrentSettings.Gameplay.bCrouchToggle = bToggle;
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetSprintToggle(bool bToggle)
 {
     CurrentSettings.Gameplay.bSprintToggle = bToggle;
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetAutoRunEnabled(bool bEnabled)
 {
     CurrentSettings.Gameplay.bEnableAutoRun = bEnabled;
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::SetCameraSmoothing(float Smoothing)
 {
     CurrentSettings.Gameplay.CameraSmoothing = FMath::Clamp(Smoothing, 0.0f, 1.0f);
-    ApplyGameplaySettings();
+    CommitSettings(EUPMSettingsCategory::Gameplay);
 }
 
 void UUPMSettingsManager::ApplyGameplaySettings()
 {
-    // Gameplay settings are typically applied through game-specific systems
-    // You would notify your game systems about changes here
+    // Cameras without a camera component of their own use the camera manager's default FOV
+    if (UWorld* World = CachedWorld.Get())
+    {
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+        {
+            APlayerController* PlayerController = It->Get();
+            if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+            {
+                PlayerController->PlayerCameraManager->DefaultFOV = CurrentSettings.Gameplay.FOV;
+            }
+        }
+    }
 
-    // This is where you would broadcast delegates or update game-specific components
-    // For example:
-    // - FOV: Applied to camera component
-    // - Mouse Sensitivity: Applied to player controller input
-    // - Controller settings: Applied to input system
+    // Sensitivity, inversion, controller and camera comfort settings are input/camera code of the game;
+    // it receives them through OnSettingsChanged (category Gameplay) and GetGameplaySettings()
 }
 
 // ==================== Accessibility Settings (NEW) ====================
@@ -759,49 +2371,49 @@ void UUPMSettingsManager::ApplyGameplaySettings()
 void UUPMSettingsManager::SetAccessibilitySettings(const FUPMAccessibilitySettings& Settings)
 {
     CurrentSettings.Accessibility = Settings;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetColorblindMode(EUPMColorblindMode Mode)
 {
     CurrentSettings.Accessibility.ColorblindMode = Mode;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetUIScale(float Scale)
 {
     CurrentSettings.Accessibility.UIScale = FMath::Clamp(Scale, 0.5f, 2.0f);
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetTextSize(float Size)
 {
     CurrentSettings.Accessibility.TextSize = FMath::Clamp(Size, 0.5f, 2.0f);
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetHighContrastMode(bool bEnabled)
 {
     CurrentSettings.Accessibility.bHighContrastMode = bEnabled;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetScreenReaderEnabled(bool bEnabled)
 {
     CurrentSettings.Accessibility.bEnableScreenReader = bEnabled;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetReducedMotion(bool bEnabled)
 {
     CurrentSettings.Accessibility.bReducedMotion = bEnabled;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::SetPhotosensitivityMode(bool bEnabled)
 {
     CurrentSettings.Accessibility.bPhotosensitivityMode = bEnabled;
-    ApplyAccessibilitySettings();
+    CommitSettings(EUPMSettingsCategory::Accessibility);
 }
 
 void UUPMSettingsManager::ApplyAccessibilitySettings()
@@ -844,43 +2456,48 @@ void UUPMSettingsManager::ApplyAccessibilitySettings()
 void UUPMSettingsManager::SetNetworkSettings(const FUPMNetworkSettings& Settings)
 {
     CurrentSettings.Network = Settings;
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::SetMaxPingThreshold(int32 MaxPing)
 {
     CurrentSettings.Network.MaxPingThreshold = FMath::Max(0, MaxPing);
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::SetNetworkSmoothing(float Smoothing)
 {
     CurrentSettings.Network.NetworkSmoothing = FMath::Clamp(Smoothing, 0.0f, 1.0f);
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::SetBandwidthLimit(int32 LimitKBps)
 {
     CurrentSettings.Network.BandwidthLimitKBps = FMath::Max(0, LimitKBps);
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::SetPreferredRegion(const FString& Region)
 {
     CurrentSettings.Network.PreferredRegion = Region;
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::SetCrossplayEnabled(bool bEnabled)
 {
     CurrentSettings.Network.bEnableCrossplay = bEnabled;
-    ApplyNetworkSettings();
+    CommitSettings(EUPMSettingsCategory::Network);
+}
+
+void UUPMSettingsManager::SetAdaptiveNetworkingEnabled(bool bEnabled)
+{
+    CurrentSettings.Network.bEnableAdaptiveNetworking = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Network);
 }
 
 void UUPMSettingsManager::ApplyNetworkSettings()
 {
-    // Network settings would be applied through your multiplayer/networking system
-    // These are typically game-specific and would require integration with your network manager
+    // Region and crossplay are game-specific and consumed by your matchmaking/session code
 
     #define SET_CVAR_FLOAT(Name, Value) \
         if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT(Name))) \
@@ -890,6 +2507,202 @@ void UUPMSettingsManager::ApplyNetworkSettings()
     SET_CVAR_FLOAT("p.NetClientInterpolation", CurrentSettings.Network.NetworkSmoothing);
 
     #undef SET_CVAR_FLOAT
+
+    // Governor disabled: hand everything back to the static settings
+    if (!CurrentSettings.Network.bEnableAdaptiveNetworking)
+    {
+        NetworkGovernorStates.Empty();
+    }
+
+    ApplyBandwidthLimit(CachedWorld.Get());
+}
+
+// Network governor tuning
+static const int32 UPMMinNetSpeed = 1800;              // Lowest rate the engine accepts for a connection
+static const float UPMHighPacketLossPercent = 2.0f;   // Back off above this
+static const float UPMLowPacketLossPercent = 0.5f;    // Recover below this
+static const float UPMFullPressurePacketLoss = 10.0f; // Loss at which smoothing/send rate are fully throttled
+
+FUPMNetworkGovernorState UUPMSettingsManager::GetNetworkGovernorState() const
+{
+    const FUPMNetworkGovernorState* State = NetworkGovernorStates.Find(CachedWorld.Get());
+    return State ? *State : FUPMNetworkGovernorState();
+}
+
+FUPMNetworkGovernorState& UUPMSettingsManager::FindOrAddNetworkGovernorState(UWorld* World)
+{
+    // Drop the state of worlds that were torn down (map travel, ended PIE sessions)
+    for (auto It = NetworkGovernorStates.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+    return NetworkGovernorStates.FindOrAdd(World);
+}
+
+int32 UUPMSettingsManager::GetMaxNetSpeed(UWorld* World) const
+{
+    if (CurrentSettings.Network.BandwidthLimitKBps > 0)
+    {
+        return FMath::Max(UPMMinNetSpeed, CurrentSettings.Network.BandwidthLimitKBps * 1024);
+    }
+    return GetDefault<ULocalPlayer>()->ConfiguredInternetSpeed;
+}
+
+void UUPMSettingsManager::ApplyBandwidthLimit(UWorld* World)
+{
+    UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+    if (!NetDriver)
+    {
+        return;
+    }
+
+    const int32 LimitBytesPerSecond = CurrentSettings.Network.BandwidthLimitKBps > 0
+        ? FMath::Max(UPMMinNetSpeed, CurrentSettings.Network.BandwidthLimitKBps * 1024)
+        : 0;
+
+    if (NetDriver->IsServer())
+    {
+        // Server: cap the rate granted to every client
+        const UNetDriver* DefaultDriver = NetDriver->GetClass()->GetDefaultObject<UNetDriver>();
+        NetDriver->MaxClientRate = LimitBytesPerSecond > 0 ? LimitBytesPerSecond : DefaultDriver->MaxClientRate;
+        NetDriver->MaxInternetClientRate = LimitBytesPerSecond > 0 ? LimitBytesPerSecond : DefaultDriver->MaxInternetClientRate;
+
+        // Connections negotiated their speed on login, clamp them to the new cap
+        if (LimitBytesPerSecond > 0)
+        {
+            for (UNetConnection* Connection : NetDriver->ClientConnections)
+            {
+                if (Connection)
+                {
+                    Connection->CurrentNetSpeed = FMath::Min(Connection->CurrentNetSpeed, LimitBytesPerSecond);
+                }
+            }
+        }
+        return;
+    }
+
+    // Client: configured speed is used for future connections, the governor's speed updates the live one
+    const int32 MaxNetSpeed = GetMaxNetSpeed(World);
+    if (APlayerController* LocalController = GEngine ? GEngine->GetFirstLocalPlayerController(World) : nullptr)
+    {
+        if (ULocalPlayer* LocalPlayer = LocalController->GetLocalPlayer())
+        {
+            LocalPlayer->ConfiguredInternetSpeed = MaxNetSpeed;
+            LocalPlayer->ConfiguredLanSpeed = MaxNetSpeed;
+        }
+    }
+
+    const FUPMNetworkGovernorState* State = NetworkGovernorStates.Find(World);
+    const int32 NetSpeed = State && State->NetSpeed > 0 ? FMath::Min(State->NetSpeed, MaxNetSpeed) : MaxNetSpeed;
+    SetClientNetSpeed(World, NetSpeed);
+}
+
+void UUPMSettingsManager::SetClientNetSpeed(UWorld* World, int32 NetSpeed)
+{
+    if (!World || World->GetNetMode() != NM_Client || !GEngine)
+    {
+        return;
+    }
+
+    UNetDriver* NetDriver = World->GetNetDriver();
+    UNetConnection* ServerConnection = NetDriver ? NetDriver->ServerConnection : nullptr;
+    if (!ServerConnection)
+    {
+        return;
+    }
+
+    // Same clamp as the 'netspeed' command, without its config save: a temporary throttle must not outlive
+    // the session. The local connection limits what we send, the control message what the server sends us.
+    int32 Rate = FMath::Clamp(NetSpeed, UPMMinNetSpeed, FMath::Max(UPMMinNetSpeed, NetDriver->MaxClientRate));
+    ServerConnection->CurrentNetSpeed = Rate;
+    if (APlayerController* LocalController = GEngine->GetFirstLocalPlayerController(World))
+    {
+        if (LocalController->Player)
+        {
+            LocalController->Player->CurrentNetSpeed = Rate;
+        }
+    }
+    FNetControlMessage<NMT_Netspeed>::Send(ServerConnection, Rate);
+
+    NetworkGovernorStates.FindOrAdd(World).NetSpeed = Rate;
+}
+
+void UUPMSettingsManager::UpdateNetworkGovernor(UWorld* World)
+{
+    const FUPMNetworkSettings& Network = CurrentSettings.Network;
+    const int32 MaxNetSpeed = GetMaxNetSpeed(World);
+    const float Ping = PerformanceMetrics.NetworkPing;
+    const float Loss = PerformanceMetrics.PacketLoss;
+
+    const bool bHighPing = Network.MaxPingThreshold > 0 && Ping > Network.MaxPingThreshold;
+    const bool bLossy = Loss > UPMHighPacketLossPercent;
+    FUPMNetworkGovernorState& State = FindOrAddNetworkGovernorState(World);
+    State.bThrottled = bHighPing || bLossy;
+
+    // Loss usually means congestion: back off multiplicatively, recover additively
+    const int32 CurrentNetSpeed = State.NetSpeed > 0 ? State.NetSpeed : MaxNetSpeed;
+    int32 NewNetSpeed = CurrentNetSpeed;
+    if (bLossy)
+    {
+        NewNetSpeed = FMath::RoundToInt(CurrentNetSpeed * 0.75f);
+    }
+    else if (Loss < UPMLowPacketLossPercent)
+    {
+        NewNetSpeed = CurrentNetSpeed + MaxNetSpeed / 10;
+    }
+    NewNetSpeed = FMath::Clamp(NewNetSpeed, UPMMinNetSpeed, MaxNetSpeed);
+
+    if (NewNetSpeed != State.NetSpeed)
+    {
+        SetClientNetSpeed(World, NewNetSpeed);
+    }
+
+    // 0 = healthy connection, 1 = ping/loss far beyond acceptable
+    const float PingPressure = Network.MaxPingThreshold > 0
+        ? FMath::Clamp((Ping - Network.MaxPingThreshold) / Network.MaxPingThreshold, 0.0f, 1.0f)
+        : 0.0f;
+    const float LossPressure = FMath::Clamp((Loss - UPMLowPacketLossPercent) / (UPMFullPressurePacketLoss - UPMLowPacketLossPercent), 0.0f, 1.0f);
+    const float Pressure = FMath::Max(PingPressure, LossPressure);
+
+    // More interpolation hides jitter at the cost of extra visual latency
+    State.Interpolation = FMath::Lerp(Network.NetworkSmoothing, 1.0f, Pressure);
+    if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("p.NetClientInterpolation")))
+    {
+        CVar->Set(State.Interpolation);
+    }
+
+    // Character movement throttles its move send rate from the player's net speed, so lowering the speed
+    // above already slows it down; the network manager defaults are shared by every world and stay untouched
+    const AGameNetworkManager* NetworkManagerDefaults = GetDefault<AGameNetworkManager>();
+    const int32 AppliedNetSpeed = FMath::Max(UPMMinNetSpeed, State.NetSpeed > 0 ? State.NetSpeed : MaxNetSpeed);
+    State.ClientSendMoveDeltaTime = AppliedNetSpeed > NetworkManagerDefaults->ClientNetSendMoveThrottleAtNetSpeed
+        ? NetworkManagerDefaults->ClientNetSendMoveDeltaTime
+        : FMath::Max(NetworkManagerDefaults->ClientNetSendMoveDeltaTimeThrottled, 2.0f * NetworkManagerDefaults->MoveRepSize / AppliedNetSpeed);
+}
+
+bool UUPMSettingsManager::SetPacketSimulation(const UObject* WorldContextObject, int32 LagMs, int32 LossPercent)
+{
+#if DO_ENABLE_NET_TEST
+    UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+    if (!NetDriver)
+    {
+        return false;
+    }
+
+    FPacketSimulationSettings SimulationSettings;
+    SimulationSettings.PktLag = FMath::Max(0, LagMs);
+    SimulationSettings.PktLoss = FMath::Clamp(LossPercent, 0, 100);
+    NetDriver->SetPacketSimulationSettings(SimulationSettings);
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Packet simulation set to PktLag=%d PktLoss=%d"), SimulationSettings.PktLag, SimulationSettings.PktLoss);
+    return true;
+#else
+    return false;
+#endif
 }
 
 // ==================== Debug Settings (NEW) ====================
@@ -897,37 +2710,72 @@ void UUPMSettingsManager::ApplyNetworkSettings()
 void UUPMSettingsManager::SetDebugSettings(const FUPMDebugSettings& Settings)
 {
     CurrentSettings.Debug = Settings;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
 }
 
 void UUPMSettingsManager::SetPerformanceOverlayVisible(bool bVisible)
 {
     CurrentSettings.Debug.bShowPerformanceOverlay = bVisible;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
 }
 
 void UUPMSettingsManager::SetNetworkStatsVisible(bool bVisible)
 {
     CurrentSettings.Debug.bShowNetworkStats = bVisible;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
 }
 
 void UUPMSettingsManager::SetDeveloperMode(bool bEnabled)
 {
     CurrentSettings.Debug.bDeveloperMode = bEnabled;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
 }
 
 void UUPMSettingsManager::SetCrashReportingEnabled(bool bEnabled)
 {
     CurrentSettings.Debug.bEnableCrashReporting = bEnabled;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
 }
 
 void UUPMSettingsManager::SetBenchmarkMode(bool bEnabled)
 {
     CurrentSettings.Debug.bBenchmarkMode = bEnabled;
-    ApplyDebugSettings();
+    CommitSettings(EUPMSettingsCategory::Debug);
+}
+
+void UUPMSettingsManager::SetTickProfilerEnabled(bool bEnabled)
+{
+    CurrentSettings.Debug.bEnableTickProfiler = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Debug);
+}
+
+void UUPMSettingsManager::SetTextureStreamingStatsEnabled(bool bEnabled)
+{
+    CurrentSettings.Debug.bEnableTextureStreamingStats = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Debug);
+}
+
+bool UUPMSettingsManager::DumpTickProfilerReport()
+{
+#if UPM_WITH_TICK_PROFILER
+    if (!FUPMTickProfiler::IsEnabled())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UPM: Tick profiler is not enabled"));
+        return false;
+    }
+
+    FUPMTickProfiler::Get().DumpReport(*GLog);
+
+    const FString ReportPath = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("TickReport.csv");
+    const bool bSaved = FUPMTickProfiler::Get().WriteReport(ReportPath);
+    if (bSaved)
+    {
+        UE_LOG(LogTemp, Log, TEXT("UPM: Tick report written to %s"), *ReportPath);
+    }
+    return bSaved;
+#else
+    return false;
+#endif
 }
 
 void UUPMSettingsManager::ApplyDebugSettings()
@@ -951,16 +2799,168 @@ void UUPMSettingsManager::ApplyDebugSettings()
             CVarVSync->Set(0);
         }
     }
+
+#if UPM_WITH_TICK_PROFILER
+    FUPMTickProfiler::Get().SetEnabled(CurrentSettings.Debug.bEnableTickProfiler);
+    if (!CurrentSettings.Debug.bEnableTickProfiler)
+    {
+        PerformanceMetrics.TopTickCosts.Reset();
+    }
+#endif
+}
+
+// ==================== Server Settings (NEW) ====================
+
+void UUPMSettingsManager::SetServerSettings(const FUPMServerSettings& Settings)
+{
+    CurrentSettings.Server = Settings;
+    CommitSettings(EUPMSettingsCategory::Server);
+}
+
+void UUPMSettingsManager::SetServerTickRateGovernorEnabled(bool bEnabled)
+{
+    CurrentSettings.Server.bEnableTickRateGovernor = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Server);
+}
+
+void UUPMSettingsManager::SetServerTickRateRange(int32 MinTickRate, int32 MaxTickRate)
+{
+    CurrentSettings.Server.MinServerTickRate = FMath::Clamp(MinTickRate, 1, 240);
+    CurrentSettings.Server.MaxServerTickRate = FMath::Clamp(MaxTickRate, CurrentSettings.Server.MinServerTickRate, 240);
+    CommitSettings(EUPMSettingsCategory::Server);
+}
+
+void UUPMSettingsManager::SetAdaptNetCullDistance(bool bEnabled)
+{
+    CurrentSettings.Server.bAdaptNetCullDistance = bEnabled;
+    CommitSettings(EUPMSettingsCategory::Server);
+}
+
+TArray<FUPMReplicationClassCost> UUPMSettingsManager::GetReplicationClassCosts() const
+{
+    if (ServerProfiler.IsValid())
+    {
+        return ServerProfiler->GetReplicationClassCosts();
+    }
+    return TArray<FUPMReplicationClassCost>();
+}
+
+void UUPMSettingsManager::ApplyServerSettings()
+{
+    UWorld* World = CachedWorld.Get();
+    const ENetMode NetMode = World ? World->GetNetMode() : NM_Standalone;
+    if (NetMode != NM_DedicatedServer && NetMode != NM_ListenServer)
+    {
+        return;
+    }
+
+    if (!ServerProfiler.IsValid())
+    {
+        ServerProfiler = MakeShared<FUPMServerProfiler>();
+
+        // Nothing else drives the metrics on a headless server
+        if (IsRunningDedicatedServer())
+        {
+            ServerProfiler->OnFrameProfiled.AddUObject(this, &UUPMSettingsManager::UpdatePerformanceMetrics);
+        }
+    }
+
+    ServerProfiler->SetSettings(CurrentSettings.Server);
+    ServerProfiler->Start(World);
+}
+
+void UUPMSettingsManager::UpdateServerMetrics()
+{
+    // Listen servers usually start listening after the manager was created
+    if (!ServerProfiler.IsValid() || !ServerProfiler->IsRunning())
+    {
+        UWorld* World = CachedWorld.Get();
+        if (!World || World->GetNetMode() != NM_ListenServer)
+        {
+            return;
+        }
+        ApplyServerSettings();
+    }
+
+    PerformanceMetrics.ServerTickTimeMs = ServerProfiler->GetTickTimeMs();
+    PerformanceMetrics.ServerNetTimeMs = ServerProfiler->GetNetTimeMs();
+    PerformanceMetrics.ServerTickRate = ServerProfiler->GetTickRate();
+    PerformanceMetrics.PlayerCount = ServerProfiler->GetPlayerCount();
 }
 
 // ==================== Persistence (EXPANDED) ====================
 
 FString UUPMSettingsManager::GetSettingsFilePath() const
 {
+    if (!SettingsFilePathOverride.IsEmpty())
+    {
+        return SettingsFilePathOverride;
+    }
     return FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("Settings.json");
 }
 
 bool UUPMSettingsManager::SaveSettings()
+{
+    return SaveSettingsToFile(GetSettingsFilePath());
+}
+
+bool UUPMSettingsManager::LoadSettings()
+{
+    return LoadSettingsFromFile(GetSettingsFilePath());
+}
+
+static FString UPMGetProfileDirectory()
+{
+    return FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("Profiles");
+}
+
+FString UUPMSettingsManager::GetProfileFilePath(const FString& ProfileName)
+{
+    return UPMGetProfileDirectory() / (FPaths::MakeValidFileName(ProfileName) + TEXT(".json"));
+}
+
+bool UUPMSettingsManager::SaveProfile(const FString& ProfileName)
+{
+    return !ProfileName.IsEmpty() && SaveSettingsToFile(GetProfileFilePath(ProfileName));
+}
+
+bool UUPMSettingsManager::ReadProfile(const FString& ProfileName, FUPMCompleteSettings& OutSettings)
+{
+    // Loading goes through CurrentSettings, which is restored so nothing changes before the commit
+    const FUPMCompleteSettings PreviousSettings = CurrentSettings;
+    const bool bLoaded = !ProfileName.IsEmpty() && LoadSettingsFromFile(GetProfileFilePath(ProfileName));
+    OutSettings = CurrentSettings;
+    CurrentSettings = PreviousSettings;
+    return bLoaded;
+}
+
+bool UUPMSettingsManager::LoadProfile(const FString& ProfileName)
+{
+    FUPMCompleteSettings Settings;
+    if (!ReadProfile(ProfileName, Settings))
+    {
+        return false;
+    }
+
+    SetAllSettings(Settings);
+    return true;
+}
+
+TArray<FString> UUPMSettingsManager::GetProfileNames() const
+{
+    TArray<FString> ProfileFiles;
+    IFileManager::Get().FindFiles(ProfileFiles, *UPMGetProfileDirectory(), TEXT("json"));
+
+    TArray<FString> ProfileNames;
+    for (const FString& ProfileFile : ProfileFiles)
+    {
+        ProfileNames.Add(FPaths::GetBaseFilename(ProfileFile));
+    }
+    ProfileNames.Sort();
+    return ProfileNames;
+}
+
+bool UUPMSettingsManager::SaveSettingsToFile(const FString& FilePath)
 {
     TSharedPtr<FJsonObject> JsonObject = SettingsToJson();
     if (!JsonObject.IsValid())
@@ -977,7 +2977,6 @@ bool UUPMSettingsManager::SaveSettings()
         return false;
     }
 
-    FString FilePath = GetSettingsFilePath();
     FString DirectoryPath = FPaths::GetPath(FilePath);
 
     IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -1000,10 +2999,8 @@ bool UUPMSettingsManager::SaveSettings()
     return true;
 }
 
-bool UUPMSettingsManager::LoadSettings()
+bool UUPMSettingsManager::LoadSettingsFromFile(const FString& FilePath)
 {
-    FString FilePath = GetSettingsFilePath();
-
     if (!FPaths::FileExists(FilePath))
     {
         UE_LOG(LogTemp, Warning, TEXT("UPM: Settings file not found: %s (using defaults)"), *FilePath);
@@ -1073,6 +3070,7 @@ TSharedPtr<FJsonObject> UUPMSettingsManager::SettingsToJson() const
     JSON_SET_FIELD(RenderingObject, AnisotropicFiltering, CurrentSettings.Rendering.AnisotropicFiltering);
     JSON_SET_BOOL(RenderingObject, EnableTAA, CurrentSettings.Rendering.bEnableTAA);
     RenderingObject->SetNumberField("UpscalingMode", static_cast<int32>(CurrentSettings.Rendering.UpscalingMode));
+    RenderingObject->SetNumberField("UpscalingQuality", static_cast<int32>(CurrentSettings.Rendering.UpscalingQuality));
     JSON_SET_FIELD(RenderingObject, GlobalIlluminationQuality, CurrentSettings.Rendering.GlobalIlluminationQuality);
     JSON_SET_FIELD(RenderingObject, ReflectionQuality, CurrentSettings.Rendering.ReflectionQuality);
     JSON_SET_BOOL(RenderingObject, EnableSSGI, CurrentSettings.Rendering.bEnableSSGI);
@@ -1083,12 +3081,31 @@ TSharedPtr<FJsonObject> UUPMSettingsManager::SettingsToJson() const
     TSharedPtr<FJsonObject> PerformanceObject = MakeShareable(new FJsonObject);
     JSON_SET_BOOL(PerformanceObject, EnableVSync, CurrentSettings.Performance.bEnableVSync);
     JSON_SET_FIELD(PerformanceObject, FrameRateLimit, CurrentSettings.Performance.FrameRateLimit);
+    JSON_SET_BOOL(PerformanceObject, AutoFrameRateTarget, CurrentSettings.Performance.bAutoFrameRateTarget);
+    JSON_SET_BOOL(PerformanceObject, VariableRefreshRate, CurrentSettings.Performance.bVariableRefreshRate);
+    JSON_SET_BOOL(PerformanceObject, EnableEcoMode, CurrentSettings.Performance.bEnableEcoMode);
+    JSON_SET_FIELD(PerformanceObject, UnfocusedFrameRateLimit, CurrentSettings.Performance.UnfocusedFrameRateLimit);
+    JSON_SET_FIELD(PerformanceObject, MinimizedFrameRateLimit, CurrentSettings.Performance.MinimizedFrameRateLimit);
+    JSON_SET_FIELD(PerformanceObject, MenuFrameRateLimit, CurrentSettings.Performance.MenuFrameRateLimit);
+    JSON_SET_FIELD(PerformanceObject, IdleFrameRateLimit, CurrentSettings.Performance.IdleFrameRateLimit);
+    JSON_SET_FIELD(PerformanceObject, IdleTimeoutSeconds, CurrentSettings.Performance.IdleTimeoutSeconds);
+    JSON_SET_BOOL(PerformanceObject, SuspendRenderingWhenMinimized, CurrentSettings.Performance.bSuspendRenderingWhenMinimized);
+    JSON_SET_BOOL(PerformanceObject, EnableStreamingGovernor, CurrentSettings.Performance.bEnableStreamingGovernor);
+    JSON_SET_FIELD(PerformanceObject, StreamingBudgetMs, CurrentSettings.Performance.StreamingBudgetMs);
+    JSON_SET_FIELD(PerformanceObject, LoadingScreenAsyncLoadingTimeMs, CurrentSettings.Performance.LoadingScreenAsyncLoadingTimeMs);
+    JSON_SET_BOOL(PerformanceObject, EnableEffectsBudget, CurrentSettings.Performance.bEnableEffectsBudget);
+    JSON_SET_FIELD(PerformanceObject, EffectsBudgetMs, CurrentSettings.Performance.EffectsBudgetMs);
     JSON_SET_BOOL(PerformanceObject, EnableDynamicResolution, CurrentSettings.Performance.bEnableDynamicResolution);
     JSON_SET_FIELD(PerformanceObject, MinFrameRateForDynamicRes, CurrentSettings.Performance.MinFrameRateForDynamicRes);
     JSON_SET_BOOL(PerformanceObject, EnableTripleBuffering, CurrentSettings.Performance.bEnableTripleBuffering);
     JSON_SET_BOOL(PerformanceObject, EnableAsyncCompute, CurrentSettings.Performance.bEnableAsyncCompute);
     JSON_SET_FIELD(PerformanceObject, LODDistanceMultiplier, CurrentSettings.Performance.LODDistanceMultiplier);
     JSON_SET_FIELD(PerformanceObject, ProcessPriority, CurrentSettings.Performance.ProcessPriority);
+    JSON_SET_BOOL(PerformanceObject, EnableTickBudget, CurrentSettings.Performance.bEnableTickBudget);
+    JSON_SET_FIELD(PerformanceObject, TickBudgetFraction, CurrentSettings.Performance.TickBudgetFraction);
+    JSON_SET_FIELD(PerformanceObject, MaxThrottledTickInterval, CurrentSettings.Performance.MaxThrottledTickInterval);
+    JSON_SET_FIELD(PerformanceObject, SignificanceDistance, CurrentSettings.Performance.SignificanceDistance);
+    JSON_SET_BOOL(PerformanceObject, AllowTickDisable, CurrentSettings.Performance.bAllowTickDisable);
     RootObject->SetObjectField("Performance", PerformanceObject);
 
     // Display (EXPANDED)
@@ -1120,6 +3137,7 @@ TSharedPtr<FJsonObject> UUPMSettingsManager::SettingsToJson() const
     JSON_SET_FIELD(AudioObject, AudioQuality, CurrentSettings.Audio.AudioQuality);
     JSON_SET_FIELD(AudioObject, SurroundSoundMode, CurrentSettings.Audio.SurroundSoundMode);
     JSON_SET_BOOL(AudioObject, EnableSpatialAudio, CurrentSettings.Audio.bEnableSpatialAudio);
+    JSON_SET_BOOL(AudioObject, EnableAdaptiveVoiceBudget, CurrentSettings.Audio.bEnableAdaptiveVoiceBudget);
     JSON_SET_FIELD(AudioObject, DynamicRange, CurrentSettings.Audio.DynamicRange);
     JSON_SET_FIELD(AudioObject, SubtitleTextSize, CurrentSettings.Audio.SubtitleTextSize);
     JSON_SET_FIELD(AudioObject, SubtitleBackgroundOpacity, CurrentSettings.Audio.SubtitleBackgroundOpacity);
@@ -1160,6 +3178,7 @@ TSharedPtr<FJsonObject> UUPMSettingsManager::SettingsToJson() const
     JSON_SET_FIELD(NetworkObject, BandwidthLimitKBps, CurrentSettings.Network.BandwidthLimitKBps);
     JSON_SET_STRING(NetworkObject, PreferredRegion, CurrentSettings.Network.PreferredRegion);
     JSON_SET_BOOL(NetworkObject, EnableCrossplay, CurrentSettings.Network.bEnableCrossplay);
+    JSON_SET_BOOL(NetworkObject, EnableAdaptiveNetworking, CurrentSettings.Network.bEnableAdaptiveNetworking);
     RootObject->SetObjectField("Network", NetworkObject);
 
     // NEW: Debug
@@ -1169,8 +3188,20 @@ TSharedPtr<FJsonObject> UUPMSettingsManager::SettingsToJson() const
     JSON_SET_BOOL(DebugObject, DeveloperMode, CurrentSettings.Debug.bDeveloperMode);
     JSON_SET_BOOL(DebugObject, EnableCrashReporting, CurrentSettings.Debug.bEnableCrashReporting);
     JSON_SET_BOOL(DebugObject, BenchmarkMode, CurrentSettings.Debug.bBenchmarkMode);
+    JSON_SET_BOOL(DebugObject, EnableTickProfiler, CurrentSettings.Debug.bEnableTickProfiler);
+    JSON_SET_BOOL(DebugObject, EnableTextureStreamingStats, CurrentSettings.Debug.bEnableTextureStreamingStats);
     RootObject->SetObjectField("Debug", DebugObject);
 
+    // NEW: Server
+    TSharedPtr<FJsonObject> ServerObject = MakeShareable(new FJsonObject);
+    JSON_SET_BOOL(ServerObject, EnableTickRateGovernor, CurrentSettings.Server.bEnableTickRateGovernor);
+    JSON_SET_FIELD(ServerObject, MinServerTickRate, CurrentSettings.Server.MinServerTickRate);
+    JSON_SET_FIELD(ServerObject, MaxServerTickRate, CurrentSettings.Server.MaxServerTickRate);
+    JSON_SET_FIELD(ServerObject, TickBudgetFraction, CurrentSettings.Server.TickBudgetFraction);
+    JSON_SET_BOOL(ServerObject, AdaptNetCullDistance, CurrentSettings.Server.bAdaptNetCullDistance);
+    JSON_SET_FIELD(ServerObject, MinNetCullDistanceScale, CurrentSettings.Server.MinNetCullDistanceScale);
+    RootObject->SetObjectField("Server", ServerObject);
+
     return RootObject;
 }
 
@@ -1181,161 +3212,222 @@ bool UUPMSettingsManager::JsonToSettings(TSharedPtr<FJsonObject> JsonObject)
         return false;
     }
 
+    // Fields missing from the file keep their current values
+    FUPMCompleteSettings Loaded = CurrentSettings;
+
     // Graphics
     const TSharedPtr<FJsonObject>* GraphicsObject;
     if (JsonObject->TryGetObjectField("Graphics", GraphicsObject))
     {
-        (*GraphicsObject)->TryGetNumberField("AntiAliasingQuality", CurrentSettings.Graphics.AntiAliasingQuality);
-        (*GraphicsObject)->TryGetNumberField("ShadowQuality", CurrentSettings.Graphics.ShadowQuality);
-        (*GraphicsObject)->TryGetNumberField("ViewDistanceQuality", CurrentSettings.Graphics.ViewDistanceQuality);
-        (*GraphicsObject)->TryGetNumberField("PostProcessQuality", CurrentSettings.Graphics.PostProcessQuality);
-        (*GraphicsObject)->TryGetNumberField("TextureQuality", CurrentSettings.Graphics.TextureQuality);
-        (*GraphicsObject)->TryGetNumberField("EffectsQuality", CurrentSettings.Graphics.EffectsQuality);
-        (*GraphicsObject)->TryGetNumberField("FoliageQuality", CurrentSettings.Graphics.FoliageQuality);
-        (*GraphicsObject)->TryGetNumberField("ShadingQuality", CurrentSettings.Graphics.ShadingQuality);
+        (*GraphicsObject)->TryGetNumberField("AntiAliasingQuality", Loaded.Graphics.AntiAliasingQuality);
+        (*GraphicsObject)->TryGetNumberField("ShadowQuality", Loaded.Graphics.ShadowQuality);
+        (*GraphicsObject)->TryGetNumberField("ViewDistanceQuality", Loaded.Graphics.ViewDistanceQuality);
+        (*GraphicsObject)->TryGetNumberField("PostProcessQuality", Loaded.Graphics.PostProcessQuality);
+        (*GraphicsObject)->TryGetNumberField("TextureQuality", Loaded.Graphics.TextureQuality);
+        (*GraphicsObject)->TryGetNumberField("EffectsQuality", Loaded.Graphics.EffectsQuality);
+        (*GraphicsObject)->TryGetNumberField("FoliageQuality", Loaded.Graphics.FoliageQuality);
+        (*GraphicsObject)->TryGetNumberField("ShadingQuality", Loaded.Graphics.ShadingQuality);
     }
 
     // Rendering (EXPANDED)
     const TSharedPtr<FJsonObject>* RenderingObject;
     if (JsonObject->TryGetObjectField("Rendering", RenderingObject))
     {
-        (*RenderingObject)->TryGetBoolField("EnableLumen", CurrentSettings.Rendering.bEnableLumen);
-        (*RenderingObject)->TryGetBoolField("EnableRayTracing", CurrentSettings.Rendering.bEnableRayTracing);
-        (*RenderingObject)->TryGetBoolField("EnableSSAO", CurrentSettings.Rendering.bEnableSSAO);
-        (*RenderingObject)->TryGetBoolField("EnableSSR", CurrentSettings.Rendering.bEnableSSR);
-        (*RenderingObject)->TryGetBoolField("EnableMotionBlur", CurrentSettings.Rendering.bEnableMotionBlur);
-        (*RenderingObject)->TryGetBoolField("EnableBloom", CurrentSettings.Rendering.bEnableBloom);
-        (*RenderingObject)->TryGetBoolField("EnableDepthOfField", CurrentSettings.Rendering.bEnableDepthOfField);
-        (*RenderingObject)->TryGetBoolField("EnableLensFlares", CurrentSettings.Rendering.bEnableLensFlares);
-        (*RenderingObject)->TryGetBoolField("EnableChromaticAberration", CurrentSettings.Rendering.bEnableChromaticAberration);
-        (*RenderingObject)->TryGetBoolField("EnableFilmGrain", CurrentSettings.Rendering.bEnableFilmGrain);
-        (*RenderingObject)->TryGetBoolField("EnableVignette", CurrentSettings.Rendering.bEnableVignette);
-        (*RenderingObject)->TryGetBoolField("EnableVolumetricFog", CurrentSettings.Rendering.bEnableVolumetricFog);
-        (*RenderingObject)->TryGetNumberField("AnisotropicFiltering", CurrentSettings.Rendering.AnisotropicFiltering);
-        (*RenderingObject)->TryGetBoolField("EnableTAA", CurrentSettings.Rendering.bEnableTAA);
-        int32 UpscalingInt = 0;
+        (*RenderingObject)->TryGetBoolField("EnableLumen", Loaded.Rendering.bEnableLumen);
+        (*RenderingObject)->TryGetBoolField("EnableRayTracing", Loaded.Rendering.bEnableRayTracing);
+        (*RenderingObject)->TryGetBoolField("EnableSSAO", Loaded.Rendering.bEnableSSAO);
+        (*RenderingObject)->TryGetBoolField("EnableSSR", Loaded.Rendering.bEnableSSR);
+        (*RenderingObject)->TryGetBoolField("EnableMotionBlur", Loaded.Rendering.bEnableMotionBlur);
+        (*RenderingObject)->TryGetBoolField("EnableBloom", Loaded.Rendering.bEnableBloom);
+        (*RenderingObject)->TryGetBoolField("EnableDepthOfField", Loaded.Rendering.bEnableDepthOfField);
+        (*RenderingObject)->TryGetBoolField("EnableLensFlares", Loaded.Rendering.bEnableLensFlares);
+        (*RenderingObject)->TryGetBoolField("EnableChromaticAberration", Loaded.Rendering.bEnableChromaticAberration);
+        (*RenderingObject)->TryGetBoolField("EnableFilmGrain", Loaded.Rendering.bEnableFilmGrain);
+        (*RenderingObject)->TryGetBoolField("EnableVignette", Loaded.Rendering.bEnableVignette);
+        (*RenderingObject)->TryGetBoolField("EnableVolumetricFog", Loaded.Rendering.bEnableVolumetricFog);
+        (*RenderingObject)->TryGetNumberField("AnisotropicFiltering", Loaded.Rendering.AnisotropicFiltering);
+        (*RenderingObject)->TryGetBoolField("EnableTAA", Loaded.Rendering.bEnableTAA);
+        int32 UpscalingInt = static_cast<int32>(Loaded.Rendering.UpscalingMode);
         (*RenderingObject)->TryGetNumberField("UpscalingMode", UpscalingInt);
-        CurrentSettings.Rendering.UpscalingMode = static_cast<EUPMUpscalingMode>(UpscalingInt);
-        (*RenderingObject)->TryGetNumberField("GlobalIlluminationQuality", CurrentSettings.Rendering.GlobalIlluminationQuality);
-        (*RenderingObject)->TryGetNumberField("ReflectionQuality", CurrentSettings.Rendering.ReflectionQuality);
-        (*RenderingObject)->TryGetBoolField("EnableSSGI", CurrentSettings.Rendering.bEnableSSGI);
-        (*RenderingObject)->TryGetBoolField("EnableContactShadows", CurrentSettings.Rendering.bEnableContactShadows);
+        Loaded.Rendering.UpscalingMode = static_cast<EUPMUpscalingMode>(UpscalingInt);
+        int32 UpscalingQualityInt = static_cast<int32>(Loaded.Rendering.UpscalingQuality);
+        (*RenderingObject)->TryGetNumberField("UpscalingQuality", UpscalingQualityInt);
+        Loaded.Rendering.UpscalingQuality = static_cast<EUPMUpscalingQuality>(UpscalingQualityInt);
+        (*RenderingObject)->TryGetNumberField("GlobalIlluminationQuality", Loaded.Rendering.GlobalIlluminationQuality);
+        (*RenderingObject)->TryGetNumberField("ReflectionQuality", Loaded.Rendering.ReflectionQuality);
+        (*RenderingObject)->TryGetBoolField("EnableSSGI", Loaded.Rendering.bEnableSSGI);
+        (*RenderingObject)->TryGetBoolField("EnableContactShadows", Loaded.Rendering.bEnableContactShadows);
     }
 
     // Performance (EXPANDED)
     const TSharedPtr<FJsonObject>* PerformanceObject;
     if (JsonObject->TryGetObjectField("Performance", PerformanceObject))
     {
-        (*PerformanceObject)->TryGetBoolField("EnableVSync", CurrentSettings.Performance.bEnableVSync);
-        (*PerformanceObject)->TryGetNumberField("FrameRateLimit", CurrentSettings.Performance.FrameRateLimit);
-        (*PerformanceObject)->TryGetBoolField("EnableDynamicResolution", CurrentSettings.Performance.bEnableDynamicResolution);
-        (*PerformanceObject)->TryGetNumberField("MinFrameRateForDynamicRes", CurrentSettings.Performance.MinFrameRateForDynamicRes);
-        (*PerformanceObject)->TryGetBoolField("EnableTripleBuffering", CurrentSettings.Performance.bEnableTripleBuffering);
-        (*PerformanceObject)->TryGetBoolField("EnableAsyncCompute", CurrentSettings.Performance.bEnableAsyncCompute);
-        (*PerformanceObject)->TryGetNumberField("LODDistanceMultiplier", CurrentSettings.Performance.LODDistanceMultiplier);
-        (*PerformanceObject)->TryGetNumberField("ProcessPriority", CurrentSettings.Performance.ProcessPriority);
+        (*PerformanceObject)->TryGetBoolField("EnableVSync", Loaded.Performance.bEnableVSync);
+        (*PerformanceObject)->TryGetNumberField("FrameRateLimit", Loaded.Performance.FrameRateLimit);
+        (*PerformanceObject)->TryGetBoolField("AutoFrameRateTarget", Loaded.Performance.bAutoFrameRateTarget);
+        (*PerformanceObject)->TryGetBoolField("VariableRefreshRate", Loaded.Performance.bVariableRefreshRate);
+        (*PerformanceObject)->TryGetBoolField("EnableEcoMode", Loaded.Performance.bEnableEcoMode);
+        (*PerformanceObject)->TryGetNumberField("UnfocusedFrameRateLimit", Loaded.Performance.UnfocusedFrameRateLimit);
+        (*PerformanceObject)->TryGetNumberField("MinimizedFrameRateLimit", Loaded.Performance.MinimizedFrameRateLimit);
+        (*PerformanceObject)->TryGetNumberField("MenuFrameRateLimit", Loaded.Performance.MenuFrameRateLimit);
+        (*PerformanceObject)->TryGetNumberField("IdleFrameRateLimit", Loaded.Performance.IdleFrameRateLimit);
+        (*PerformanceObject)->TryGetNumberField("IdleTimeoutSeconds", Loaded.Performance.IdleTimeoutSeconds);
+        (*PerformanceObject)->TryGetBoolField("SuspendRenderingWhenMinimized", Loaded.Performance.bSuspendRenderingWhenMinimized);
+        (*PerformanceObject)->TryGetBoolField("EnableStreamingGovernor", Loaded.Performance.bEnableStreamingGovernor);
+        (*PerformanceObject)->TryGetNumberField("StreamingBudgetMs", Loaded.Performance.StreamingBudgetMs);
+        (*PerformanceObject)->TryGetNumberField("LoadingScreenAsyncLoadingTimeMs", Loaded.Performance.LoadingScreenAsyncLoadingTimeMs);
+        (*PerformanceObject)->TryGetBoolField("EnableEffectsBudget", Loaded.Performance.bEnableEffectsBudget);
+        (*PerformanceObject)->TryGetNumberField("EffectsBudgetMs", Loaded.Performance.EffectsBudgetMs);
+        (*PerformanceObject)->TryGetBoolField("EnableDynamicResolution", Loaded.Performance.bEnableDynamicResolution);
+        (*PerformanceObject)->TryGetNumberField("MinFrameRateForDynamicRes", Loaded.Performance.MinFrameRateForDynamicRes);
+        (*PerformanceObject)->TryGetBoolField("EnableTripleBuffering", Loaded.Performance.bEnableTripleBuffering);
+        (*PerformanceObject)->TryGetBoolField("EnableAsyncCompute", Loaded.Performance.bEnableAsyncCompute);
+        (*PerformanceObject)->TryGetNumberField("LODDistanceMultiplier", Loaded.Performance.LODDistanceMultiplier);
+        (*PerformanceObject)->TryGetNumberField("ProcessPriority", Loaded.Performance.ProcessPriority);
+        (*PerformanceObject)->TryGetBoolField("EnableTickBudget", Loaded.Performance.bEnableTickBudget);
+        (*PerformanceObject)->TryGetNumberField("TickBudgetFraction", Loaded.Performance.TickBudgetFraction);
+        (*PerformanceObject)->TryGetNumberField("MaxThrottledTickInterval", Loaded.Performance.MaxThrottledTickInterval);
+        (*PerformanceObject)->TryGetNumberField("SignificanceDistance", Loaded.Performance.SignificanceDistance);
+        (*PerformanceObject)->TryGetBoolField("AllowTickDisable", Loaded.Performance.bAllowTickDisable);
     }
 
     // Display (EXPANDED)
     const TSharedPtr<FJsonObject>* DisplayObject;
     if (JsonObject->TryGetObjectField("Display", DisplayObject))
     {
-        int32 ResX = 1920, ResY = 1080;
+        int32 ResX = Loaded.Display.Resolution.X, ResY = Loaded.Display.Resolution.Y;
         (*DisplayObject)->TryGetNumberField("ResolutionX", ResX);
         (*DisplayObject)->TryGetNumberField("ResolutionY", ResY);
-        CurrentSettings.Display.Resolution = FIntPoint(ResX, ResY);
+        if (ResX > 0 && ResY > 0)
+        {
+            Loaded.Display.Resolution = FIntPoint(ResX, ResY);
+        }
 
-        int32 WindowModeInt = 0;
+        int32 WindowModeInt = static_cast<int32>(Loaded.Display.WindowMode);
         (*DisplayObject)->TryGetNumberField("WindowMode", WindowModeInt);
-        CurrentSettings.Display.WindowMode = static_cast<EWindowMode::Type>(WindowModeInt);
-
-        (*DisplayObject)->TryGetNumberField("Brightness", CurrentSettings.Display.Brightness);
-        (*DisplayObject)->TryGetNumberField("Contrast", CurrentSettings.Display.Contrast);
-        (*DisplayObject)->TryGetBoolField("EnableHDR", CurrentSettings.Display.bEnableHDR);
-        (*DisplayObject)->TryGetNumberField("HDRMaxNits", CurrentSettings.Display.HDRMaxNits);
-        (*DisplayObject)->TryGetNumberField("MonitorIndex", CurrentSettings.Display.MonitorIndex);
-        (*DisplayObject)->TryGetBoolField("BorderlessWindow", CurrentSettings.Display.bBorderlessWindow);
-        (*DisplayObject)->TryGetNumberField("ScreenPercentage", CurrentSettings.Display.ScreenPercentage);
-        (*DisplayObject)->TryGetNumberField("MenuFieldOfView", CurrentSettings.Display.MenuFieldOfView);
-        (*DisplayObject)->TryGetNumberField("AspectRatioOverride", CurrentSettings.Display.AspectRatioOverride);
-        (*DisplayObject)->TryGetNumberField("SafeZoneScale", CurrentSettings.Display.SafeZoneScale);
+        Loaded.Display.WindowMode = static_cast<EWindowMode::Type>(WindowModeInt);
+
+        (*DisplayObject)->TryGetNumberField("Brightness", Loaded.Display.Brightness);
+        (*DisplayObject)->TryGetNumberField("Contrast", Loaded.Display.Contrast);
+        (*DisplayObject)->TryGetBoolField("EnableHDR", Loaded.Display.bEnableHDR);
+        (*DisplayObject)->TryGetNumberField("HDRMaxNits", Loaded.Display.HDRMaxNits);
+        (*DisplayObject)->TryGetNumberField("MonitorIndex", Loaded.Display.MonitorIndex);
+        (*DisplayObject)->TryGetBoolField("BorderlessWindow", Loaded.Display.bBorderlessWindow);
+        (*DisplayObject)->TryGetNumberField("ScreenPercentage", Loaded.Display.ScreenPercentage);
+        (*DisplayObject)->TryGetNumberField("MenuFieldOfView", Loaded.Display.MenuFieldOfView);
+        (*DisplayObject)->TryGetNumberField("AspectRatioOverride", Loaded.Display.AspectRatioOverride);
+        (*DisplayObject)->TryGetNumberField("SafeZoneScale", Loaded.Display.SafeZoneScale);
     }
 
     // Audio (EXPANDED)
     const TSharedPtr<FJsonObject>* AudioObject;
     if (JsonObject->TryGetObjectField("Audio", AudioObject))
     {
-        (*AudioObject)->TryGetNumberField("MasterVolume", CurrentSettings.Audio.MasterVolume);
-        (*AudioObject)->TryGetNumberField("SFXVolume", CurrentSettings.Audio.SFXVolume);
-        (*AudioObject)->TryGetNumberField("MusicVolume", CurrentSettings.Audio.MusicVolume);
-        (*AudioObject)->TryGetNumberField("VoiceDialogVolume", CurrentSettings.Audio.VoiceDialogVolume);
-        (*AudioObject)->TryGetNumberField("AmbientVolume", CurrentSettings.Audio.AmbientVolume);
-        (*AudioObject)->TryGetNumberField("UISoundVolume", CurrentSettings.Audio.UISoundVolume);
-        (*AudioObject)->TryGetNumberField("VoiceChatVolume", CurrentSettings.Audio.VoiceChatVolume);
-        (*AudioObject)->TryGetNumberField("AudioQuality", CurrentSettings.Audio.AudioQuality);
-        (*AudioObject)->TryGetNumberField("SurroundSoundMode", CurrentSettings.Audio.SurroundSoundMode);
-        (*AudioObject)->TryGetBoolField("EnableSpatialAudio", CurrentSettings.Audio.bEnableSpatialAudio);
-        (*AudioObject)->TryGetNumberField("DynamicRange", CurrentSettings.Audio.DynamicRange);
-        (*AudioObject)->TryGetNumberField("SubtitleTextSize", CurrentSettings.Audio.SubtitleTextSize);
-        (*AudioObject)->TryGetNumberField("SubtitleBackgroundOpacity", CurrentSettings.Audio.SubtitleBackgroundOpacity);
+        (*AudioObject)->TryGetNumberField("MasterVolume", Loaded.Audio.MasterVolume);
+        (*AudioObject)->TryGetNumberField("SFXVolume", Loaded.Audio.SFXVolume);
+        (*AudioObject)->TryGetNumberField("MusicVolume", Loaded.Audio.MusicVolume);
+        (*AudioObject)->TryGetNumberField("VoiceDialogVolume", Loaded.Audio.VoiceDialogVolume);
+        (*AudioObject)->TryGetNumberField("AmbientVolume", Loaded.Audio.AmbientVolume);
+        (*AudioObject)->TryGetNumberField("UISoundVolume", Loaded.Audio.UISoundVolume);
+        (*AudioObject)->TryGetNumberField("VoiceChatVolume", Loaded.Audio.VoiceChatVolume);
+        (*AudioObject)->TryGetNumberField("AudioQuality", Loaded.Audio.AudioQuality);
+        (*AudioObject)->TryGetNumberField("SurroundSoundMode", Loaded.Audio.SurroundSoundMode);
+        (*AudioObject)->TryGetBoolField("EnableSpatialAudio", Loaded.Audio.bEnableSpatialAudio);
+        (*AudioObject)->TryGetBoolField("EnableAdaptiveVoiceBudget", Loaded.Audio.bEnableAdaptiveVoiceBudget);
+        (*AudioObject)->TryGetNumberField("DynamicRange", Loaded.Audio.DynamicRange);
+        (*AudioObject)->TryGetNumberField("SubtitleTextSize", Loaded.Audio.SubtitleTextSize);
+        (*AudioObject)->TryGetNumberField("SubtitleBackgroundOpacity", Loaded.Audio.SubtitleBackgroundOpacity);
     }
 
     // Gameplay (EXPANDED)
     const TSharedPtr<FJsonObject>* GameplayObject;
     if (JsonObject->TryGetObjectField("Gameplay", GameplayObject))
     {
-        (*GameplayObject)->TryGetNumberField("FOV", CurrentSettings.Gameplay.FOV);
-        (*GameplayObject)->TryGetNumberField("MouseSensitivity", CurrentSettings.Gameplay.MouseSensitivity);
-        (*GameplayObject)->TryGetBoolField("InvertMouseY", CurrentSettings.Gameplay.bInvertMouseY);
-        (*GameplayObject)->TryGetNumberField("ControllerSensitivity", CurrentSettings.Gameplay.ControllerSensitivity);
-        (*GameplayObject)->TryGetNumberField("ControllerDeadZone", CurrentSettings.Gameplay.ControllerDeadZone);
-        (*GameplayObject)->TryGetNumberField("AimAssistStrength", CurrentSettings.Gameplay.AimAssistStrength);
-        (*GameplayObject)->TryGetNumberField("CameraShakeIntensity", CurrentSettings.Gameplay.CameraShakeIntensity);
-        (*GameplayObject)->TryGetNumberField("HeadBobIntensity", CurrentSettings.Gameplay.HeadBobIntensity);
-        (*GameplayObject)->TryGetBoolField("EnableVibration", CurrentSettings.Gameplay.bEnableVibration);
-        (*GameplayObject)->TryGetBoolField("CrouchToggle", CurrentSettings.Gameplay.bCrouchToggle);
-        (*GameplayObject)->TryGetBoolField("SprintToggle", CurrentSettings.Gameplay.bSprintToggle);
-        (*GameplayObject)->TryGetBoolField("EnableAutoRun", CurrentSettings.Gameplay.bEnableAutoRun);
-        (*GameplayObject)->TryGetNumberField("CameraSmoothing", CurrentSettings.Gameplay.CameraSmoothing);
+        (*GameplayObject)->TryGetNumberField("FOV", Loaded.Gameplay.FOV);
+        (*GameplayObject)->TryGetNumberField("MouseSensitivity", Loaded.Gameplay.MouseSensitivity);
+        (*GameplayObject)->TryGetBoolField("InvertMouseY", Loaded.Gameplay.bInvertMouseY);
+        (*GameplayObject)->TryGetNumberField("ControllerSensitivity", Loaded.Gameplay.ControllerSensitivity);
+        (*GameplayObject)->TryGetNumberField("ControllerDeadZone", Loaded.Gameplay.ControllerDeadZone);
+        (*GameplayObject)->TryGetNumberField("AimAssistStrength", Loaded.Gameplay.AimAssistStrength);
+        (*GameplayObject)->TryGetNumberField("CameraShakeIntensity", Loaded.Gameplay.CameraShakeIntensity);
+        (*GameplayObject)->TryGetNumberField("HeadBobIntensity", Loaded.Gameplay.HeadBobIntensity);
+        (*GameplayObject)->TryGetBoolField("EnableVibration", Loaded.Gameplay.bEnableVibration);
+        (*GameplayObject)->TryGetBoolField("CrouchToggle", Loaded.Gameplay.bCrouchToggle);
+        (*GameplayObject)->TryGetBoolField("SprintToggle", Loaded.Gameplay.bSprintToggle);
+        (*GameplayObject)->TryGetBoolField("EnableAutoRun", Loaded.Gameplay.bEnableAutoRun);
+        (*GameplayObject)->TryGetNumberField("CameraSmoothing", Loaded.Gameplay.CameraSmoothing);
     }
 
     // NEW: Accessibility
     const TSharedPtr<FJsonObject>* AccessibilityObject;
     if (JsonObject->TryGetObjectField("Accessibility", AccessibilityObject))
     {
-        int32 ColorblindInt = 0;
+        int32 ColorblindInt = static_cast<int32>(Loaded.Accessibility.ColorblindMode);
         (*AccessibilityObject)->TryGetNumberField("ColorblindMode", ColorblindInt);
-        CurrentSettings.Accessibility.ColorblindMode = static_cast<EUPMColorblindMode>(ColorblindInt);
-        (*AccessibilityObject)->TryGetNumberField("UIScale", CurrentSettings.Accessibility.UIScale);
-        (*AccessibilityObject)->TryGetNumberField("TextSize", CurrentSettings.Accessibility.TextSize);
-        (*AccessibilityObject)->TryGetBoolField("HighContrastMode", CurrentSettings.Accessibility.bHighContrastMode);
-        (*AccessibilityObject)->TryGetBoolField("EnableScreenReader", CurrentSettings.Accessibility.bEnableScreenReader);
-        (*AccessibilityObject)->TryGetBoolField("ReducedMotion", CurrentSettings.Accessibility.bReducedMotion);
-        (*AccessibilityObject)->TryGetBoolField("PhotosensitivityMode", CurrentSettings.Accessibility.bPhotosensitivityMode);
+        Loaded.Accessibility.ColorblindMode = static_cast<EUPMColorblindMode>(ColorblindInt);
+        (*AccessibilityObject)->TryGetNumberField("UIScale", Loaded.Accessibility.UIScale);
+        (*AccessibilityObject)->TryGetNumberField("TextSize", Loaded.Accessibility.TextSize);
+        (*AccessibilityObject)->TryGetBoolField("HighContrastMode", Loaded.Accessibility.bHighContrastMode);
+        (*AccessibilityObject)->TryGetBoolField("EnableScreenReader", Loaded.Accessibility.bEnableScreenReader);
+        (*AccessibilityObject)->TryGetBoolField("ReducedMotion", Loaded.Accessibility.bReducedMotion);
+        (*AccessibilityObject)->TryGetBoolField("PhotosensitivityMode", Loaded.Accessibility.bPhotosensitivityMode);
     }
 
     // NEW: Network
     const TSharedPtr<FJsonObject>* NetworkObject;
     if (JsonObject->TryGetObjectField("Network", NetworkObject))
     {
-        (*NetworkObject)->TryGetNumberField("MaxPingThreshold", CurrentSettings.Network.MaxPingThreshold);
-        (*NetworkObject)->TryGetNumberField("NetworkSmoothing", CurrentSettings.Network.NetworkSmoothing);
-        (*NetworkObject)->TryGetNumberField("BandwidthLimitKBps", CurrentSettings.Network.BandwidthLimitKBps);
-        (*NetworkObject)->TryGetStringField("PreferredRegion", CurrentSettings.Network.PreferredRegion);
-        (*NetworkObject)->TryGetBoolField("EnableCrossplay", CurrentSettings.Network.bEnableCrossplay);
+        (*NetworkObject)->TryGetNumberField("MaxPingThreshold", Loaded.Network.MaxPingThreshold);
+        (*NetworkObject)->TryGetNumberField("NetworkSmoothing", Loaded.Network.NetworkSmoothing);
+        (*NetworkObject)->TryGetNumberField("BandwidthLimitKBps", Loaded.Network.BandwidthLimitKBps);
+        (*NetworkObject)->TryGetStringField("PreferredRegion", Loaded.Network.PreferredRegion);
+        (*NetworkObject)->TryGetBoolField("EnableCrossplay", Loaded.Network.bEnableCrossplay);
+        (*NetworkObject)->TryGetBoolField("EnableAdaptiveNetworking", Loaded.Network.bEnableAdaptiveNetworking);
     }
 
     // NEW: Debug
     const TSharedPtr<FJsonObject>* DebugObject;
     if (JsonObject->TryGetObjectField("Debug", DebugObject))
     {
-        (*DebugObject)->TryGetBoolField("ShowPerformanceOverlay", CurrentSettings.Debug.bShowPerformanceOverlay);
-        (*DebugObject)->TryGetBoolField("ShowNetworkStats", CurrentSettings.Debug.bShowNetworkStats);
-        (*DebugObject)->TryGetBoolField("DeveloperMode", CurrentSettings.Debug.bDeveloperMode);
-        (*DebugObject)->TryGetBoolField("EnableCrashReporting", CurrentSettings.Debug.bEnableCrashReporting);
-        (*DebugObject)->TryGetBoolField("BenchmarkMode", CurrentSettings.Debug.bBenchmarkMode);
+        (*DebugObject)->TryGetBoolField("ShowPerformanceOverlay", Loaded.Debug.bShowPerformanceOverlay);
+        (*DebugObject)->TryGetBoolField("ShowNetworkStats", Loaded.Debug.bShowNetworkStats);
+        (*DebugObject)->TryGetBoolField("DeveloperMode", Loaded.Debug.bDeveloperMode);
+        (*DebugObject)->TryGetBoolField("EnableCrashReporting", Loaded.Debug.bEnableCrashReporting);
+        (*DebugObject)->TryGetBoolField("BenchmarkMode", Loaded.Debug.bBenchmarkMode);
+        (*DebugObject)->TryGetBoolField("EnableTickProfiler", Loaded.Debug.bEnableTickProfiler);
+        (*DebugObject)->TryGetBoolField("EnableTextureStreamingStats", Loaded.Debug.bEnableTextureStreamingStats);
+    }
+
+    // NEW: Server
+    const TSharedPtr<FJsonObject>* ServerObject;
+    if (JsonObject->TryGetObjectField("Server", ServerObject))
+    {
+        (*ServerObject)->TryGetBoolField("EnableTickRateGovernor", Loaded.Server.bEnableTickRateGovernor);
+        (*ServerObject)->TryGetNumberField("MinServerTickRate", Loaded.Server.MinServerTickRate);
+        (*ServerObject)->TryGetNumberField("MaxServerTickRate", Loaded.Server.MaxServerTickRate);
+        (*ServerObject)->TryGetNumberField("TickBudgetFraction", Loaded.Server.TickBudgetFraction);
+        (*ServerObject)->TryGetBoolField("AdaptNetCullDistance", Loaded.Server.bAdaptNetCullDistance);
+        (*ServerObject)->TryGetNumberField("MinNetCullDistanceScale", Loaded.Server.MinNetCullDistanceScale);
+    }
+
+    // A hand-edited or stale file gets the same range and enum checks as SetSettingValue; a value it rejects
+    // keeps the current one
+    FUPMCompleteSettings Validated = Loaded;
+    TArray<FString> SettingPaths;
+    GetSettingPaths(SettingPaths);
+    for (const FString& SettingPath : SettingPaths)
+    {
+        double Value = 0.0;
+        if (GetSettingValue(Loaded, SettingPath, Value) && !SetSettingValue(Validated, SettingPath, Value)
+            && GetSettingValue(CurrentSettings, SettingPath, Value))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UPM: Ignoring invalid %s in settings file"), *SettingPath);
+            SetSettingValue(Validated, SettingPath, Value);
+        }
     }
 
+    CurrentSettings = Validated;
     return true;
 }
 
@@ -19,9 +19,25 @@ void UUPMSettingsPanelWidget::NativeConstruct()
     if (SettingsManager)
     {
         RefreshFromSettings();
+        SettingsChangedHandle = SettingsManager->OnSettingsChangedNative.AddUObject(this, &UUPMSettingsPanelWidget::HandleSettingsChanged);
     }
 }
 
+void UUPMSettingsPanelWidget::NativeDestruct()
+{
+    if (SettingsManager)
+    {
+        SettingsManager->OnSettingsChangedNative.Remove(SettingsChangedHandle);
+    }
+
+    Super::NativeDestruct();
+}
+
+void UUPMSettingsPanelWidget::HandleSettingsChanged(const FUPMSettingsChange& Change)
+{
+    OnSettingsChanged(Change);
+}
+
 // ==================== Initialization ====================
 
 void UUPMSettingsPanelWidget::RefreshFromSettings()
@@ -269,6 +285,18 @@ void UUPMSettingsPanelWidget::ApplySettings()
 {
     if (SettingsManager)
     {
+        // The settings menu is a safe point for resolution, window mode and the like
         SettingsManager->ApplyAllSettings();
+        SettingsManager->NotifySafePoint();
     }
 }
+
+FUPMSettingApplyCostStats UUPMSettingsPanelWidget::GetSettingApplyCostStats(const FString& SettingPath) const
+{
+    return SettingsManager ? SettingsManager->GetSettingApplyCostStats(SettingPath) : FUPMSettingApplyCostStats();
+}
+
+bool UUPMSettingsPanelWidget::IsSettingExpensive(const FString& SettingPath) const
+{
+    return SettingsManager && SettingsManager->GetSettingApplyCost(SettingPath) == EUPMSettingApplyCost::Expensive;
+}
@@ -0,0 +1,129 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSettingsRequestQueue.h"
+#include "UPMSettingsManager.h"
+#include "Containers/Queue.h"
+
+struct FUPMSettingsRequest
+{
+    FString SettingPath;
+    double Value = 0.0;
+    FString Requester;
+    int32 Priority = 0;
+    TPromise<EUPMSettingsRequestResult> Promise;
+};
+
+static TQueue<TUniquePtr<FUPMSettingsRequest>, EQueueMode::Mpsc> GUPMSettingsRequests;
+
+static const TCHAR* UPMSettingsRequestResultName(EUPMSettingsRequestResult Result)
+{
+    switch (Result)
+    {
+    case EUPMSettingsRequestResult::Applied: return TEXT("applied");
+    case EUPMSettingsRequestResult::Deferred: return TEXT("deferred");
+    case EUPMSettingsRequestResult::Unchanged: return TEXT("unchanged");
+    case EUPMSettingsRequestResult::Coalesced: return TEXT("coalesced");
+    default: return TEXT("rejected");
+    }
+}
+
+/** Complete the request, logging anything that did not take effect */
+static void UPMCompleteSettingsRequest(FUPMSettingsRequest& Request, EUPMSettingsRequestResult Result)
+{
+    if (Result == EUPMSettingsRequestResult::Rejected || Result == EUPMSettingsRequestResult::Coalesced)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("UPM: Settings request %s = %g from %s %s"), *Request.SettingPath, Request.Value,
+            Request.Requester.IsEmpty() ? TEXT("<unknown>") : *Request.Requester, UPMSettingsRequestResultName(Result));
+    }
+    Request.Promise.SetValue(Result);
+}
+
+TFuture<EUPMSettingsRequestResult> FUPMSettingsRequestQueue::Request(const FString& SettingPath, double Value, const FString& Requester, int32 Priority)
+{
+    TUniquePtr<FUPMSettingsRequest> Request = MakeUnique<FUPMSettingsRequest>();
+    Request->SettingPath = SettingPath;
+    Request->Value = Value;
+    Request->Requester = Requester;
+    Request->Priority = Priority;
+
+    TFuture<EUPMSettingsRequestResult> Future = Request->Promise.GetFuture();
+    GUPMSettingsRequests.Enqueue(MoveTemp(Request));
+    return Future;
+}
+
+void FUPMSettingsRequestQueue::ProcessRequests(UUPMSettingsManager* Manager)
+{
+    check(IsInGameThread());
+    if (GUPMSettingsRequests.IsEmpty())
+    {
+        return;
+    }
+
+    // Drain in arrival order, keeping the winning request per setting
+    TArray<TUniquePtr<FUPMSettingsRequest>> Winners;
+    TMap<FString, int32> WinnerIndices;
+    TUniquePtr<FUPMSettingsRequest> Request;
+    while (GUPMSettingsRequests.Dequeue(Request))
+    {
+        double CurrentValue = 0.0;
+        if (!Manager || !FMath::IsFinite(Request->Value) || !UUPMSettingsManager::GetSettingValue(Manager->GetSettings(), Request->SettingPath, CurrentValue))
+        {
+            UPMCompleteSettingsRequest(*Request, EUPMSettingsRequestResult::Rejected);
+            continue;
+        }
+
+        // Paths are case-insensitive, so is the merge
+        const FString Key = Request->SettingPath.ToLower();
+        if (int32* WinnerIndex = WinnerIndices.Find(Key))
+        {
+            TUniquePtr<FUPMSettingsRequest>& Winner = Winners[*WinnerIndex];
+            if (Request->Priority < Winner->Priority)
+            {
+                UPMCompleteSettingsRequest(*Request, EUPMSettingsRequestResult::Coalesced);
+                continue;
+            }
+            UPMCompleteSettingsRequest(*Winner, EUPMSettingsRequestResult::Coalesced);
+            Winner = MoveTemp(Request);
+        }
+        else
+        {
+            WinnerIndices.Add(Key, Winners.Num());
+            Winners.Add(MoveTemp(Request));
+        }
+    }
+
+    // One commit and one change notification for the whole frame
+    TArray<EUPMSettingsRequestResult> Results;
+    Results.Reserve(Winners.Num());
+    {
+        FUPMSettingsBatch Batch(Manager);
+        for (const TUniquePtr<FUPMSettingsRequest>& Winner : Winners)
+        {
+            double OldValue = 0.0;
+            double NewValue = 0.0;
+            UUPMSettingsManager::GetSettingValue(Manager->GetSettings(), Winner->SettingPath, OldValue);
+            if (!Manager->SetSettingByName(Winner->SettingPath, Winner->Value))
+            {
+                Results.Add(EUPMSettingsRequestResult::Rejected);
+                continue;
+            }
+            UUPMSettingsManager::GetSettingValue(Manager->GetSettings(), Winner->SettingPath, NewValue);
+            Results.Add(NewValue != OldValue ? EUPMSettingsRequestResult::Applied : EUPMSettingsRequestResult::Unchanged);
+        }
+    }
+
+    // Expensive settings changed outside a safe point are held back by the commit
+    for (int32 Index = 0; Index < Winners.Num(); ++Index)
+    {
+        if (Results[Index] == EUPMSettingsRequestResult::Applied && Manager->IsSettingDeferred(Winners[Index]->SettingPath))
+        {
+            Results[Index] = EUPMSettingsRequestResult::Deferred;
+        }
+    }
+
+    // Completed after the commit so continuations observe the new settings
+    for (int32 Index = 0; Index < Winners.Num(); ++Index)
+    {
+        UPMCompleteSettingsRequest(*Winners[Index], Results[Index]);
+    }
+}
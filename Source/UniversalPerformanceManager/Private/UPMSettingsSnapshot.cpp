@@ -0,0 +1,90 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSettingsSnapshot.h"
+#include <atomic>
+
+// Owns one reference to the snapshot it points at
+static std::atomic<const FUPMSettingsSnapshot*> GUPMCurrentSettingsSnapshot{ nullptr };
+
+// Readers between loading the pointer and taking their reference
+static std::atomic<int32> GUPMSettingsSnapshotReaders{ 0 };
+
+// Game thread only: superseded snapshots, each still holding the reference the current pointer owned
+static TArray<const FUPMSettingsSnapshot*> GUPMRetiredSettingsSnapshots;
+
+static uint32 GUPMSettingsSnapshotVersion = 0;
+
+FUPMSettingsSnapshot::FUPMSettingsSnapshot(const FUPMCompleteSettings& InSettings, uint32 InVersion)
+    : Settings(InSettings)
+    , Version(InVersion)
+{
+}
+
+TRefCountPtr<const FUPMSettingsSnapshot> FUPMSettingsSnapshot::Get()
+{
+    // Counted as a reader until the reference is taken, so a snapshot superseded meanwhile is not released under us
+    GUPMSettingsSnapshotReaders.fetch_add(1);
+
+    const FUPMSettingsSnapshot* Snapshot = GUPMCurrentSettingsSnapshot.load();
+    if (!Snapshot)
+    {
+        // Defaults until the first commit; published once, and a racing loser is simply never used
+        FUPMSettingsSnapshot* DefaultSnapshot = new FUPMSettingsSnapshot(FUPMCompleteSettings(), 0);
+        DefaultSnapshot->AddRef();
+        if (GUPMCurrentSettingsSnapshot.compare_exchange_strong(Snapshot, DefaultSnapshot))
+        {
+            Snapshot = DefaultSnapshot;
+        }
+        else
+        {
+            DefaultSnapshot->Release();
+        }
+    }
+
+    TRefCountPtr<const FUPMSettingsSnapshot> Reference(Snapshot);
+    GUPMSettingsSnapshotReaders.fetch_sub(1);
+    return Reference;
+}
+
+void FUPMSettingsSnapshot::Publish(const FUPMCompleteSettings& InSettings)
+{
+    check(IsInGameThread());
+
+    FUPMSettingsSnapshot* Snapshot = new FUPMSettingsSnapshot(InSettings, ++GUPMSettingsSnapshotVersion);
+    Snapshot->AddRef();
+
+    if (const FUPMSettingsSnapshot* Superseded = GUPMCurrentSettingsSnapshot.exchange(Snapshot))
+    {
+        GUPMRetiredSettingsSnapshots.Add(Superseded);
+    }
+    ReleaseRetired();
+}
+
+void FUPMSettingsSnapshot::ReleaseRetired()
+{
+    check(IsInGameThread());
+
+    // Every retired pointer was replaced before this check; a reader that loaded one still counts until it holds
+    // its own reference, and readers arriving later load the current one. No readers = nobody can still reach them.
+    if (GUPMRetiredSettingsSnapshots.Num() == 0 || GUPMSettingsSnapshotReaders.load() != 0)
+    {
+        return;
+    }
+
+    for (const FUPMSettingsSnapshot* Retired : GUPMRetiredSettingsSnapshots)
+    {
+        Retired->Release();
+    }
+    GUPMRetiredSettingsSnapshots.Reset();
+}
+
+void FUPMSettingsSnapshot::Shutdown()
+{
+    check(IsInGameThread());
+
+    if (const FUPMSettingsSnapshot* Current = GUPMCurrentSettingsSnapshot.exchange(nullptr))
+    {
+        GUPMRetiredSettingsSnapshots.Add(Current);
+    }
+    ReleaseRetired();
+}
@@ -0,0 +1,193 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMShaderPrecache.h"
+#include "PipelineStateCache.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/EngineVersionComparison.h"
+
+// Shader precache tuning
+static const float UPMPrecacheHitchThresholdMs = 50.0f;   // A frame this long after a switch counts as a hitch
+static const double UPMPrecacheHitchWindowSeconds = 3.0;  // How long after a switch frames are watched
+static const double UPMPrecacheMinRequestSeconds = 0.25;  // The pipeline cache needs a few frames to queue work
+
+// Settings that select shader permutations, with their number of levels; one bit per level, 60 bits in total
+static const TPair<const TCHAR*, int32> UPMPrecacheMaskSettings[] =
+{
+    { TEXT("Graphics.AntiAliasingQuality"), 5 },
+    { TEXT("Graphics.ShadowQuality"), 5 },
+    { TEXT("Graphics.PostProcessQuality"), 5 },
+    { TEXT("Graphics.EffectsQuality"), 5 },
+    { TEXT("Graphics.FoliageQuality"), 5 },
+    { TEXT("Graphics.ShadingQuality"), 5 },
+    { TEXT("Rendering.GlobalIlluminationQuality"), 5 },
+    { TEXT("Rendering.ReflectionQuality"), 5 },
+    { TEXT("Rendering.bEnableLumen"), 2 },
+    { TEXT("Rendering.bEnableRayTracing"), 2 },
+    { TEXT("Rendering.bEnableSSAO"), 2 },
+    { TEXT("Rendering.bEnableSSR"), 2 },
+    { TEXT("Rendering.bEnableMotionBlur"), 2 },
+    { TEXT("Rendering.bEnableBloom"), 2 },
+    { TEXT("Rendering.bEnableDepthOfField"), 2 },
+    { TEXT("Rendering.bEnableVolumetricFog"), 2 },
+    { TEXT("Rendering.bEnableSSGI"), 2 },
+    { TEXT("Rendering.bEnableContactShadows"), 2 },
+};
+
+/** The pipeline cache has no getter for its batch mode; outside requests it runs in the mode the project starts it in */
+static FShaderPipelineCache::BatchMode UPMGetProjectBatchMode()
+{
+    static const IConsoleVariable* StartupMode = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ShaderPipelineCache.StartupMode"));
+    return StartupMode && StartupMode->GetInt() == 1
+        ? FShaderPipelineCache::BatchMode::Fast
+        : FShaderPipelineCache::BatchMode::Background;
+}
+
+/** A PSO is wanted if it was recorded with every level the reference settings use */
+static bool UPMPrecacheMaskComparison(uint64 ReferenceMask, uint64 PSOMask)
+{
+    return (ReferenceMask & PSOMask) == ReferenceMask;
+}
+
+FUPMShaderPrecache::FUPMShaderPrecache()
+    : CurrentMask(0)
+    , WarmMask(0)
+    , bRequestActive(false)
+    , PeakRemaining(0)
+    , RequestStartTime(0.0)
+    , RestoreBatchMode(FShaderPipelineCache::BatchMode::Background)
+    , SwitchTime(-UPMPrecacheHitchWindowSeconds)
+    , bSwitchWasWarm(false)
+{
+}
+
+uint64 FUPMShaderPrecache::GetUsageMask(const FUPMCompleteSettings& Settings)
+{
+    uint64 Mask = 0;
+    int32 FirstBit = 0;
+    for (const TPair<const TCHAR*, int32>& Setting : UPMPrecacheMaskSettings)
+    {
+        double Value = 0.0;
+        UUPMSettingsManager::GetSettingValue(Settings, Setting.Key, Value);
+        const int32 Level = FMath::Clamp(FMath::RoundToInt(Value), 0, Setting.Value - 1);
+        Mask |= uint64(1) << (FirstBit + Level);
+        FirstBit += Setting.Value;
+    }
+    check(FirstBit <= 64);
+    return Mask;
+}
+
+void FUPMShaderPrecache::SetUsageMask(uint64 Mask)
+{
+    if (Mask != CurrentMask)
+    {
+        CurrentMask = Mask;
+        FShaderPipelineCache::SetGameUsageMaskWithComparison(Mask, &UPMPrecacheMaskComparison);
+    }
+}
+
+int32 FUPMShaderPrecache::GetRemaining() const
+{
+    int32 Remaining = static_cast<int32>(FShaderPipelineCache::NumPrecompilesRemaining());
+#if UE_VERSION_NEWER_THAN(5, 1, 99)
+    Remaining += PipelineStateCache::NumActivePrecompileRequests();
+#endif
+    return Remaining;
+}
+
+bool FUPMShaderPrecache::IsWarmFor(const FUPMCompleteSettings& Settings) const
+{
+    return !bRequestActive && WarmMask == GetUsageMask(Settings);
+}
+
+float FUPMShaderPrecache::GetProgress() const
+{
+    if (!bRequestActive || PeakRemaining == 0)
+    {
+        return bRequestActive ? 0.0f : 1.0f;
+    }
+    return 1.0f - static_cast<float>(GetRemaining()) / PeakRemaining;
+}
+
+bool FUPMShaderPrecache::Request(const FUPMCompleteSettings& Settings)
+{
+    const uint64 Mask = GetUsageMask(Settings);
+    if (IsWarmFor(Settings))
+    {
+        return false;
+    }
+
+    SetUsageMask(Mask);
+    if (!bRequestActive)
+    {
+        RestoreBatchMode = UPMGetProjectBatchMode();
+    }
+    FShaderPipelineCache::SetBatchMode(FShaderPipelineCache::BatchMode::Fast);
+    FShaderPipelineCache::ResumeBatching();
+
+    WarmMask = Mask;
+    bRequestActive = true;
+    PeakRemaining = GetRemaining();
+    RequestStartTime = FPlatformTime::Seconds();
+    ++Stats.Requests;
+    UE_LOG(LogTemp, Log, TEXT("UPM: Precaching PSOs for upcoming settings (mask 0x%016llx)"), Mask);
+    return true;
+}
+
+void FUPMShaderPrecache::NotifySettingsCommitted(const FUPMCompleteSettings& Settings)
+{
+    const uint64 Mask = GetUsageMask(Settings);
+    if (CurrentMask == 0)
+    {
+        // Startup, nothing was switched
+        SetUsageMask(Mask);
+        return;
+    }
+    if (Mask == CurrentMask && !bRequestActive)
+    {
+        return;
+    }
+
+    // Warm if a finished request compiled exactly these settings
+    bSwitchWasWarm = IsWarmFor(Settings);
+    SwitchTime = FPlatformTime::Seconds();
+    ++(bSwitchWasWarm ? Stats.WarmSwitches : Stats.ColdSwitches);
+
+    // Whatever is still missing compiles in the background from here on
+    SetUsageMask(Mask);
+    if (!bSwitchWasWarm)
+    {
+        WarmMask = Mask;
+    }
+}
+
+void FUPMShaderPrecache::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    if (Now - SwitchTime < UPMPrecacheHitchWindowSeconds)
+    {
+        const float FrameTimeMs = DeltaTime * 1000.0f;
+        if (FrameTimeMs > UPMPrecacheHitchThresholdMs)
+        {
+            ++(bSwitchWasWarm ? Stats.WarmSwitchHitches : Stats.ColdSwitchHitches);
+            float& WorstHitchMs = bSwitchWasWarm ? Stats.WarmSwitchWorstHitchMs : Stats.ColdSwitchWorstHitchMs;
+            WorstHitchMs = FMath::Max(WorstHitchMs, FrameTimeMs);
+        }
+    }
+
+    if (!bRequestActive)
+    {
+        return;
+    }
+
+    const int32 Remaining = GetRemaining();
+    PeakRemaining = FMath::Max(PeakRemaining, Remaining);
+    if (Remaining == 0 && Now - RequestStartTime >= UPMPrecacheMinRequestSeconds)
+    {
+        bRequestActive = false;
+        FShaderPipelineCache::SetBatchMode(RestoreBatchMode);
+        Stats.LastPrecacheSeconds = static_cast<float>(Now - RequestStartTime);
+        UE_LOG(LogTemp, Log, TEXT("UPM: PSO precache complete, %d PSOs in %.1fs"), PeakRemaining, Stats.LastPrecacheSeconds);
+        OnComplete.Broadcast();
+    }
+}
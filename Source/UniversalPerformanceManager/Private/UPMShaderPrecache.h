@@ -0,0 +1,68 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+#include "ShaderPipelineCache.h"
+
+/**
+ * PSO precaching for settings switches
+ *
+ * Settings that change which shaders are used (shadow, post process, effects, shading quality and the
+ * rendering toggles) are encoded into the shader pipeline cache's game usage mask. The mask is set on every
+ * commit, so recorded PSO caches know which settings each PSO was used with, and the pipeline cache compiles
+ * the PSOs of the current mask in the background. Request() sets the mask of upcoming settings ahead of the
+ * switch and compiles at full speed until nothing is left (use a fade or menu to hide it).
+ *
+ * Frames over the hitch threshold right after each switch are counted separately for switches that happened
+ * warm (precached) and cold, so the effect of precaching can be measured.
+ */
+class FUPMShaderPrecache
+{
+public:
+    FUPMShaderPrecache();
+
+    /** Usage mask of the shader-relevant parts of Settings */
+    static uint64 GetUsageMask(const FUPMCompleteSettings& Settings);
+
+    /** Start compiling the PSOs of Settings at full speed; false if the pipeline cache has nothing to do */
+    bool Request(const FUPMCompleteSettings& Settings);
+
+    /** Settings were committed: compile what they need in the background and watch the following frames */
+    void NotifySettingsCommitted(const FUPMCompleteSettings& Settings);
+
+    /** Game thread, once per frame */
+    void Tick(float DeltaTime);
+
+    bool IsWarm() const { return !bRequestActive; }
+    bool IsWarmFor(const FUPMCompleteSettings& Settings) const;
+    int32 GetRemaining() const;
+
+    /** 0-1 for the active request, 1 when nothing is pending */
+    float GetProgress() const;
+
+    const FUPMShaderPrecacheStats& GetStats() const { return Stats; }
+
+    /** Fires when a request finished compiling */
+    FSimpleMulticastDelegate OnComplete;
+
+private:
+    void SetUsageMask(uint64 Mask);
+
+    uint64 CurrentMask;
+    uint64 WarmMask;
+
+    bool bRequestActive;
+    int32 PeakRemaining;
+    double RequestStartTime;
+
+    // Batch mode the pipeline cache ran in before the request switched it to Fast
+    FShaderPipelineCache::BatchMode RestoreBatchMode;
+
+    // Hitch window after the last switch
+    double SwitchTime;
+    bool bSwitchWasWarm;
+
+    FUPMShaderPrecacheStats Stats;
+};
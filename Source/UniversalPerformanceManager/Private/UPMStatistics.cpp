@@ -0,0 +1,134 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMStatistics.h"
+#include <cmath>
+
+float FUPMStatistics::Mean(const TArray<float>& Values)
+{
+    if (Values.Num() == 0)
+    {
+        return 0.0f;
+    }
+
+    double Sum = 0.0;
+    for (float Value : Values)
+    {
+        Sum += Value;
+    }
+    return static_cast<float>(Sum / Values.Num());
+}
+
+float FUPMStatistics::PercentileSorted(const TArray<float>& SortedValues, float Percentile)
+{
+    if (SortedValues.Num() == 0)
+    {
+        return 0.0f;
+    }
+
+    const float Rank = FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0f * (SortedValues.Num() - 1);
+    const int32 Lower = FMath::FloorToInt(Rank);
+    const int32 Upper = FMath::Min(Lower + 1, SortedValues.Num() - 1);
+    return FMath::Lerp(SortedValues[Lower], SortedValues[Upper], Rank - Lower);
+}
+
+float FUPMStatistics::Percentile(const TArray<float>& Values, float Percentile)
+{
+    TArray<float> Sorted = Values;
+    Sorted.Sort();
+    return PercentileSorted(Sorted, Percentile);
+}
+
+float FUPMStatistics::StdDev(const TArray<float>& Values)
+{
+    if (Values.Num() < 2)
+    {
+        return 0.0f;
+    }
+
+    const double MeanValue = Mean(Values);
+    double SumSquares = 0.0;
+    for (float Value : Values)
+    {
+        SumSquares += FMath::Square(Value - MeanValue);
+    }
+    return static_cast<float>(FMath::Sqrt(SumSquares / (Values.Num() - 1)));
+}
+
+float FUPMStatistics::ConfidenceInterval95(const TArray<float>& Values)
+{
+    if (Values.Num() < 2)
+    {
+        return 0.0f;
+    }
+
+    // Two-sided 95% critical values of Student's t for 1-30 degrees of freedom, normal beyond
+    static const float TCritical[] =
+    {
+        12.706f, 4.303f, 3.182f, 2.776f, 2.571f, 2.447f, 2.365f, 2.306f, 2.262f, 2.228f,
+        2.201f, 2.179f, 2.160f, 2.145f, 2.131f, 2.120f, 2.110f, 2.101f, 2.093f, 2.086f,
+        2.080f, 2.074f, 2.069f, 2.064f, 2.060f, 2.056f, 2.052f, 2.048f, 2.045f, 2.042f
+    };
+
+    const int32 DegreesOfFreedom = Values.Num() - 1;
+    const float T = DegreesOfFreedom <= UE_ARRAY_COUNT(TCritical) ? TCritical[DegreesOfFreedom - 1] : 1.960f;
+    return T * StdDev(Values) / FMath::Sqrt(static_cast<float>(Values.Num()));
+}
+
+void FUPMStatistics::MannWhitneyU(const TArray<float>& A, const TArray<float>& B, double& OutProbabilityOfSuperiority, double& OutPValue)
+{
+    OutProbabilityOfSuperiority = 0.5;
+    OutPValue = 1.0;
+    if (A.Num() == 0 || B.Num() == 0)
+    {
+        return;
+    }
+
+    // Rank the pooled samples, ties get the average rank
+    TArray<TPair<float, bool>> Pooled; // Value, belongs to A
+    Pooled.Reserve(A.Num() + B.Num());
+    for (float Value : A)
+    {
+        Pooled.Emplace(Value, true);
+    }
+    for (float Value : B)
+    {
+        Pooled.Emplace(Value, false);
+    }
+    Pooled.Sort([](const TPair<float, bool>& X, const TPair<float, bool>& Y) { return X.Key < Y.Key; });
+
+    const double N = Pooled.Num();
+    double RankSumA = 0.0;
+    double TieCorrection = 0.0;
+    for (int32 Start = 0; Start < Pooled.Num();)
+    {
+        int32 End = Start + 1;
+        while (End < Pooled.Num() && Pooled[End].Key == Pooled[Start].Key)
+        {
+            End++;
+        }
+
+        const double TiedCount = End - Start;
+        const double AverageRank = (Start + 1 + End) * 0.5;
+        for (int32 Index = Start; Index < End; ++Index)
+        {
+            if (Pooled[Index].Value)
+            {
+                RankSumA += AverageRank;
+            }
+        }
+        TieCorrection += TiedCount * TiedCount * TiedCount - TiedCount;
+        Start = End;
+    }
+
+    const double NA = A.Num();
+    const double NB = B.Num();
+    const double U = RankSumA - NA * (NA + 1.0) * 0.5;
+    OutProbabilityOfSuperiority = U / (NA * NB);
+
+    const double Variance = NA * NB / 12.0 * ((N + 1.0) - TieCorrection / (N * (N - 1.0)));
+    if (Variance > 0.0)
+    {
+        const double Z = (U - NA * NB * 0.5) / FMath::Sqrt(Variance);
+        OutPValue = std::erfc(FMath::Abs(Z) / UE_DOUBLE_SQRT_2);
+    }
+}
@@ -0,0 +1,206 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMStreamingGovernor.h"
+#include "Engine/World.h"
+#include "Engine/LevelStreaming.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/App.h"
+#include "RenderCore.h"
+
+// Streaming governor tuning
+static const int32 UPMLoadingScreenRegistrationGranularity = 1000; // Components per step behind a loading screen
+static const int32 UPMMinRegistrationGranularity = 1;
+static const int32 UPMMaxRegistrationGranularity = 100;
+static const int32 UPMGranularityAdjustFrames = 10;         // Frames between granularity changes
+static const float UPMStreamingBaselineAlpha = 0.05f;       // Smoothing of the baseline game thread time
+static const float UPMStreamingCostAlpha = 0.2f;            // Smoothing of the cost of streaming frames
+static const float UPMStreamingBacklogTightSeconds = 5.0f;  // Backlog age at which the distance scale drops
+static const float UPMStreamingDistanceScaleRate = 0.05f;   // Distance scale change per second
+static const float UPMMinStreamingDistanceScale = 0.5f;
+
+static IConsoleVariable* UPMFindStreamingCVar(const TCHAR* Name)
+{
+    return IConsoleManager::Get().FindConsoleVariable(Name);
+}
+
+FUPMStreamingGovernor::FUPMStreamingGovernor()
+    : bApplied(false)
+    , OriginalAsyncLoadingTimeLimit(5.0f)
+    , OriginalRegistrationGranularity(10)
+    , OriginalUseFullTimeLimit(0)
+    , RegistrationGranularity(10)
+    , FramesSinceGranularityChange(0)
+    , BaselineGameThreadMs(0.0f)
+    , StreamingFrameCostMs(0.0f)
+    , PendingLevels(0)
+    , AsyncPackages(0)
+    , bRegistering(false)
+    , BacklogStartTime(0.0)
+    , BacklogSeconds(0.0f)
+    , bBacklogReported(false)
+    , AsyncLoadingTimeLimitMs(0.0f)
+    , StreamingDistanceScale(1.0f)
+{
+}
+
+void FUPMStreamingGovernor::Tick(UWorld* World, bool bLoadingScreen, const FUPMPerformanceSettings& Settings)
+{
+    PendingLevels = 0;
+    bRegistering = false;
+    if (World)
+    {
+        for (const ULevelStreaming* StreamingLevel : World->GetStreamingLevels())
+        {
+            if (StreamingLevel && (StreamingLevel->HasLoadRequestPending() || StreamingLevel->ShouldBeLoaded() != StreamingLevel->IsLevelLoaded()
+                || (StreamingLevel->IsLevelLoaded() && StreamingLevel->ShouldBeVisible() != StreamingLevel->IsLevelVisible())))
+            {
+                ++PendingLevels;
+            }
+        }
+
+        // A level is part way through AddToWorld (component registration, spread over frames)
+        bRegistering = World->IsVisibilityRequestPending();
+    }
+    AsyncPackages = GetNumAsyncPackages();
+
+    // Streaming cost: game thread time over what frames without streaming work take
+    const float GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+    if (!bRegistering && AsyncPackages == 0)
+    {
+        BaselineGameThreadMs = BaselineGameThreadMs > 0.0f
+            ? FMath::Lerp(BaselineGameThreadMs, GameThreadMs, UPMStreamingBaselineAlpha)
+            : GameThreadMs;
+        StreamingFrameCostMs = FMath::Lerp(StreamingFrameCostMs, 0.0f, UPMStreamingCostAlpha);
+    }
+    else if (BaselineGameThreadMs > 0.0f)
+    {
+        StreamingFrameCostMs = FMath::Lerp(StreamingFrameCostMs, FMath::Max(0.0f, GameThreadMs - BaselineGameThreadMs), UPMStreamingCostAlpha);
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    if (PendingLevels > 0 || AsyncPackages > 0)
+    {
+        if (BacklogSeconds <= 0.0f)
+        {
+            BacklogStartTime = Now;
+        }
+        BacklogSeconds = FMath::Max(static_cast<float>(Now - BacklogStartTime), KINDA_SMALL_NUMBER);
+    }
+    else
+    {
+        BacklogSeconds = 0.0f;
+        bBacklogReported = false;
+    }
+
+    if (Settings.bEnableStreamingGovernor)
+    {
+        Apply(bLoadingScreen, Settings, FApp::GetDeltaTime());
+    }
+    else
+    {
+        Restore();
+    }
+}
+
+void FUPMStreamingGovernor::Apply(bool bLoadingScreen, const FUPMPerformanceSettings& Settings, float DeltaTime)
+{
+    IConsoleVariable* TimeLimitCVar = UPMFindStreamingCVar(TEXT("s.AsyncLoadingTimeLimit"));
+    IConsoleVariable* GranularityCVar = UPMFindStreamingCVar(TEXT("s.LevelStreamingComponentsRegistrationGranularity"));
+    IConsoleVariable* FullTimeLimitCVar = UPMFindStreamingCVar(TEXT("s.AsyncLoadingUseFullTimeLimit"));
+    if (!bApplied)
+    {
+        OriginalAsyncLoadingTimeLimit = TimeLimitCVar ? TimeLimitCVar->GetFloat() : OriginalAsyncLoadingTimeLimit;
+        OriginalRegistrationGranularity = GranularityCVar ? GranularityCVar->GetInt() : OriginalRegistrationGranularity;
+        OriginalUseFullTimeLimit = FullTimeLimitCVar ? FullTimeLimitCVar->GetInt() : OriginalUseFullTimeLimit;
+        RegistrationGranularity = FMath::Clamp(OriginalRegistrationGranularity, UPMMinRegistrationGranularity, UPMMaxRegistrationGranularity);
+        bApplied = true;
+    }
+
+    const float BudgetMs = FMath::Max(0.5f, Settings.StreamingBudgetMs);
+    int32 Granularity = UPMLoadingScreenRegistrationGranularity;
+    if (bLoadingScreen)
+    {
+        AsyncLoadingTimeLimitMs = FMath::Max(BudgetMs, Settings.LoadingScreenAsyncLoadingTimeMs);
+        StreamingDistanceScale = 1.0f;
+    }
+    else
+    {
+        AsyncLoadingTimeLimitMs = BudgetMs;
+
+        // Fewer components per step when registering frames go over the budget, more when well under it
+        if (bRegistering && ++FramesSinceGranularityChange >= UPMGranularityAdjustFrames)
+        {
+            if (StreamingFrameCostMs > BudgetMs)
+            {
+                RegistrationGranularity = FMath::Max(UPMMinRegistrationGranularity, RegistrationGranularity / 2);
+                FramesSinceGranularityChange = 0;
+            }
+            else if (StreamingFrameCostMs < BudgetMs * 0.5f && RegistrationGranularity < UPMMaxRegistrationGranularity)
+            {
+                RegistrationGranularity = FMath::Min(UPMMaxRegistrationGranularity, RegistrationGranularity + FMath::Max(1, RegistrationGranularity / 4));
+                FramesSinceGranularityChange = 0;
+            }
+        }
+        Granularity = RegistrationGranularity;
+
+        // The budget cannot keep up: stream a smaller area until it does
+        const float ScaleStep = UPMStreamingDistanceScaleRate * DeltaTime;
+        StreamingDistanceScale = BacklogSeconds >= UPMStreamingBacklogTightSeconds
+            ? FMath::Max(UPMMinStreamingDistanceScale, StreamingDistanceScale - ScaleStep)
+            : FMath::Min(1.0f, StreamingDistanceScale + ScaleStep);
+
+        if (BacklogSeconds >= UPMStreamingBacklogTightSeconds && !bBacklogReported)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("UPM: Streaming backlog for %.0f s (%d levels, %d packages) at a %.1f ms budget"),
+                BacklogSeconds, PendingLevels, AsyncPackages, BudgetMs);
+            bBacklogReported = true;
+        }
+    }
+
+    if (TimeLimitCVar && TimeLimitCVar->GetFloat() != AsyncLoadingTimeLimitMs)
+    {
+        TimeLimitCVar->Set(AsyncLoadingTimeLimitMs);
+    }
+    if (GranularityCVar && GranularityCVar->GetInt() != Granularity)
+    {
+        GranularityCVar->Set(Granularity);
+    }
+    if (FullTimeLimitCVar && FullTimeLimitCVar->GetInt() != (bLoadingScreen ? 1 : 0))
+    {
+        FullTimeLimitCVar->Set(bLoadingScreen ? 1 : 0);
+    }
+}
+
+void FUPMStreamingGovernor::Restore()
+{
+    if (!bApplied)
+    {
+        return;
+    }
+
+    if (IConsoleVariable* CVar = UPMFindStreamingCVar(TEXT("s.AsyncLoadingTimeLimit")))
+    {
+        CVar->Set(OriginalAsyncLoadingTimeLimit);
+    }
+    if (IConsoleVariable* CVar = UPMFindStreamingCVar(TEXT("s.LevelStreamingComponentsRegistrationGranularity")))
+    {
+        CVar->Set(OriginalRegistrationGranularity);
+    }
+    if (IConsoleVariable* CVar = UPMFindStreamingCVar(TEXT("s.AsyncLoadingUseFullTimeLimit")))
+    {
+        CVar->Set(OriginalUseFullTimeLimit);
+    }
+    bApplied = false;
+    AsyncLoadingTimeLimitMs = 0.0f;
+    StreamingDistanceScale = 1.0f;
+}
+
+void FUPMStreamingGovernor::FillMetrics(FUPMProcessMetrics& Metrics) const
+{
+    Metrics.PendingStreamingLevels = PendingLevels;
+    Metrics.AsyncLoadingPackages = AsyncPackages;
+    Metrics.StreamingFrameCostMs = StreamingFrameCostMs;
+    Metrics.StreamingBacklogSeconds = BacklogSeconds;
+    Metrics.AsyncLoadingTimeLimitMs = AsyncLoadingTimeLimitMs;
+    Metrics.StreamingDistanceScale = StreamingDistanceScale;
+}
@@ -0,0 +1,60 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Level streaming and async loading governor
+ *
+ * Watches the streaming levels of the game world, the packages in flight and the game thread time of frames in
+ * which a level registers its components. Behind a loading screen, async loading gets a large time slice and
+ * levels register in big steps. During play, async loading is held to the streaming budget and the registration
+ * granularity adapts so the extra game thread time of registering frames stays inside it.
+ *
+ * A backlog that keeps growing during play means the budget is too tight for how fast the player moves; it is
+ * reported, and the streaming distance scale (for the game's streaming sources) is lowered until it clears.
+ */
+class FUPMStreamingGovernor
+{
+public:
+    FUPMStreamingGovernor();
+
+    /** Game thread, once per frame */
+    void Tick(UWorld* World, bool bLoadingScreen, const FUPMPerformanceSettings& Settings);
+
+    /** Put the engine's own values back */
+    void Restore();
+
+    void FillMetrics(FUPMProcessMetrics& Metrics) const;
+
+    float GetStreamingDistanceScale() const { return StreamingDistanceScale; }
+
+private:
+    void Apply(bool bLoadingScreen, const FUPMPerformanceSettings& Settings, float DeltaTime);
+
+    // Engine values before the first change
+    bool bApplied;
+    float OriginalAsyncLoadingTimeLimit;
+    int32 OriginalRegistrationGranularity;
+    int32 OriginalUseFullTimeLimit;
+
+    // Gameplay registration granularity, adapted to the budget
+    int32 RegistrationGranularity;
+    int32 FramesSinceGranularityChange;
+
+    // Game thread time of frames without streaming work, and the excess of frames with it (ms, smoothed)
+    float BaselineGameThreadMs;
+    float StreamingFrameCostMs;
+
+    int32 PendingLevels;
+    int32 AsyncPackages;
+    bool bRegistering;
+    double BacklogStartTime;
+    float BacklogSeconds;
+    bool bBacklogReported;
+
+    float AsyncLoadingTimeLimitMs;
+    float StreamingDistanceScale;
+};
@@ -0,0 +1,194 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMTextureStreamingStats.h"
+#include "Engine/Texture2D.h"
+#include "ContentStreaming.h"
+#include "RHI.h"
+#include "UObject/UObjectHash.h"
+
+// Texture streaming telemetry tuning
+static const double UPMTexturePoolSampleSeconds = 1.0;  // Pool and budget numbers
+static const int32 UPMTexturesPerFrame = 512;           // Textures summed per frame in a pass
+static const double UPMTextureMinPassSeconds = 2.0;     // A pass starts at most this often
+
+static float UPMBytesToMB(int64 Bytes)
+{
+    return static_cast<float>(static_cast<double>(Bytes) / (1024.0 * 1024.0));
+}
+
+FUPMTextureStreamingStats::FUPMTextureStreamingStats()
+    : NextPoolSampleTime(0.0)
+    , PassIndex(0)
+    , PassStartTime(0.0)
+    , PassResidentBytes(0)
+    , PassPendingBytes(0)
+    , PassStreamedInBytes(0)
+    , PassResidentMips(0)
+    , PassRequestedMips(0)
+    , PassTexturesMissingMips(0)
+    , PoolSizeMB(0.0f)
+    , StreamingUsedMB(0.0f)
+    , NonStreamingUsedMB(0.0f)
+    , WantedMB(0.0f)
+    , OverBudgetMB(0.0f)
+    , PendingRequests(0)
+    , ResidentMB(0.0f)
+    , PendingMB(0.0f)
+    , ResidentMips(0)
+    , RequestedMips(0)
+    , TexturesMissingMips(0)
+    , StreamingMBPerSecond(0.0f)
+{
+}
+
+void FUPMTextureStreamingStats::Tick(float DeltaTime, bool bSampleTextures)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now >= NextPoolSampleTime)
+    {
+        NextPoolSampleTime = Now + UPMTexturePoolSampleSeconds;
+        SamplePool();
+    }
+
+    // The passes walk every texture object, so they are opt-in
+    if (!bSampleTextures || !IStreamingManager::Get().IsTextureStreamingEnabled())
+    {
+        ResetTextureStats();
+        return;
+    }
+
+    // Next pass: snapshot the textures, they are summed over the following frames
+    if (PassIndex >= PassTextures.Num())
+    {
+        if (Now - PassStartTime < UPMTextureMinPassSeconds)
+        {
+            return;
+        }
+
+        TArray<UObject*> Textures;
+        GetObjectsOfClass(UTexture2D::StaticClass(), Textures, false);
+        PassTextures.Reset(Textures.Num());
+        for (UObject* Texture : Textures)
+        {
+            PassTextures.Add(CastChecked<UTexture2D>(Texture));
+        }
+        PassIndex = 0;
+        PassStartTime = Now;
+        PassResidentBytes = PassPendingBytes = PassStreamedInBytes = 0;
+        PassResidentMips = PassRequestedMips = PassTexturesMissingMips = 0;
+    }
+
+    const int32 EndIndex = FMath::Min(PassIndex + UPMTexturesPerFrame, PassTextures.Num());
+    for (; PassIndex < EndIndex; ++PassIndex)
+    {
+        const UTexture2D* Texture = PassTextures[PassIndex].Get();
+        if (!Texture || !Texture->IsStreamable())
+        {
+            continue;
+        }
+
+        const int32 Resident = Texture->GetNumResidentMips();
+        const int32 Requested = Texture->GetNumRequestedMips();
+        const int64 ResidentBytes = Texture->CalcTextureMemorySize(Resident);
+        PassResidentBytes += ResidentBytes;
+        PassResidentMips += Resident;
+        PassRequestedMips += Requested;
+        if (Requested > Resident)
+        {
+            PassPendingBytes += Texture->CalcTextureMemorySize(Requested) - ResidentBytes;
+            ++PassTexturesMissingMips;
+        }
+
+        int32& LastResident = LastResidentMips.FindOrAdd(FObjectKey(Texture), Resident);
+        if (Resident > LastResident)
+        {
+            PassStreamedInBytes += ResidentBytes - Texture->CalcTextureMemorySize(LastResident);
+        }
+        LastResident = Resident;
+    }
+
+    if (PassIndex >= PassTextures.Num())
+    {
+        FinishPass();
+    }
+}
+
+void FUPMTextureStreamingStats::SamplePool()
+{
+    FTextureMemoryStats MemoryStats;
+    RHIGetTextureMemoryStats(MemoryStats);
+    StreamingUsedMB = UPMBytesToMB(MemoryStats.StreamingMemorySize);
+    NonStreamingUsedMB = UPMBytesToMB(MemoryStats.NonStreamingMemorySize);
+
+    if (IStreamingManager::Get().IsTextureStreamingEnabled())
+    {
+        const ITextureStreamingManager& TextureStreaming = IStreamingManager::Get().GetTextureStreamingManager();
+        PoolSizeMB = UPMBytesToMB(TextureStreaming.GetPoolSize());
+        WantedMB = UPMBytesToMB(TextureStreaming.GetRequiredPoolSize());
+        OverBudgetMB = UPMBytesToMB(TextureStreaming.GetMemoryOverBudget());
+        PendingRequests = TextureStreaming.GetNumWantingResources();
+    }
+    else
+    {
+        PoolSizeMB = UPMBytesToMB(MemoryStats.TexturePoolSize);
+    }
+}
+
+void FUPMTextureStreamingStats::FinishPass()
+{
+    const double PassSeconds = FPlatformTime::Seconds() - PassStartTime;
+    ResidentMB = UPMBytesToMB(PassResidentBytes);
+    PendingMB = UPMBytesToMB(PassPendingBytes);
+    ResidentMips = PassResidentMips;
+    RequestedMips = PassRequestedMips;
+    TexturesMissingMips = PassTexturesMissingMips;
+
+    // Between two passes; the first pass only fills LastResidentMips
+    StreamingMBPerSecond = PassSeconds > 0.0 ? UPMBytesToMB(PassStreamedInBytes) / FMath::Max(static_cast<float>(PassSeconds), static_cast<float>(UPMTextureMinPassSeconds)) : 0.0f;
+
+    // Forget textures that were destroyed
+    for (auto It = LastResidentMips.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+    PassTextures.Reset();
+    PassIndex = 0;
+}
+
+void FUPMTextureStreamingStats::ResetTextureStats()
+{
+    if (PassTextures.Num() == 0 && LastResidentMips.Num() == 0)
+    {
+        return;
+    }
+
+    PassTextures.Empty();
+    PassIndex = 0;
+    PassStartTime = 0.0;
+    LastResidentMips.Empty();
+    ResidentMB = 0.0f;
+    PendingMB = 0.0f;
+    ResidentMips = 0;
+    RequestedMips = 0;
+    TexturesMissingMips = 0;
+    StreamingMBPerSecond = 0.0f;
+}
+
+void FUPMTextureStreamingStats::FillMetrics(FUPMProcessMetrics& Metrics) const
+{
+    Metrics.TexturePoolSizeMB = PoolSizeMB;
+    Metrics.TextureStreamingUsedMB = StreamingUsedMB;
+    Metrics.TextureNonStreamingMB = NonStreamingUsedMB;
+    Metrics.TextureWantedMB = WantedMB;
+    Metrics.TextureOverBudgetMB = OverBudgetMB;
+    Metrics.TextureResidentMB = ResidentMB;
+    Metrics.TexturePendingMB = PendingMB;
+    Metrics.TextureResidentMips = ResidentMips;
+    Metrics.TextureRequestedMips = RequestedMips;
+    Metrics.TexturesMissingMips = TexturesMissingMips;
+    Metrics.TextureStreamingRequests = PendingRequests;
+    Metrics.TextureStreamingMBPerSecond = StreamingMBPerSecond;
+}
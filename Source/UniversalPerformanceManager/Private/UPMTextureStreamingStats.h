@@ -0,0 +1,63 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UPMSettingsManager.h"
+
+class UTexture2D;
+
+/**
+ * Texture streaming telemetry
+ *
+ * Pool size, usage and over-budget come from the RHI and the streaming manager once per interval. Resident
+ * versus requested mips and the bytes still to stream in are summed over the streamable textures a slice per
+ * frame, so a full pass costs nothing noticeable; the bytes that became resident between passes give the
+ * streaming I/O rate. The pass over the textures only runs while Debug.bEnableTextureStreamingStats is set.
+ */
+class FUPMTextureStreamingStats
+{
+public:
+    FUPMTextureStreamingStats();
+
+    /** Game thread, once per frame; bSampleTextures runs the passes over the textures */
+    void Tick(float DeltaTime, bool bSampleTextures);
+
+    void FillMetrics(FUPMProcessMetrics& Metrics) const;
+
+private:
+    void SamplePool();
+    void FinishPass();
+    void ResetTextureStats();
+
+    double NextPoolSampleTime;
+
+    // Time-sliced pass over the textures
+    TArray<TWeakObjectPtr<UTexture2D>> PassTextures;
+    int32 PassIndex;
+    double PassStartTime;
+    int64 PassResidentBytes;
+    int64 PassPendingBytes;
+    int64 PassStreamedInBytes;
+    int32 PassResidentMips;
+    int32 PassRequestedMips;
+    int32 PassTexturesMissingMips;
+
+    // Resident mips of each texture at the previous pass
+    TMap<FObjectKey, int32> LastResidentMips;
+
+    // Published values
+    float PoolSizeMB;
+    float StreamingUsedMB;
+    float NonStreamingUsedMB;
+    float WantedMB;
+    float OverBudgetMB;
+    int32 PendingRequests;
+    float ResidentMB;
+    float PendingMB;
+    int32 ResidentMips;
+    int32 RequestedMips;
+    int32 TexturesMissingMips;
+    float StreamingMBPerSecond;
+};
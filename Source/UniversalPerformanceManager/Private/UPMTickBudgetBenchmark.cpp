@@ -0,0 +1,224 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMTickBudgetBenchmark.h"
+#include "UPMTickBudgetSubsystem.h"
+#include "UPMTickProfiler.h"
+#include "UPMSettingsManager.h"
+#include "UPMStatistics.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Json.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// ==================== Load Actor ====================
+
+AUPMTickBudgetLoadActor::AUPMTickBudgetLoadActor()
+    : WorkIterations(2000)
+    , WorkState(0.0f)
+{
+    PrimaryActorTick.bCanEverTick = true;
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void AUPMTickBudgetLoadActor::Tick(float DeltaTime)
+{
+    UPM_TICK_SCOPE();
+    Super::Tick(DeltaTime);
+
+    // Stand-in for gameplay logic; the result is kept so the loop cannot be optimized away
+    float State = WorkState + DeltaTime;
+    for (int32 Iteration = 0; Iteration < WorkIterations; ++Iteration)
+    {
+        State = FMath::Sin(State + Iteration * 0.001f);
+    }
+    WorkState = State;
+}
+
+// ==================== Benchmark ====================
+
+AUPMTickBudgetBenchmark::AUPMTickBudgetBenchmark()
+    : NumActors(2000)
+    , GridSpacing(400.0f)
+    , WorkIterations(2000)
+    , WarmupDuration(3.0f)
+    , PhaseDuration(15.0f)
+    , bExitWhenFinished(false)
+    , Phase(EPhase::Warmup)
+    , PhaseTime(0.0f)
+    , bTickBudgetWasEnabled(false)
+    , PeakThrottledActors(0)
+{
+    PrimaryActorTick.bCanEverTick = true;
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+    // The benchmark itself must not be throttled
+    Tags.Add(UUPMTickBudgetSubsystem::NoThrottleTag);
+}
+
+void AUPMTickBudgetBenchmark::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this))
+    {
+        bTickBudgetWasEnabled = Manager->GetPerformanceSettings().bEnableTickBudget;
+    }
+
+    SpawnLoadActors();
+    EnterPhase(EPhase::Warmup);
+}
+
+void AUPMTickBudgetBenchmark::SpawnLoadActors()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumActors)));
+    const FVector Origin = GetActorLocation() - FVector(GridSize * GridSpacing * 0.5f, GridSize * GridSpacing * 0.5f, 0.0f);
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    for (int32 Index = 0; Index < NumActors; ++Index)
+    {
+        const FVector Location = Origin + FVector((Index % GridSize) * GridSpacing, (Index / GridSize) * GridSpacing, 0.0f);
+        if (AUPMTickBudgetLoadActor* LoadActor = World->SpawnActor<AUPMTickBudgetLoadActor>(Location, FRotator::ZeroRotator, SpawnParameters))
+        {
+            LoadActor->WorkIterations = WorkIterations;
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Tick budget benchmark spawned %d load actors"), NumActors);
+}
+
+void AUPMTickBudgetBenchmark::EnterPhase(EPhase NewPhase)
+{
+    Phase = NewPhase;
+    PhaseTime = 0.0f;
+
+    UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this);
+    if (!Manager)
+    {
+        return;
+    }
+
+    switch (Phase)
+    {
+    case EPhase::Warmup:
+    case EPhase::Baseline:
+        Manager->SetTickBudgetEnabled(false);
+        break;
+    case EPhase::Throttled:
+        Manager->SetTickBudgetEnabled(true);
+        break;
+    case EPhase::Finished:
+        Manager->SetTickBudgetEnabled(bTickBudgetWasEnabled);
+        break;
+    }
+}
+
+void AUPMTickBudgetBenchmark::Tick(float DeltaTime)
+{
+    UPM_TICK_SCOPE();
+    Super::Tick(DeltaTime);
+
+    if (Phase == EPhase::Finished)
+    {
+        return;
+    }
+
+    PhaseTime += DeltaTime;
+
+    const UUPMTickBudgetSubsystem* TickBudget = GetWorld()->GetSubsystem<UUPMTickBudgetSubsystem>();
+    const float WorldTickMs = TickBudget ? TickBudget->GetLastWorldTickTimeMs() : 0.0f;
+
+    switch (Phase)
+    {
+    case EPhase::Warmup:
+        if (PhaseTime >= WarmupDuration)
+        {
+            EnterPhase(EPhase::Baseline);
+        }
+        break;
+
+    case EPhase::Baseline:
+        BaselineFrameTimes.Add(DeltaTime * 1000.0f);
+        BaselineWorldTickTimes.Add(WorldTickMs);
+        if (PhaseTime >= PhaseDuration)
+        {
+            EnterPhase(EPhase::Throttled);
+        }
+        break;
+
+    case EPhase::Throttled:
+        // The first second is the controller converging, not the steady state
+        if (PhaseTime >= 1.0f)
+        {
+            ThrottledFrameTimes.Add(DeltaTime * 1000.0f);
+            ThrottledWorldTickTimes.Add(WorldTickMs);
+            PeakThrottledActors = FMath::Max(PeakThrottledActors, TickBudget ? TickBudget->GetThrottledActorCount() : 0);
+        }
+        if (PhaseTime >= PhaseDuration + 1.0f)
+        {
+            EnterPhase(EPhase::Finished);
+            ReportResults();
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void AUPMTickBudgetBenchmark::ReportResults()
+{
+    const UUPMTickBudgetSubsystem* TickBudget = GetWorld()->GetSubsystem<UUPMTickBudgetSubsystem>();
+    const float BudgetMs = TickBudget ? TickBudget->GetTickBudgetMs() : 0.0f;
+
+    auto MakePhaseObject = [](const TArray<float>& FrameTimes, const TArray<float>& WorldTickTimes)
+    {
+        TSharedPtr<FJsonObject> PhaseObject = MakeShareable(new FJsonObject);
+        PhaseObject->SetNumberField("Frames", FrameTimes.Num());
+        PhaseObject->SetNumberField("FrameTimeMeanMs", FUPMStatistics::Mean(FrameTimes));
+        PhaseObject->SetNumberField("FrameTimeP95Ms", FUPMStatistics::Percentile(FrameTimes, 95.0f));
+        PhaseObject->SetNumberField("WorldTickMeanMs", FUPMStatistics::Mean(WorldTickTimes));
+        PhaseObject->SetNumberField("WorldTickP95Ms", FUPMStatistics::Percentile(WorldTickTimes, 95.0f));
+        return PhaseObject;
+    };
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetNumberField("Actors", NumActors);
+    RootObject->SetNumberField("WorkIterations", WorkIterations);
+    RootObject->SetNumberField("TickBudgetMs", BudgetMs);
+    RootObject->SetNumberField("PeakThrottledActors", PeakThrottledActors);
+    RootObject->SetObjectField("Baseline", MakePhaseObject(BaselineFrameTimes, BaselineWorldTickTimes));
+    RootObject->SetObjectField("Throttled", MakePhaseObject(ThrottledFrameTimes, ThrottledWorldTickTimes));
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Tick budget benchmark (%d actors, budget %.2f ms)"), NumActors, BudgetMs);
+    UE_LOG(LogTemp, Log, TEXT("UPM:   Baseline  world tick mean %.2f ms, P95 %.2f ms, frame mean %.2f ms"),
+        FUPMStatistics::Mean(BaselineWorldTickTimes), FUPMStatistics::Percentile(BaselineWorldTickTimes, 95.0f),
+        FUPMStatistics::Mean(BaselineFrameTimes));
+    UE_LOG(LogTemp, Log, TEXT("UPM:   Throttled world tick mean %.2f ms, P95 %.2f ms, frame mean %.2f ms, up to %d actors throttled"),
+        FUPMStatistics::Mean(ThrottledWorldTickTimes), FUPMStatistics::Percentile(ThrottledWorldTickTimes, 95.0f),
+        FUPMStatistics::Mean(ThrottledFrameTimes), PeakThrottledActors);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer))
+    {
+        const FString FilePath = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("TickBudgetBenchmark.json");
+        if (!FFileHelper::SaveStringToFile(OutputString, *FilePath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write benchmark results to file: %s"), *FilePath);
+        }
+    }
+
+    if (bExitWhenFinished)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
@@ -0,0 +1,556 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMTickBudgetSubsystem.h"
+#include "UPMTickBudgetBenchmark.h"
+#include "UPMTickProfiler.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/ActorComponent.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+const FName UUPMTickBudgetSubsystem::NoThrottleTag(TEXT("UPM.NoThrottle"));
+
+// Scheduler tuning
+static const int32 UPMMinActorsPerFrame = 128;
+static const int32 UPMFramesPerSignificancePass = 10;
+static const float UPMControlInterval = 0.1f;
+static const float UPMThrottleGain = 0.1f;
+static const float UPMThrottleSetpoint = 0.9f;         // Aim slightly below the budget
+static const float UPMWorldTickSmoothing = 0.1f;
+static const float UPMIntervalChangeThreshold = 0.1f;  // Relative change before an interval is touched again
+static const float UPMVisibleSignificance = 0.3f;
+static const float UPMBehindViewerFactor = 0.5f;
+
+UUPMTickBudgetSubsystem::UUPMTickBudgetSubsystem()
+    : NextActorIndex(0)
+    , ThrottledActorCount(0)
+    , WorldTickStartTime(0.0)
+    , LastWorldTickMs(0.0f)
+    , SmoothedWorldTickMs(0.0f)
+    , ThrottleLevel(0.0f)
+    , ControlAccumulator(0.0f)
+{
+}
+
+bool UUPMTickBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UUPMTickBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UUPMTickBudgetSubsystem::OnLevelAdded);
+    TickStartHandle = FWorldDelegates::OnWorldTickStart.AddUObject(this, &UUPMTickBudgetSubsystem::OnWorldTickStart);
+    PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UUPMTickBudgetSubsystem::OnWorldPostActorTick);
+}
+
+void UUPMTickBudgetSubsystem::Deinitialize()
+{
+    StopManaging();
+
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    FWorldDelegates::OnWorldTickStart.Remove(TickStartHandle);
+    FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+    Super::Deinitialize();
+}
+
+void UUPMTickBudgetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // The manager pushes later changes; pull the current settings once the world is ready
+    if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(&InWorld))
+    {
+        FUPMPerformanceSettings PerformanceSettings = Manager->GetPerformanceSettings();
+        PerformanceSettings.FrameRateLimit = Manager->GetFrameRateTarget();
+        SetSettings(PerformanceSettings);
+    }
+
+    if (Settings.bEnableTickBudget)
+    {
+        StartManaging();
+    }
+
+    SpawnBenchmarkFromCommandLine();
+}
+
+TStatId UUPMTickBudgetSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UUPMTickBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UUPMTickBudgetSubsystem::SetSettings(const FUPMPerformanceSettings& InSettings)
+{
+    const bool bWasEnabled = Settings.bEnableTickBudget;
+    Settings = InSettings;
+
+    const UWorld* World = GetWorld();
+    if (!bWasEnabled && Settings.bEnableTickBudget && World && World->HasBegunPlay())
+    {
+        StartManaging();
+    }
+    else if (bWasEnabled && !Settings.bEnableTickBudget)
+    {
+        StopManaging();
+        ThrottleLevel = 0.0f;
+    }
+}
+
+float UUPMTickBudgetSubsystem::GetTickBudgetMs() const
+{
+    const float TargetFrameRate = Settings.FrameRateLimit > 0.0f ? Settings.FrameRateLimit : 60.0f;
+    return 1000.0f / TargetFrameRate * FMath::Clamp(Settings.TickBudgetFraction, 0.1f, 0.9f);
+}
+
+void UUPMTickBudgetSubsystem::SetActorExempt(AActor* Actor, bool bExempt)
+{
+    if (!Actor)
+    {
+        return;
+    }
+
+    if (bExempt)
+    {
+        Actor->Tags.AddUnique(NoThrottleTag);
+        for (FManagedActor& Managed : ManagedActors)
+        {
+            if (Managed.Actor.Get() == Actor)
+            {
+                RestoreActor(Managed);
+                break;
+            }
+        }
+    }
+    else
+    {
+        Actor->Tags.Remove(NoThrottleTag);
+    }
+}
+
+// ==================== Registration ====================
+
+void UUPMTickBudgetSubsystem::StartManaging()
+{
+    UWorld* World = GetWorld();
+    if (!World || ActorSpawnedHandle.IsValid())
+    {
+        return;
+    }
+
+    for (ULevel* Level : World->GetLevels())
+    {
+        RegisterLevel(Level);
+    }
+
+    ActorSpawnedHandle = World->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(this, &UUPMTickBudgetSubsystem::OnActorSpawned));
+}
+
+void UUPMTickBudgetSubsystem::StopManaging()
+{
+    RestoreAll();
+
+    if (UWorld* World = GetWorld())
+    {
+        World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    }
+    ActorSpawnedHandle.Reset();
+
+    ManagedActors.Empty();
+    RegisteredActors.Empty();
+    NextActorIndex = 0;
+    ThrottledActorCount = 0;
+}
+
+void UUPMTickBudgetSubsystem::OnLevelAdded(ULevel* Level, UWorld* InWorld)
+{
+    if (InWorld == GetWorld() && ActorSpawnedHandle.IsValid())
+    {
+        RegisterLevel(Level);
+    }
+}
+
+void UUPMTickBudgetSubsystem::OnActorSpawned(AActor* Actor)
+{
+    RegisterActor(Actor);
+}
+
+void UUPMTickBudgetSubsystem::RegisterLevel(ULevel* Level)
+{
+    if (!Level)
+    {
+        return;
+    }
+
+    for (AActor* Actor : Level->Actors)
+    {
+        RegisterActor(Actor);
+    }
+}
+
+void UUPMTickBudgetSubsystem::RegisterActor(AActor* Actor)
+{
+    // Controllers and info actors (game mode, game state, player states) drive gameplay, never throttle them
+    if (!IsValid(Actor) || Actor->IsActorBeingDestroyed() || Actor->IsA<AController>() || Actor->IsA<AInfo>())
+    {
+        return;
+    }
+
+    if (RegisteredActors.Contains(Actor))
+    {
+        return;
+    }
+
+    FManagedActor Managed;
+    Managed.Actor = Actor;
+    Managed.OriginalInterval = Actor->GetActorTickInterval();
+    Managed.AppliedInterval = Managed.OriginalInterval;
+
+    Actor->ForEachComponent(false, [&Managed](UActorComponent* Component)
+    {
+        if (Component->PrimaryComponentTick.bCanEverTick)
+        {
+            Managed.Components.Add({ Component, Component->GetComponentTickInterval() });
+        }
+    });
+
+    if (!Actor->PrimaryActorTick.bCanEverTick && Managed.Components.Num() == 0)
+    {
+        return;
+    }
+
+    RegisteredActors.Add(Actor);
+    ManagedActors.Add(MoveTemp(Managed));
+}
+
+// ==================== Measurement ====================
+
+void UUPMTickBudgetSubsystem::OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if (InWorld == GetWorld())
+    {
+        WorldTickStartTime = FPlatformTime::Seconds();
+    }
+}
+
+void UUPMTickBudgetSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds)
+{
+    if (InWorld == GetWorld() && WorldTickStartTime > 0.0)
+    {
+        LastWorldTickMs = static_cast<float>((FPlatformTime::Seconds() - WorldTickStartTime) * 1000.0);
+        SmoothedWorldTickMs = SmoothedWorldTickMs > 0.0f
+            ? FMath::Lerp(SmoothedWorldTickMs, LastWorldTickMs, UPMWorldTickSmoothing)
+            : LastWorldTickMs;
+        WorldTickStartTime = 0.0;
+    }
+}
+
+// ==================== Scheduling ====================
+
+void UUPMTickBudgetSubsystem::Tick(float DeltaTime)
+{
+    UPM_TICK_SCOPE();
+    Super::Tick(DeltaTime);
+
+    if (!Settings.bEnableTickBudget || ManagedActors.Num() == 0)
+    {
+        return;
+    }
+
+    UpdateThrottleLevel(DeltaTime);
+    GatherViewpoints();
+
+    // Significance is re-evaluated over several frames so the cost stays flat with thousands of actors
+    const int32 ActorsThisFrame = FMath::Min(ManagedActors.Num(),
+        FMath::Max(UPMMinActorsPerFrame, ManagedActors.Num() / UPMFramesPerSignificancePass));
+
+    for (int32 Processed = 0; Processed < ActorsThisFrame && ManagedActors.Num() > 0; ++Processed)
+    {
+        if (NextActorIndex >= ManagedActors.Num())
+        {
+            NextActorIndex = 0;
+        }
+
+        FManagedActor& Managed = ManagedActors[NextActorIndex];
+        AActor* Actor = Managed.Actor.Get();
+        if (!Actor || Actor->IsActorBeingDestroyed())
+        {
+            if (Managed.bThrottled)
+            {
+                ThrottledActorCount--;
+            }
+            RegisteredActors.Remove(Managed.Actor);
+            ManagedActors.RemoveAtSwap(NextActorIndex);
+            continue;
+        }
+
+        if (Actor->ActorHasTag(NoThrottleTag))
+        {
+            RestoreActor(Managed);
+        }
+        else
+        {
+            ApplyThrottle(Managed, ComputeSignificance(Actor));
+        }
+        NextActorIndex++;
+    }
+}
+
+void UUPMTickBudgetSubsystem::UpdateThrottleLevel(float DeltaTime)
+{
+    ControlAccumulator += DeltaTime;
+    if (ControlAccumulator < UPMControlInterval || SmoothedWorldTickMs <= 0.0f)
+    {
+        return;
+    }
+    ControlAccumulator = 0.0f;
+
+    // Proportional control: over budget raises the level quickly, headroom lowers it gradually
+    const float BudgetRatio = SmoothedWorldTickMs / GetTickBudgetMs();
+    ThrottleLevel = FMath::Clamp(ThrottleLevel + UPMThrottleGain * (BudgetRatio - UPMThrottleSetpoint), 0.0f, 1.0f);
+}
+
+void UUPMTickBudgetSubsystem::GatherViewpoints()
+{
+    Viewpoints.Reset();
+
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    // Servers have a controller per player, clients only their local ones
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (!PlayerController || (!PlayerController->IsLocalController() && !PlayerController->GetPawn()))
+        {
+            continue;
+        }
+
+        FVector Location;
+        FRotator Rotation;
+        PlayerController->GetPlayerViewPoint(Location, Rotation);
+        Viewpoints.Add({ Location, Rotation.Vector() });
+    }
+}
+
+float UUPMTickBudgetSubsystem::ComputeSignificance(const AActor* Actor) const
+{
+    // Relevance: anything a player owns, controls or always needs is fully significant
+    if (Actor->bAlwaysRelevant)
+    {
+        return 1.0f;
+    }
+
+    if (const APawn* Pawn = Cast<APawn>(Actor))
+    {
+        if (Pawn->IsPlayerControlled())
+        {
+            return 1.0f;
+        }
+    }
+
+    if (const AActor* Owner = Actor->GetOwner())
+    {
+        const APawn* OwnerPawn = Cast<APawn>(Owner);
+        if (Owner->IsA<APlayerController>() || (OwnerPawn && OwnerPawn->IsPlayerControlled()))
+        {
+            return 1.0f;
+        }
+    }
+
+    // Nobody is watching (e.g. an empty server): treat everything alike
+    if (Viewpoints.Num() == 0)
+    {
+        return 0.5f;
+    }
+
+    // Distance to the nearest viewer, halved behind the camera
+    const FVector Location = Actor->GetActorLocation();
+    const float MaxDistance = FMath::Max(Settings.SignificanceDistance, 100.0f);
+    float DistanceSignificance = 0.0f;
+
+    for (const FViewpoint& Viewpoint : Viewpoints)
+    {
+        const FVector ToActor = Location - Viewpoint.Location;
+        const float Distance = ToActor.Size();
+
+        float Significance = 1.0f - FMath::Clamp(Distance / MaxDistance, 0.0f, 1.0f);
+        if (Distance > KINDA_SMALL_NUMBER && FVector::DotProduct(ToActor / Distance, Viewpoint.Direction) < 0.0f)
+        {
+            Significance *= UPMBehindViewerFactor;
+        }
+        DistanceSignificance = FMath::Max(DistanceSignificance, Significance);
+    }
+
+    // Visibility
+    const float VisibleSignificance = Actor->WasRecentlyRendered(0.25f) ? UPMVisibleSignificance : 0.0f;
+
+    return FMath::Clamp(DistanceSignificance * (1.0f - UPMVisibleSignificance) + VisibleSignificance, 0.0f, 1.0f);
+}
+
+void UUPMTickBudgetSubsystem::ApplyThrottle(FManagedActor& Managed, float Significance)
+{
+    if (ThrottleLevel <= 0.0f || Significance >= ThrottleLevel)
+    {
+        RestoreActor(Managed);
+        return;
+    }
+
+    // Insignificant actors stop ticking once everything else has been throttled as far as it goes
+    const bool bDisable = Settings.bAllowTickDisable && ThrottleLevel >= 0.99f && Significance <= 0.01f;
+    SetManagedTickEnabled(Managed, !bDisable);
+
+    // The further below the throttle level, the closer to the maximum interval
+    const float ThrottleAmount = (ThrottleLevel - Significance) / ThrottleLevel;
+    const float MaxInterval = FMath::Max(Settings.MaxThrottledTickInterval, Managed.OriginalInterval);
+    SetManagedInterval(Managed, FMath::Lerp(Managed.OriginalInterval, MaxInterval, ThrottleAmount));
+
+    if (!Managed.bThrottled)
+    {
+        Managed.bThrottled = true;
+        ThrottledActorCount++;
+    }
+}
+
+void UUPMTickBudgetSubsystem::SetManagedInterval(FManagedActor& Managed, float Interval)
+{
+    const float Reference = FMath::Max(Managed.AppliedInterval, 1.0f / 60.0f);
+    if (FMath::Abs(Interval - Managed.AppliedInterval) < Reference * UPMIntervalChangeThreshold)
+    {
+        return;
+    }
+
+    Managed.AppliedInterval = Interval;
+
+    if (AActor* Actor = Managed.Actor.Get())
+    {
+        Actor->SetActorTickInterval(Interval);
+    }
+
+    for (const FManagedComponent& ManagedComponent : Managed.Components)
+    {
+        if (UActorComponent* Component = ManagedComponent.Component.Get())
+        {
+            Component->SetComponentTickInterval(FMath::Max(Interval, ManagedComponent.OriginalInterval));
+        }
+    }
+}
+
+void UUPMTickBudgetSubsystem::SetManagedTickEnabled(FManagedActor& Managed, bool bEnabled)
+{
+    if (Managed.bTickDisabled == !bEnabled)
+    {
+        return;
+    }
+
+    Managed.bTickDisabled = !bEnabled;
+
+    // Remember what ticked when disabling, and only turn that back on
+    if (AActor* Actor = Managed.Actor.Get())
+    {
+        if (!bEnabled)
+        {
+            Managed.bWasTickEnabled = Actor->IsActorTickEnabled();
+        }
+        if (Actor->PrimaryActorTick.bCanEverTick && Managed.bWasTickEnabled)
+        {
+            Actor->SetActorTickEnabled(bEnabled);
+        }
+    }
+
+    for (FManagedComponent& ManagedComponent : Managed.Components)
+    {
+        if (UActorComponent* Component = ManagedComponent.Component.Get())
+        {
+            if (!bEnabled)
+            {
+                ManagedComponent.bWasTickEnabled = Component->IsComponentTickEnabled();
+            }
+            if (ManagedComponent.bWasTickEnabled)
+            {
+                Component->SetComponentTickEnabled(bEnabled);
+            }
+        }
+    }
+}
+
+void UUPMTickBudgetSubsystem::RestoreActor(FManagedActor& Managed)
+{
+    if (!Managed.bThrottled)
+    {
+        return;
+    }
+
+    SetManagedTickEnabled(Managed, true);
+
+    Managed.AppliedInterval = Managed.OriginalInterval;
+    if (AActor* Actor = Managed.Actor.Get())
+    {
+        Actor->SetActorTickInterval(Managed.OriginalInterval);
+    }
+
+    for (const FManagedComponent& ManagedComponent : Managed.Components)
+    {
+        if (UActorComponent* Component = ManagedComponent.Component.Get())
+        {
+            Component->SetComponentTickInterval(ManagedComponent.OriginalInterval);
+        }
+    }
+
+    Managed.bThrottled = false;
+    ThrottledActorCount--;
+}
+
+void UUPMTickBudgetSubsystem::RestoreAll()
+{
+    for (FManagedActor& Managed : ManagedActors)
+    {
+        RestoreActor(Managed);
+    }
+}
+
+// ==================== Benchmark ====================
+
+void UUPMTickBudgetSubsystem::SpawnBenchmarkFromCommandLine()
+{
+    // -UPMTickBudgetBenchmark=<ActorCount> turns any map (e.g. /Engine/Maps/Entry with -nullrhi) into the benchmark
+    static bool bBenchmarkSpawned = false;
+
+    UWorld* World = GetWorld();
+    if (!World || World->GetNetMode() == NM_Client)
+    {
+        return;
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParameters.bDeferConstruction = true;
+
+    int32 ActorCount = 0;
+    if (!bBenchmarkSpawned && FParse::Value(FCommandLine::Get(), TEXT("UPMTickBudgetBenchmark="), ActorCount) && ActorCount > 0)
+    {
+        bBenchmarkSpawned = true;
+
+        AUPMTickBudgetBenchmark* Benchmark = World->SpawnActor<AUPMTickBudgetBenchmark>(
+            AUPMTickBudgetBenchmark::StaticClass(), FTransform::Identity, SpawnParameters);
+        if (Benchmark)
+        {
+            Benchmark->NumActors = ActorCount;
+            Benchmark->bExitWhenFinished = true;
+            Benchmark->FinishSpawning(FTransform::Identity);
+        }
+    }
+}
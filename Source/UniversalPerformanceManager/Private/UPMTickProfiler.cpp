@@ -0,0 +1,252 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMTickProfiler.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/ScopeLock.h"
+
+std::atomic<bool> GUPMTickProfilerEnabled(false);
+
+static thread_local void* GUPMTickThreadTable = nullptr;
+static thread_local uint32 GUPMTickThreadTableGeneration = 0;
+
+static const double UPMTickProfilerWindowSeconds = 1.0;
+
+FUPMTickProfiler& FUPMTickProfiler::Get()
+{
+    static FUPMTickProfiler Profiler;
+    return Profiler;
+}
+
+FUPMTickProfiler::FUPMTickProfiler()
+    : TablesGeneration(1)
+    , FrameParity(0)
+    , WindowFrames(0)
+    , WindowStartTime(0.0)
+    , WindowSerial(0)
+{
+}
+
+void FUPMTickProfiler::SetEnabled(bool bEnabled)
+{
+    check(IsInGameThread());
+
+    if (bEnabled == IsEnabled())
+    {
+        return;
+    }
+
+    if (bEnabled)
+    {
+        Reset();
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FUPMTickProfiler::OnEndFrame);
+        if (!PreExitHandle.IsValid())
+        {
+            PreExitHandle = FCoreDelegates::OnEnginePreExit.AddRaw(this, &FUPMTickProfiler::Shutdown);
+        }
+    }
+    else
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+    }
+
+    GUPMTickProfilerEnabled.store(bEnabled, std::memory_order_relaxed);
+    UE_LOG(LogTemp, Log, TEXT("UPM: Tick profiler %s"), bEnabled ? TEXT("enabled") : TEXT("disabled"));
+}
+
+FUPMTickProfiler::FThreadTable& FUPMTickProfiler::GetThreadTable()
+{
+    const uint32 Generation = TablesGeneration.load(std::memory_order_acquire);
+    if (!GUPMTickThreadTable || GUPMTickThreadTableGeneration != Generation)
+    {
+        // First tick recorded on this thread: register its table (the only locked path)
+        FThreadTable* Table = new FThreadTable();
+        {
+            FScopeLock Lock(&TablesLock);
+            ThreadTables.Emplace(Table);
+        }
+        GUPMTickThreadTable = Table;
+        GUPMTickThreadTableGeneration = Generation;
+    }
+    return *static_cast<FThreadTable*>(GUPMTickThreadTable);
+}
+
+void FUPMTickProfiler::RecordTick(const UClass* Class, uint64 Cycles)
+{
+    if (!Class)
+    {
+        return;
+    }
+
+    FThreadTable& Table = GetThreadTable();
+
+    // Announce the buffer before writing and check the frame did not flip in between; OnEndFrame flips first
+    // and then waits for writers of the old buffer, so one of the two always sees the other
+    uint32 Parity;
+    do
+    {
+        Parity = FrameParity.load(std::memory_order_seq_cst);
+        Table.WriterState.store(Parity + 1, std::memory_order_seq_cst);
+    }
+    while (FrameParity.load(std::memory_order_seq_cst) != Parity);
+
+    FClassAccumulator& Accumulator = Table.Frames[Parity].FindOrAdd(Class->GetFName());
+    Accumulator.Cycles += Cycles;
+    Accumulator.Count++;
+
+    Table.WriterState.store(0, std::memory_order_release);
+}
+
+uint32 FUPMTickProfiler::FlipAndDrainBuffer()
+{
+    // Game thread with TablesLock held
+    const uint32 DrainParity = FrameParity.load(std::memory_order_relaxed);
+    FrameParity.store(DrainParity ^ 1, std::memory_order_seq_cst);
+
+    for (const TUniquePtr<FThreadTable>& Table : ThreadTables)
+    {
+        while (Table->WriterState.load(std::memory_order_seq_cst) == DrainParity + 1)
+        {
+            FPlatformProcess::YieldThread();
+        }
+    }
+    return DrainParity;
+}
+
+void FUPMTickProfiler::OnEndFrame()
+{
+    // Flip writers to the other buffer, then merge this one once no late writer is still in it
+    TMap<FName, FClassAccumulator> FrameTotals;
+    {
+        FScopeLock Lock(&TablesLock);
+        const uint32 MergeParity = FlipAndDrainBuffer();
+        for (const TUniquePtr<FThreadTable>& Table : ThreadTables)
+        {
+            TMap<FName, FClassAccumulator>& Frame = Table->Frames[MergeParity];
+            for (const TPair<FName, FClassAccumulator>& Pair : Frame)
+            {
+                FClassAccumulator& Total = FrameTotals.FindOrAdd(Pair.Key);
+                Total.Cycles += Pair.Value.Cycles;
+                Total.Count += Pair.Value.Count;
+            }
+            Frame.Reset();
+        }
+    }
+
+    for (const TPair<FName, FClassAccumulator>& Pair : FrameTotals)
+    {
+        const double FrameMs = FPlatformTime::ToMilliseconds64(Pair.Value.Cycles);
+        FWindowAccumulator& Window = WindowTotals.FindOrAdd(Pair.Key);
+        Window.TotalMs += FrameMs;
+        Window.PeakFrameMs = FMath::Max(Window.PeakFrameMs, FrameMs);
+        Window.Count += Pair.Value.Count;
+    }
+    WindowFrames++;
+
+    const double Now = FPlatformTime::Seconds();
+    if (WindowStartTime == 0.0)
+    {
+        WindowStartTime = Now;
+    }
+    else if (Now - WindowStartTime >= UPMTickProfilerWindowSeconds)
+    {
+        PublishWindow();
+        WindowStartTime = Now;
+    }
+}
+
+void FUPMTickProfiler::PublishWindow()
+{
+    PublishedEntries.Reset(WindowTotals.Num());
+
+    for (const TPair<FName, FWindowAccumulator>& Pair : WindowTotals)
+    {
+        FUPMTickCostEntry& Entry = PublishedEntries.AddDefaulted_GetRef();
+        Entry.ClassName = Pair.Key.ToString();
+        Entry.AverageTimeMs = static_cast<float>(Pair.Value.TotalMs / FMath::Max(1u, WindowFrames));
+        Entry.PeakTimeMs = static_cast<float>(Pair.Value.PeakFrameMs);
+        Entry.TicksPerFrame = static_cast<float>(Pair.Value.Count) / FMath::Max(1u, WindowFrames);
+    }
+
+    PublishedEntries.Sort([](const FUPMTickCostEntry& A, const FUPMTickCostEntry& B)
+    {
+        return A.AverageTimeMs > B.AverageTimeMs;
+    });
+
+    WindowTotals.Reset();
+    WindowFrames = 0;
+    WindowSerial++;
+}
+
+void FUPMTickProfiler::GetTopEntries(int32 MaxEntries, TArray<FUPMTickCostEntry>& OutEntries) const
+{
+    const int32 NumEntries = FMath::Min(MaxEntries, PublishedEntries.Num());
+    OutEntries.Reset(NumEntries);
+    OutEntries.Append(PublishedEntries.GetData(), NumEntries);
+}
+
+void FUPMTickProfiler::DumpReport(FOutputDevice& Ar, int32 MaxEntries) const
+{
+    Ar.Logf(TEXT("UPM: Tick cost report (%d classes, averages per frame over the last window)"), PublishedEntries.Num());
+    Ar.Logf(TEXT("%-48s %10s %10s %10s"), TEXT("Class"), TEXT("Avg ms"), TEXT("Peak ms"), TEXT("Ticks"));
+
+    const int32 NumEntries = FMath::Min(MaxEntries, PublishedEntries.Num());
+    for (int32 Index = 0; Index < NumEntries; ++Index)
+    {
+        const FUPMTickCostEntry& Entry = PublishedEntries[Index];
+        Ar.Logf(TEXT("%-48s %10.3f %10.3f %10.1f"), *Entry.ClassName, Entry.AverageTimeMs, Entry.PeakTimeMs, Entry.TicksPerFrame);
+    }
+}
+
+bool FUPMTickProfiler::WriteReport(const FString& FilePath) const
+{
+    FString Csv = TEXT("Class,AverageTimeMs,PeakTimeMs,TicksPerFrame\n");
+    for (const FUPMTickCostEntry& Entry : PublishedEntries)
+    {
+        Csv += FString::Printf(TEXT("%s,%.4f,%.4f,%.2f\n"), *Entry.ClassName, Entry.AverageTimeMs, Entry.PeakTimeMs, Entry.TicksPerFrame);
+    }
+    return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+void FUPMTickProfiler::Shutdown()
+{
+    FCoreDelegates::OnEnginePreExit.Remove(PreExitHandle);
+    PreExitHandle.Reset();
+    SetEnabled(false);
+
+    FScopeLock Lock(&TablesLock);
+    for (const TUniquePtr<FThreadTable>& Table : ThreadTables)
+    {
+        while (Table->WriterState.load(std::memory_order_acquire) != 0)
+        {
+            FPlatformProcess::YieldThread();
+        }
+    }
+    ThreadTables.Empty();
+    TablesGeneration.fetch_add(1, std::memory_order_release);
+}
+
+void FUPMTickProfiler::Reset()
+{
+    check(IsInGameThread());
+
+    // Ticks may still be recording on worker threads: drain each buffer the same way the merge does before
+    // clearing it
+    {
+        FScopeLock Lock(&TablesLock);
+        for (int32 Buffer = 0; Buffer < 2; ++Buffer)
+        {
+            const uint32 ClearParity = FlipAndDrainBuffer();
+            for (const TUniquePtr<FThreadTable>& Table : ThreadTables)
+            {
+                Table->Frames[ClearParity].Reset();
+            }
+        }
+    }
+
+    WindowTotals.Reset();
+    WindowFrames = 0;
+    WindowStartTime = 0.0;
+    PublishedEntries.Reset();
+}
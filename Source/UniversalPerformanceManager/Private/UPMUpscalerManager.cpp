@@ -0,0 +1,226 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMUpscalerManager.h"
+#include "RHI.h"
+#include "RenderCore.h"
+#include "Interfaces/IPluginManager.h"
+
+// Upscaler tuning
+static const int32 UPMUpscalerSettleFrames = 60;       // Frames after a switch before frame times count
+static const float UPMUpscalerMaxSampleSeconds = 0.25f; // Longer frames (loads, hitches) are not averaged
+
+// Screen percentage of each quality mode but Custom, the common ratios of DLSS, FSR and XeSS
+static const float UPMUpscalingScreenPercentages[] = { 100.0f, 66.7f, 58.0f, 50.0f, 33.3f };
+
+static const int32 UPMNoQualityCVar = INDEX_NONE;
+
+/** One enable CVar of an upscaler plugin and its quality mode values, NativeAA to UltraPerformance */
+struct FUPMUpscalerCVars
+{
+    const TCHAR* EnableCVar;
+    const TCHAR* QualityCVar;
+    int32 QualityValues[5];
+};
+
+struct FUPMUpscalerPlugin
+{
+    EUPMUpscalingMode Mode;
+    const TCHAR* PluginName;
+    uint32 RequiredVendorId; // 0 for any GPU
+    FUPMUpscalerCVars CVars[3];
+};
+
+// Newer plugin versions first; only the first one found is enabled
+static const FUPMUpscalerPlugin UPMUpscalerPlugins[] =
+{
+    // DLSS reads its ratio from r.ScreenPercentage
+    { EUPMUpscalingMode::DLSS, TEXT("DLSS"), 0x10DE, {
+        { TEXT("r.NGX.DLSS.Enable"), nullptr, { 0, 0, 0, 0, 0 } } } },
+    { EUPMUpscalingMode::FSR, TEXT("FSR3"), 0, {
+        { TEXT("r.FidelityFX.FSR3.Enabled"), TEXT("r.FidelityFX.FSR3.QualityMode"), { 0, 1, 2, 3, 4 } },
+        { TEXT("r.FidelityFX.FSR2.Enabled"), TEXT("r.FidelityFX.FSR2.QualityMode"), { UPMNoQualityCVar, 1, 2, 3, 4 } },
+        { TEXT("r.FidelityFX.FSR.Enabled"), nullptr, { 0, 0, 0, 0, 0 } } } },
+    { EUPMUpscalingMode::XeSS, TEXT("XeSS"), 0, {
+        { TEXT("r.XeSS.Enabled"), TEXT("r.XeSS.Quality"), { 6, 3, 2, 1, 0 } } } },
+};
+
+static const FUPMUpscalerPlugin* UPMFindUpscalerPlugin(EUPMUpscalingMode Mode)
+{
+    for (const FUPMUpscalerPlugin& Plugin : UPMUpscalerPlugins)
+    {
+        if (Plugin.Mode == Mode)
+        {
+            return &Plugin;
+        }
+    }
+    return nullptr;
+}
+
+static void UPMSetCVar(const TCHAR* Name, int32 Value)
+{
+    if (IConsoleVariable* CVar = Name ? IConsoleManager::Get().FindConsoleVariable(Name) : nullptr)
+    {
+        CVar->Set(Value);
+    }
+}
+
+FUPMUpscalerManager::FUPMUpscalerManager()
+    : ActiveMode(EUPMUpscalingMode::None)
+    , ActiveQuality(EUPMUpscalingQuality::Custom)
+    , ActiveScreenPercentage(100.0f)
+    , LastUnavailableMode(EUPMUpscalingMode::None)
+    , FramesSinceSwitch(0)
+{
+}
+
+bool FUPMUpscalerManager::IsAvailable(EUPMUpscalingMode Mode)
+{
+    if (Mode == EUPMUpscalingMode::None)
+    {
+        return true;
+    }
+    if (Mode == EUPMUpscalingMode::TSR)
+    {
+        return GMaxRHIFeatureLevel >= ERHIFeatureLevel::SM5;
+    }
+
+    const FUPMUpscalerPlugin* Plugin = UPMFindUpscalerPlugin(Mode);
+    if (!Plugin || (Plugin->RequiredVendorId != 0 && GRHIVendorId != Plugin->RequiredVendorId))
+    {
+        return false;
+    }
+    for (const FUPMUpscalerCVars& CVars : Plugin->CVars)
+    {
+        if (CVars.EnableCVar && IConsoleManager::Get().FindConsoleVariable(CVars.EnableCVar))
+        {
+            return true;
+        }
+    }
+
+    // Installed and enabled, but its module did not load (unsupported RHI or platform)
+    const TSharedPtr<IPlugin> InstalledPlugin = IPluginManager::Get().FindPlugin(Plugin->PluginName);
+    UE_CLOG(InstalledPlugin.IsValid() && InstalledPlugin->IsEnabled(), LogTemp, Verbose,
+        TEXT("UPM: %s plugin is enabled but registered no upscaler CVars"), Plugin->PluginName);
+    return false;
+}
+
+void FUPMUpscalerManager::GetEnabledPluginCVars(TArray<FString>& OutNames)
+{
+    OutNames.Reset();
+    for (const FUPMUpscalerPlugin& Plugin : UPMUpscalerPlugins)
+    {
+        for (const FUPMUpscalerCVars& CVars : Plugin.CVars)
+        {
+            const IConsoleVariable* CVar = CVars.EnableCVar ? IConsoleManager::Get().FindConsoleVariable(CVars.EnableCVar) : nullptr;
+            if (CVar && CVar->GetInt() != 0)
+            {
+                OutNames.Add(CVars.EnableCVar);
+            }
+        }
+    }
+}
+
+float FUPMUpscalerManager::GetScreenPercentage(const FUPMCompleteSettings& Settings)
+{
+    const EUPMUpscalingQuality Quality = Settings.Rendering.UpscalingQuality;
+    if (Settings.Rendering.UpscalingMode == EUPMUpscalingMode::None || Quality == EUPMUpscalingQuality::Custom)
+    {
+        return Settings.Display.ScreenPercentage;
+    }
+    return UPMUpscalingScreenPercentages[FMath::Min(static_cast<int32>(Quality), UE_ARRAY_COUNT(UPMUpscalingScreenPercentages) - 1)];
+}
+
+void FUPMUpscalerManager::Apply(const FUPMCompleteSettings& Settings)
+{
+    const EUPMUpscalingMode Requested = Settings.Rendering.UpscalingMode;
+    EUPMUpscalingMode Mode = Requested;
+    if (!IsAvailable(Mode))
+    {
+        Mode = IsAvailable(EUPMUpscalingMode::TSR) ? EUPMUpscalingMode::TSR : EUPMUpscalingMode::None;
+        UE_CLOG(LastUnavailableMode != Requested, LogTemp, Warning, TEXT("UPM: Upscaler %s is not available, using %s"),
+            *UEnum::GetValueAsString(Requested), *UEnum::GetValueAsString(Mode));
+        LastUnavailableMode = Requested;
+    }
+    else
+    {
+        LastUnavailableMode = EUPMUpscalingMode::None;
+    }
+
+    // Exactly one plugin upscaler on, in its first registered version
+    const EUPMUpscalingQuality Quality = Settings.Rendering.UpscalingQuality;
+    for (const FUPMUpscalerPlugin& Plugin : UPMUpscalerPlugins)
+    {
+        bool bEnabled = false;
+        for (const FUPMUpscalerCVars& CVars : Plugin.CVars)
+        {
+            if (!CVars.EnableCVar || !IConsoleManager::Get().FindConsoleVariable(CVars.EnableCVar))
+            {
+                continue;
+            }
+
+            const bool bEnable = Plugin.Mode == Mode && !bEnabled;
+            UPMSetCVar(CVars.EnableCVar, bEnable ? 1 : 0);
+            if (bEnable && Quality != EUPMUpscalingQuality::Custom && CVars.QualityValues[static_cast<int32>(Quality)] != UPMNoQualityCVar)
+            {
+                UPMSetCVar(CVars.QualityCVar, CVars.QualityValues[static_cast<int32>(Quality)]);
+            }
+            bEnabled |= bEnable;
+        }
+    }
+
+    // Plugin upscalers replace the temporal upscale pass of TAA; None keeps the TAA setting
+    int32 AntiAliasingMethod = 2;
+    if (Mode == EUPMUpscalingMode::TSR)
+    {
+        AntiAliasingMethod = 4;
+    }
+    else if (Mode == EUPMUpscalingMode::None)
+    {
+        AntiAliasingMethod = Settings.Rendering.bEnableTAA ? 2 : 0;
+    }
+    UPMSetCVar(TEXT("r.AntiAliasingMethod"), AntiAliasingMethod);
+
+    FUPMCompleteSettings ActiveSettings = Settings;
+    ActiveSettings.Rendering.UpscalingMode = Mode;
+    const float ScreenPercentage = GetScreenPercentage(ActiveSettings);
+    if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.ScreenPercentage")))
+    {
+        CVar->Set(ScreenPercentage);
+    }
+
+    if (Mode != ActiveMode || Quality != ActiveQuality || ScreenPercentage != ActiveScreenPercentage)
+    {
+        ActiveMode = Mode;
+        ActiveQuality = Quality;
+        ActiveScreenPercentage = ScreenPercentage;
+        FramesSinceSwitch = 0;
+    }
+}
+
+void FUPMUpscalerManager::Tick(float DeltaTime)
+{
+    if (DeltaTime <= 0.0f || DeltaTime > UPMUpscalerMaxSampleSeconds || ++FramesSinceSwitch <= UPMUpscalerSettleFrames)
+    {
+        return;
+    }
+
+    FUPMUpscalerStats* ModeStats = Stats.FindByPredicate([this](const FUPMUpscalerStats& Entry)
+    {
+        return Entry.Mode == ActiveMode && Entry.Quality == ActiveQuality && FMath::IsNearlyEqual(Entry.ScreenPercentage, ActiveScreenPercentage);
+    });
+    if (!ModeStats)
+    {
+        ModeStats = &Stats.AddDefaulted_GetRef();
+        ModeStats->Mode = ActiveMode;
+        ModeStats->Quality = ActiveQuality;
+        ModeStats->ScreenPercentage = ActiveScreenPercentage;
+    }
+
+    // Running means
+    const float Weight = 1.0f / (ModeStats->Frames + 1);
+    ModeStats->FrameTimeMs += (DeltaTime * 1000.0f - ModeStats->FrameTimeMs) * Weight;
+    ModeStats->GameThreadMs += (FPlatformTime::ToMilliseconds(GGameThreadTime) - ModeStats->GameThreadMs) * Weight;
+    ModeStats->RenderThreadMs += (FPlatformTime::ToMilliseconds(GRenderThreadTime) - ModeStats->RenderThreadMs) * Weight;
+    ModeStats->GPUMs += (FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()) - ModeStats->GPUMs) * Weight;
+    ++ModeStats->Frames;
+}
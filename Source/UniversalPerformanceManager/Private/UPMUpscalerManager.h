@@ -0,0 +1,51 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Upscaler selection
+ *
+ * DLSS, FSR and XeSS come from plugins that register their own enable CVars; TSR is part of the engine. An
+ * upscaler is available when its CVar exists (its plugin is loaded) and the GPU can run it. Apply() turns on
+ * exactly one (the selected one, or TSR/None if it is unavailable), turns every other one off, and pairs the
+ * quality mode with its screen percentage and the upscaler's own quality CVar.
+ *
+ * Frame times are averaged per upscaler, quality mode and screen percentage once a switch has settled, so the
+ * actual cost of each mode on this machine can be compared.
+ */
+class FUPMUpscalerManager
+{
+public:
+    FUPMUpscalerManager();
+
+    static bool IsAvailable(EUPMUpscalingMode Mode);
+
+    /** Enable CVars of plugin upscalers that are currently on */
+    static void GetEnabledPluginCVars(TArray<FString>& OutNames);
+
+    /** Screen percentage the settings render at */
+    static float GetScreenPercentage(const FUPMCompleteSettings& Settings);
+
+    /** Game thread, from ApplyRenderingSettings */
+    void Apply(const FUPMCompleteSettings& Settings);
+
+    /** Game thread, once per frame */
+    void Tick(float DeltaTime);
+
+    EUPMUpscalingMode GetActiveMode() const { return ActiveMode; }
+    const TArray<FUPMUpscalerStats>& GetStats() const { return Stats; }
+
+private:
+    EUPMUpscalingMode ActiveMode;
+    EUPMUpscalingQuality ActiveQuality;
+    float ActiveScreenPercentage;
+
+    // Selected mode that was reported unavailable, so the fallback is logged once
+    EUPMUpscalingMode LastUnavailableMode;
+
+    int32 FramesSinceSwitch;
+    TArray<FUPMUpscalerStats> Stats;
+};
@@ -0,0 +1,72 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMUpscalerManager.h"
+#include "UPMEngineStateSnapshot.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Every mode leaves exactly one upscaler active, with the matching anti-aliasing method; runs with -nullrhi */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUPMUpscalerModeSwitchTest, "UniversalPerformanceManager.Upscalers.ModeSwitch",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FUPMUpscalerModeSwitchTest::RunTest(const FString& Parameters)
+{
+    IConsoleVariable* AntiAliasingCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("r.AntiAliasingMethod"));
+    if (!TestNotNull(TEXT("r.AntiAliasingMethod exists"), AntiAliasingCVar))
+    {
+        return false;
+    }
+
+    FUPMEngineStateSnapshot EngineState;
+    EngineState.Capture();
+
+    FUPMUpscalerManager Upscalers;
+    FUPMCompleteSettings Settings;
+    Settings.Rendering.UpscalingQuality = EUPMUpscalingQuality::Quality;
+    TArray<FString> EnabledCVars;
+
+    // Every requested mode, with the fallback for plugins that are not installed
+    const EUPMUpscalingMode Modes[] = { EUPMUpscalingMode::TSR, EUPMUpscalingMode::DLSS, EUPMUpscalingMode::FSR,
+        EUPMUpscalingMode::XeSS, EUPMUpscalingMode::None };
+    for (const EUPMUpscalingMode Requested : Modes)
+    {
+        Settings.Rendering.UpscalingMode = Requested;
+        Settings.Rendering.bEnableTAA = true;
+        Upscalers.Apply(Settings);
+
+        const EUPMUpscalingMode Active = Upscalers.GetActiveMode();
+        const FString ModeName = UEnum::GetValueAsString(Requested);
+        TestTrue(*FString::Printf(TEXT("%s: active upscaler is available"), *ModeName), FUPMUpscalerManager::IsAvailable(Active));
+        if (FUPMUpscalerManager::IsAvailable(Requested))
+        {
+            TestTrue(*FString::Printf(TEXT("%s: requested upscaler is active"), *ModeName), Active == Requested);
+        }
+
+        FUPMUpscalerManager::GetEnabledPluginCVars(EnabledCVars);
+        const bool bPluginMode = Active != EUPMUpscalingMode::TSR && Active != EUPMUpscalingMode::None;
+        TestEqual(*FString::Printf(TEXT("%s: plugin upscalers enabled"), *ModeName), EnabledCVars.Num(), bPluginMode ? 1 : 0);
+
+        const int32 ExpectedAntiAliasing = Active == EUPMUpscalingMode::TSR ? 4 : 2;
+        TestEqual(*FString::Printf(TEXT("%s: r.AntiAliasingMethod"), *ModeName), AntiAliasingCVar->GetInt(), ExpectedAntiAliasing);
+    }
+
+    // None without TAA turns temporal anti-aliasing off altogether
+    Settings.Rendering.UpscalingMode = EUPMUpscalingMode::None;
+    Settings.Rendering.bEnableTAA = false;
+    Upscalers.Apply(Settings);
+    FUPMUpscalerManager::GetEnabledPluginCVars(EnabledCVars);
+    TestTrue(TEXT("None without TAA: no upscaler active"), Upscalers.GetActiveMode() == EUPMUpscalingMode::None);
+    TestEqual(TEXT("None without TAA: plugin upscalers enabled"), EnabledCVars.Num(), 0);
+    TestEqual(TEXT("None without TAA: r.AntiAliasingMethod"), AntiAliasingCVar->GetInt(), 0);
+
+    EngineState.Restore();
+    if (UUPMSettingsManager* LiveManager = UUPMSettingsManager::GetExistingInstance())
+    {
+        LiveManager->ApplyAllSettings();
+    }
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
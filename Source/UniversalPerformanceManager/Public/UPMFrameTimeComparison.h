@@ -0,0 +1,90 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Options for comparing two frame time recordings
+ */
+struct FUPMFrameTimeComparisonOptions
+{
+    // Bootstrap resamples per percentile
+    int32 BootstrapIterations = 1000;
+
+    // Frames per bootstrap block; 0 = cube root of the sample count. Consecutive frames are correlated,
+    // resampling blocks keeps that correlation instead of treating frames as independent.
+    int32 BlockLength = 0;
+
+    // Significance level of the confidence intervals and the Mann-Whitney test
+    float Alpha = 0.05f;
+
+    // Smallest relative percentile change that counts (0.02 = 2%), smaller significant changes are reported as noise
+    float MinRelativeChange = 0.02f;
+
+    int32 Seed = 12345;
+};
+
+/**
+ * Change of one frame time percentile between baseline and candidate
+ */
+struct FUPMPercentileChange
+{
+    float Percentile = 0.0f;
+    float BaselineMs = 0.0f;
+    float CandidateMs = 0.0f;
+
+    // Candidate - baseline, with its bootstrap confidence interval
+    float DifferenceMs = 0.0f;
+    float DifferenceLowMs = 0.0f;
+    float DifferenceHighMs = 0.0f;
+
+    // DifferenceMs / BaselineMs
+    float RelativeChange = 0.0f;
+
+    // The confidence interval excludes 0 and the change is at least MinRelativeChange
+    bool bSignificant = false;
+};
+
+/**
+ * Result of comparing two frame time recordings
+ */
+struct FUPMFrameTimeComparisonResult
+{
+    int32 BaselineFrames = 0;
+    int32 CandidateFrames = 0;
+
+    // Mann-Whitney U over the whole distribution
+    double MannWhitneyPValue = 1.0;
+
+    // Probability that a random candidate frame is slower than a random baseline frame (0.5 = no change)
+    double ProbabilityOfSuperiority = 0.5;
+
+    // Rank-biserial correlation, -1..1, positive = candidate slower
+    double RankBiserial = 0.0;
+
+    // P50, P95, P99
+    TArray<FUPMPercentileChange> Percentiles;
+
+    // Any percentile significantly slower / faster (and none slower)
+    bool bRegression = false;
+    bool bImprovement = false;
+};
+
+/**
+ * Statistical A/B comparison of two frame time series
+ *
+ * Percentile changes are tested with a moving-block bootstrap of the difference, the whole distribution with a
+ * Mann-Whitney U test. Recordings come from UUPMSettingsManager::StartFrameTimeRecording/StopFrameTimeRecording.
+ */
+class UNIVERSALPERFORMANCEMANAGER_API FUPMFrameTimeComparison
+{
+public:
+    /** Read one column of a frame time CSV (header row required) */
+    static bool LoadFrameTimes(const FString& FilePath, TArray<float>& OutFrameTimes, const FString& Column = TEXT("FrameTimeMs"));
+
+    static FUPMFrameTimeComparisonResult Compare(const TArray<float>& Baseline, const TArray<float>& Candidate,
+        const FUPMFrameTimeComparisonOptions& Options = FUPMFrameTimeComparisonOptions());
+
+    static void PrintReport(const FUPMFrameTimeComparisonResult& Result, FOutputDevice& Ar);
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
 #include "UPMSettingsManager.h"
+#include "UPMPerformanceSubsystem.h"
 #include "UPMPerformanceOverlayWidget.generated.h"
 
 /**
@@ -65,6 +66,10 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "UPM|Performance Overlay")
     UUPMSettingsManager* SettingsManager;
 
+    // Metrics of the owning game instance, preferred over the process-wide ones
+    UPROPERTY(BlueprintReadOnly, Category = "UPM|Performance Overlay")
+    UUPMPerformanceSubsystem* PerformanceSubsystem;
+
     UPROPERTY(BlueprintReadWrite, Category = "UPM|Performance Overlay")
     bool bIsVisible;
 
@@ -0,0 +1,99 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "UPMSettingsManager.h"
+#include "UPMPerformanceSubsystem.generated.h"
+
+/**
+ * Performance metrics of one game instance
+ *
+ * Every game instance (each PIE client and server, or each client of an in-process multi-client harness) gets
+ * its own frame statistics, net stats and frame time recording, measured on its own world. Settings are
+ * process-wide, they map onto global CVars, so they stay with the shared UUPMSettingsManager; changes from an
+ * instance go through FUPMSettingsRequestQueue and are arbitrated with all other instances once per frame.
+ *
+ * RAM and VRAM usage are process-wide and the same for every instance.
+ */
+UCLASS()
+class UNIVERSALPERFORMANCEMANAGER_API UUPMPerformanceSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    UUPMPerformanceSubsystem();
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance", meta = (WorldContext = "WorldContextObject"))
+    static UUPMPerformanceSubsystem* Get(const UObject* WorldContextObject);
+
+    // USubsystem
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+    virtual bool IsTickable() const override;
+    virtual UWorld* GetTickableGameObjectWorld() const override;
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    FUPMPerformanceMetrics GetPerformanceMetrics() const { return PerformanceMetrics; }
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Network")
+    FUPMServerNetworkStats GetServerNetworkStats() const { return ServerNetworkStats; }
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void ResetPerformanceStats();
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void StartFrameTimeRecording();
+
+    /**
+     * Stop recording and write FrameTimeMs,GameThreadMs,RenderThreadMs,GPUMs,WorldTickMs per frame as CSV
+     * (default Saved/UPM/FrameTimes/<Timestamp>-<InstanceName>.csv). Returns the file path, empty on failure.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    FString StopFrameTimeRecording(const FString& FilePath = TEXT(""));
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    bool IsRecordingFrameTimes() const { return bRecordingFrameTimes; }
+
+    /** The process-wide settings applier shared by all game instances */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    UUPMSettingsManager* GetSettingsManager() const;
+
+    /** Queue a setting change on the shared applier, see FUPMSettingsRequestQueue */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void RequestSetting(const FString& SettingPath, float Value, int32 Priority = 0);
+
+    /** Unique per process: "PIE<n>" from the PIE instance index (e.g. "PIE1"), "Instance<n>" outside PIE */
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    FString GetInstanceName() const { return InstanceName; }
+
+    // How long FPS_Average/Min/Max look back, in seconds
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Performance")
+    float FPSWindowSeconds;
+
+    // How often network stats are sampled, in seconds
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Network")
+    float NetworkSampleInterval;
+
+private:
+    FString InstanceName;
+
+    FUPMPerformanceMetrics PerformanceMetrics;
+    FUPMServerNetworkStats ServerNetworkStats;
+
+    // Frame times (s) of the last FPSWindowSeconds, oldest first
+    TArray<float> FrameTimeHistory;
+    float FrameTimeHistorySum;
+    float NetworkSampleAccumulator;
+
+    // Frame, game thread, render thread, GPU, world tick (ms)
+    bool bRecordingFrameTimes;
+    TArray<TStaticArray<float, 5>> RecordedFrameTimes;
+};
@@ -0,0 +1,65 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UUPMSettingsManager;
+
+/**
+ * Timing of one self-benchmark case
+ */
+struct FUPMSelfBenchmarkCase
+{
+    FString Name;
+
+    // Median cost of one call
+    double MedianMicroseconds = 0.0;
+
+    // 0 = not in the baseline
+    double BaselineMicroseconds = 0.0;
+
+    bool bRegressed = false;
+};
+
+struct FUPMSelfBenchmarkOptions
+{
+    // Allowed slowdown against the baseline (0.25 = 25%)
+    float Tolerance = 0.25f;
+
+    // Added to the allowed time so sub-microsecond cases don't fail on timer noise
+    double AbsoluteToleranceMicroseconds = 1.0;
+
+    // Write the results as the new baseline instead of failing when there is none
+    bool bUpdateBaseline = false;
+
+    // Empty = the plugin's versioned Resources/SelfBenchmarkBaseline.json
+    FString BaselinePath;
+};
+
+/**
+ * Microbenchmarks of the manager's own hot paths
+ *
+ * Times UpdatePerformanceMetrics at several history sizes, every Apply*Settings, SaveSettings/LoadSettings,
+ * SettingsToJson/JsonToSettings and GetAllSettings copies, and compares the medians against the baseline checked in
+ * with the plugin. A missing baseline fails the run; it is only ever written with bUpdateBaseline.
+ * Every case runs on a private, uninitialized copy of the manager with the source's settings, saving to and loading
+ * from a scratch file. Applying still reaches the engine, so console variables and GameUserSettings.ini are restored
+ * afterwards and the running manager, if any, re-applies its settings; run it headless (-nullrhi) for stable numbers.
+ */
+class UNIVERSALPERFORMANCEMANAGER_API FUPMSelfBenchmark
+{
+public:
+    /** Run every case with SettingsSource's settings and write Saved/UPM/SelfBenchmark.json; returns false when a case regressed or there is no baseline */
+    static bool Run(UUPMSettingsManager* SettingsSource, const FUPMSelfBenchmarkOptions& Options, TArray<FUPMSelfBenchmarkCase>& OutCases, FOutputDevice& Ar);
+
+    /** Resources/SelfBenchmarkBaseline.json in the plugin, empty when the module is not part of a plugin */
+    static FString GetDefaultBaselinePath();
+
+private:
+    /** Median microseconds per call over batches of at least a few milliseconds */
+    static double MeasureMicroseconds(TFunctionRef<void()> Operation);
+
+    static bool LoadBaseline(const FString& FilePath, TMap<FString, double>& OutBaseline);
+    static bool WriteResults(const FString& FilePath, const TArray<FUPMSelfBenchmarkCase>& Cases);
+};
@@ -7,6 +7,17 @@
 #include "GameFramework/GameUserSettings.h"
 #include "UPMSettingsManager.generated.h"
 
+class FUPMServerProfiler;
+class FUPMAudioRenderMonitor;
+class FUPMShaderPrecache;
+class FUPMApplyCostTracker;
+class FUPMUpscalerManager;
+class FUPMFrameRateTarget;
+class FUPMStreamingGovernor;
+class FUPMTextureStreamingStats;
+class FUPMEffectsBudget;
+class FAudioDevice;
+
 /**
  * Colorblind mode enumeration
  */
@@ -32,6 +43,244 @@ enum class EUPMUpscalingMode : uint8
     TSR UMETA(DisplayName = "Temporal Super Resolution")
 };
 
+/**
+ * Upscaler quality mode, each paired with a screen percentage
+ */
+UENUM(BlueprintType)
+enum class EUPMUpscalingQuality : uint8
+{
+    NativeAA UMETA(DisplayName = "Native AA (100%)"),
+    Quality UMETA(DisplayName = "Quality (67%)"),
+    Balanced UMETA(DisplayName = "Balanced (58%)"),
+    Performance UMETA(DisplayName = "Performance (50%)"),
+    UltraPerformance UMETA(DisplayName = "Ultra Performance (33%)"),
+    Custom UMETA(DisplayName = "Custom (Display Screen Percentage)")
+};
+
+/**
+ * Why the frame rate is currently reduced to save power, in increasing priority
+ */
+UENUM(BlueprintType)
+enum class EUPMEcoState : uint8
+{
+    None UMETA(DisplayName = "None"),
+    Menu UMETA(DisplayName = "In Menu"),
+    Idle UMETA(DisplayName = "Idle"),
+    Unfocused UMETA(DisplayName = "Unfocused"),
+    Minimized UMETA(DisplayName = "Minimized")
+};
+
+/**
+ * What applying a setting costs
+ */
+UENUM(BlueprintType)
+enum class EUPMSettingApplyCost : uint8
+{
+    // CVar writes and scalability changes, applied right away
+    Cheap UMETA(DisplayName = "Cheap"),
+    // Device, swapchain, window or streaming rebuilds, held back until a safe point during play
+    Expensive UMETA(DisplayName = "Expensive")
+};
+
+/**
+ * Settings categories, one flag per member of FUPMCompleteSettings
+ */
+enum class EUPMSettingsCategory : uint16
+{
+    None = 0,
+    Graphics = 1 << 0,
+    Rendering = 1 << 1,
+    Performance = 1 << 2,
+    Display = 1 << 3,
+    Audio = 1 << 4,
+    Gameplay = 1 << 5,
+    Accessibility = 1 << 6,
+    Network = 1 << 7,
+    Debug = 1 << 8,
+    Server = 1 << 9,
+    All = (1 << 10) - 1
+};
+ENUM_CLASS_FLAGS(EUPMSettingsCategory);
+
+/**
+ * Active particle systems of one effect asset (see FUPMEffectsBudget)
+ */
+USTRUCT(BlueprintType)
+struct FUPMEffectSystemStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    FString SystemName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    int32 ActiveInstances;
+
+    FUPMEffectSystemStats()
+        : ActiveInstances(0)
+    {
+    }
+};
+
+/**
+ * Tick cost of one actor/component class, averaged per frame (see FUPMTickProfiler)
+ */
+USTRUCT(BlueprintType)
+struct FUPMTickCostEntry
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    FString ClassName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    float AverageTimeMs;
+
+    // Highest single-frame total of the class in the window
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    float PeakTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    float TicksPerFrame;
+
+    FUPMTickCostEntry()
+        : AverageTimeMs(0.0f)
+        , PeakTimeMs(0.0f)
+        , TicksPerFrame(0.0f)
+    {
+    }
+};
+
+/**
+ * Process-wide part of the performance metrics, filled by the settings manager and copied as a whole into every
+ * game instance's metrics
+ */
+USTRUCT(BlueprintType)
+struct FUPMProcessMetrics
+{
+    GENERATED_BODY()
+
+    // Game thread time spent applying settings in the previous frame
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Settings")
+    float SettingsApplyTimeMs;
+
+    // Categories of a time-sliced commit still waiting for their frame
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Settings")
+    int32 PendingSettingsCategories;
+
+    // Streaming levels waiting to load, unload or change visibility
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    int32 PendingStreamingLevels;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    int32 AsyncLoadingPackages;
+
+    // Game thread time over the non-streaming baseline in frames that load or register levels (smoothed)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    float StreamingFrameCostMs;
+
+    // How long streaming work has been pending without a break; grows when the budget is too tight
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    float StreamingBacklogSeconds;
+
+    // Set by the streaming governor (0 while it is off)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    float AsyncLoadingTimeLimitMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Streaming")
+    float StreamingDistanceScale;
+
+    // Texture streaming pool, sampled once per second
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TexturePoolSizeMB;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureStreamingUsedMB;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureNonStreamingMB;
+
+    // Memory the views want for streaming textures, regardless of the pool size
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureWantedMB;
+
+    // Wanted memory that does not fit the pool; above zero the pool, not the quality, is the limit
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureOverBudgetMB;
+
+    // Textures the streamer still has to stream mips in or out for
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    int32 TextureStreamingRequests;
+
+    // Summed over the streamable textures every couple of seconds
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureResidentMB;
+
+    // Requested mips not resident yet
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TexturePendingMB;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    int32 TextureResidentMips;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    int32 TextureRequestedMips;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    int32 TexturesMissingMips;
+
+    // Mip data that became resident, between two passes over the textures
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Textures")
+    float TextureStreamingMBPerSecond;
+
+    // Active particle systems in the game world, counted once per second
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    int32 ActiveEffectSystems;
+
+    // Time of all particle systems as measured by the engine's FX budget (0 while it is off)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    float EffectsGameThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    float EffectsRenderThreadMs;
+
+    // Set by the effects budget (0 while it is off)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    float EffectsBudgetMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Effects")
+    float EffectsSpawnScale;
+
+    FUPMProcessMetrics()
+        : SettingsApplyTimeMs(0.0f)
+        , PendingSettingsCategories(0)
+        , PendingStreamingLevels(0)
+        , AsyncLoadingPackages(0)
+        , StreamingFrameCostMs(0.0f)
+        , StreamingBacklogSeconds(0.0f)
+        , AsyncLoadingTimeLimitMs(0.0f)
+        , StreamingDistanceScale(1.0f)
+        , TexturePoolSizeMB(0.0f)
+        , TextureStreamingUsedMB(0.0f)
+        , TextureNonStreamingMB(0.0f)
+        , TextureWantedMB(0.0f)
+        , TextureOverBudgetMB(0.0f)
+        , TextureStreamingRequests(0)
+        , TextureResidentMB(0.0f)
+        , TexturePendingMB(0.0f)
+        , TextureResidentMips(0)
+        , TextureRequestedMips(0)
+        , TexturesMissingMips(0)
+        , TextureStreamingMBPerSecond(0.0f)
+        , ActiveEffectSystems(0)
+        , EffectsGameThreadMs(0.0f)
+        , EffectsRenderThreadMs(0.0f)
+        , EffectsBudgetMs(0.0f)
+        , EffectsSpawnScale(1.0f)
+    {
+    }
+};
+
 /**
  * Performance metrics data structure
  */
@@ -79,12 +328,78 @@ struct FUPMPerformanceMetrics
     UPROPERTY(BlueprintReadOnly, Category = "Performance")
     float RHIThreadLoad;
 
+    // Average round trip time to the server in ms (clients only)
     UPROPERTY(BlueprintReadOnly, Category = "Performance")
     float NetworkPing;
 
+    // Worst of incoming/outgoing packet loss in percent (clients only)
     UPROPERTY(BlueprintReadOnly, Category = "Performance")
     float PacketLoss;
 
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    float PacketLossIn; // 0-100 %
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    float PacketLossOut; // 0-100 %
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    int32 NetInBytesPerSecond;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    int32 NetOutBytesPerSecond;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    int32 NetInPacketsPerSecond;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Network")
+    int32 NetOutPacketsPerSecond;
+
+    // Server only: game thread work per server tick (world tick + replication), excluding idle time
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Server")
+    float ServerTickTimeMs;
+
+    // Server only: part of ServerTickTimeMs spent in the net driver flush (replication)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Server")
+    float ServerNetTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Server")
+    int32 ServerTickRate;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Server")
+    int32 PlayerCount;
+
+    // Game thread time of the world tick, as measured by the tick budget subsystem
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    float WorldTickTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    float TickBudgetMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    int32 ThrottledActorCount;
+
+    // CPU time the audio render thread spends per buffer (average / peak over the last window)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Audio")
+    float AudioRenderTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Audio")
+    float AudioRenderPeakMs;
+
+    // Render deadline: duration of one audio buffer
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Audio")
+    float AudioBufferPeriodMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Audio")
+    int32 AudioVoiceLimit;
+
+    // Settings commits, streaming, texture streaming and effects; the same for every game instance
+    UPROPERTY(BlueprintReadOnly, Category = "Performance")
+    FUPMProcessMetrics Process;
+
+    // Most expensive ticking classes (only filled while the tick profiler is enabled)
+    UPROPERTY(BlueprintReadOnly, Category = "Performance|Tick")
+    TArray<FUPMTickCostEntry> TopTickCosts;
+
     FUPMPerformanceMetrics()
         : FPS_Current(0.0f)
         , FPS_Average(0.0f)
@@ -101,6 +416,82 @@ struct FUPMPerformanceMetrics
         , RHIThreadLoad(0.0f)
         , NetworkPing(0.0f)
         , PacketLoss(0.0f)
+        , PacketLossIn(0.0f)
+        , PacketLossOut(0.0f)
+        , NetInBytesPerSecond(0)
+        , NetOutBytesPerSecond(0)
+        , NetInPacketsPerSecond(0)
+        , NetOutPacketsPerSecond(0)
+        , ServerTickTimeMs(0.0f)
+        , ServerNetTimeMs(0.0f)
+        , ServerTickRate(0)
+        , PlayerCount(0)
+        , WorldTickTimeMs(0.0f)
+        , TickBudgetMs(0.0f)
+        , ThrottledActorCount(0)
+        , AudioRenderTimeMs(0.0f)
+        , AudioRenderPeakMs(0.0f)
+        , AudioBufferPeriodMs(0.0f)
+        , AudioVoiceLimit(0)
+    {
+    }
+};
+
+/**
+ * Server-side network statistics aggregated across all client connections
+ */
+USTRUCT(BlueprintType)
+struct FUPMServerNetworkStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    int32 NumConnections;
+
+    // Ping values are in ms
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float AveragePing;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float PingP50;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float PingP95;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float PingP99;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float MaxPing;
+
+    // Packet loss values are in percent
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float AveragePacketLossIn;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float AveragePacketLossOut;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float PacketLossP95; // Worst direction per connection
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    int32 TotalInBytesPerSecond;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    int32 TotalOutBytesPerSecond;
+
+    FUPMServerNetworkStats()
+        : NumConnections(0)
+        , AveragePing(0.0f)
+        , PingP50(0.0f)
+        , PingP95(0.0f)
+        , PingP99(0.0f)
+        , MaxPing(0.0f)
+        , AveragePacketLossIn(0.0f)
+        , AveragePacketLossOut(0.0f)
+        , PacketLossP95(0.0f)
+        , TotalInBytesPerSecond(0)
+        , TotalOutBytesPerSecond(0)
     {
     }
 };
@@ -205,6 +596,9 @@ struct FUPMRenderingSettings
     UPROPERTY(BlueprintReadWrite, Category = "Rendering|Quality")
     EUPMUpscalingMode UpscalingMode;
 
+    UPROPERTY(BlueprintReadWrite, Category = "Rendering|Quality")
+    EUPMUpscalingQuality UpscalingQuality;
+
     UPROPERTY(BlueprintReadWrite, Category = "Rendering|Quality")
     int32 GlobalIlluminationQuality; // 0-4
 
@@ -233,6 +627,7 @@ struct FUPMRenderingSettings
         , AnisotropicFiltering(4)
         , bEnableTAA(true)
         , UpscalingMode(EUPMUpscalingMode::TSR)
+        , UpscalingQuality(EUPMUpscalingQuality::Custom)
         , GlobalIlluminationQuality(3)
         , ReflectionQuality(3)
         , bEnableSSGI(false)
@@ -256,6 +651,59 @@ struct FUPMPerformanceSettings
     UPROPERTY(BlueprintReadWrite, Category = "Performance")
     float FrameRateLimit;
 
+    // Pick the frame rate cap from the display's refresh rate and the measured frame cost (ignores FrameRateLimit)
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Frame Rate Target")
+    bool bAutoFrameRateTarget;
+
+    // The display runs variable refresh rate (G-Sync, FreeSync); only used if the platform reports support
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Frame Rate Target")
+    bool bVariableRefreshRate;
+
+    // Lower frame rate caps while the player is not playing (0 = no cap for that state); games only, not PIE.
+    // Opt-in: it changes the frame rate players are used to when they alt-tab
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    bool bEnableEcoMode;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    float UnfocusedFrameRateLimit;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    float MinimizedFrameRateLimit;
+
+    // While paused or while the game reports a menu (SetMenuActive)
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    float MenuFrameRateLimit;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    float IdleFrameRateLimit;
+
+    // Seconds without input before the idle cap applies (0 = never idle)
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    float IdleTimeoutSeconds;
+
+    // Skip world rendering entirely while minimized
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Eco Mode")
+    bool bSuspendRenderingWhenMinimized;
+
+    // Adjust async loading and level registration to loading screens and a gameplay budget
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Streaming")
+    bool bEnableStreamingGovernor;
+
+    // Game thread time per frame async loading and level registration may take during play
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Streaming")
+    float StreamingBudgetMs; // 0.5 - 10
+
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Streaming")
+    float LoadingScreenAsyncLoadingTimeMs;
+
+    // Hold particle systems to a share of the frame that grows with EffectsQuality
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Effects")
+    bool bEnableEffectsBudget;
+
+    // Game and render thread time effects may take per frame; 0 = from EffectsQuality and the frame rate target
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Effects")
+    float EffectsBudgetMs; // 0, 0.1 - 10
+
     // NEW: Advanced performance features
     UPROPERTY(BlueprintReadWrite, Category = "Performance|Dynamic")
     bool bEnableDynamicResolution;
@@ -275,15 +723,54 @@ struct FUPMPerformanceSettings
     UPROPERTY(BlueprintReadWrite, Category = "Performance|Advanced")
     int32 ProcessPriority; // 0=Normal, 1=High, 2=RealTime
 
+    // NEW: Throttle ticking of insignificant actors to keep the world tick inside a budget
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Tick Budget")
+    bool bEnableTickBudget;
+
+    // Fraction of the frame time (from FrameRateLimit, 60 FPS when unlimited) the world tick may use
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Tick Budget")
+    float TickBudgetFraction; // 0.1 - 0.9
+
+    // Tick interval of the least significant actors at full throttle (seconds)
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Tick Budget")
+    float MaxThrottledTickInterval;
+
+    // Distance from the nearest viewer at which an actor's distance significance reaches zero
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Tick Budget")
+    float SignificanceDistance;
+
+    // Stop ticking entirely for actors with no significance at full throttle
+    UPROPERTY(BlueprintReadWrite, Category = "Performance|Tick Budget")
+    bool bAllowTickDisable;
+
     FUPMPerformanceSettings()
         : bEnableVSync(true)
         , FrameRateLimit(0.0f)
+        , bAutoFrameRateTarget(false)
+        , bVariableRefreshRate(false)
+        , bEnableEcoMode(false)
+        , UnfocusedFrameRateLimit(30.0f)
+        , MinimizedFrameRateLimit(5.0f)
+        , MenuFrameRateLimit(0.0f)
+        , IdleFrameRateLimit(30.0f)
+        , IdleTimeoutSeconds(0.0f)
+        , bSuspendRenderingWhenMinimized(true)
+        , bEnableStreamingGovernor(false)
+        , StreamingBudgetMs(3.0f)
+        , LoadingScreenAsyncLoadingTimeMs(50.0f)
+        , bEnableEffectsBudget(false)
+        , EffectsBudgetMs(0.0f)
         , bEnableDynamicResolution(false)
         , MinFrameRateForDynamicRes(30.0f)
         , bEnableTripleBuffering(false)
         , bEnableAsyncCompute(true)
         , LODDistanceMultiplier(1.0f)
         , ProcessPriority(0)
+        , bEnableTickBudget(false)
+        , TickBudgetFraction(0.5f)
+        , MaxThrottledTickInterval(0.5f)
+        , SignificanceDistance(15000.0f)
+        , bAllowTickDisable(false)
     {
     }
 };
@@ -389,7 +876,11 @@ struct FUPMAudioSettings
     int32 SurroundSoundMode; // 0=Stereo, 1=5.1, 2=7.1
 
     UPROPERTY(BlueprintReadWrite, Category = "Audio|Spatial")
-    bool bEnableSpatialAudio;
+    bool bEnableSpatialAudio; // HRTF (binaural) spatialization
+
+    // Lower the voice count while audio rendering gets close to its deadline
+    UPROPERTY(BlueprintReadWrite, Category = "Audio|Quality")
+    bool bEnableAdaptiveVoiceBudget;
 
     UPROPERTY(BlueprintReadWrite, Category = "Audio|Advanced")
     float DynamicRange; // 0.0-1.0, compression level
@@ -411,6 +902,7 @@ struct FUPMAudioSettings
         , AudioQuality(2)
         , SurroundSoundMode(0)
         , bEnableSpatialAudio(false)
+        , bEnableAdaptiveVoiceBudget(true)
         , DynamicRange(0.5f)
         , SubtitleTextSize(1.0f)
         , SubtitleBackgroundOpacity(0.5f)
@@ -420,6 +912,10 @@ struct FUPMAudioSettings
 
 /**
  * Gameplay settings structure - EXPANDED
+ *
+ * Only FOV is applied by the manager (as the local camera managers' DefaultFOV). Sensitivity, inversion, controller,
+ * camera comfort and the other fields are read by the game's own input and camera code, through OnSettingsChanged
+ * (category Gameplay) and GetGameplaySettings().
  */
 USTRUCT(BlueprintType)
 struct FUPMGameplaySettings
@@ -549,12 +1045,50 @@ struct FUPMNetworkSettings
     UPROPERTY(BlueprintReadWrite, Category = "Network")
     bool bEnableCrossplay;
 
+    // Adapt net speed, move send rate and interpolation to measured ping/loss
+    UPROPERTY(BlueprintReadWrite, Category = "Network")
+    bool bEnableAdaptiveNetworking;
+
     FUPMNetworkSettings()
         : MaxPingThreshold(150)
         , NetworkSmoothing(0.5f)
         , BandwidthLimitKBps(0)
         , PreferredRegion(TEXT("Auto"))
         , bEnableCrossplay(true)
+        , bEnableAdaptiveNetworking(false)
+    {
+    }
+};
+
+/**
+ * Current output of the adaptive network governor (client side, one per world)
+ */
+USTRUCT(BlueprintType)
+struct FUPMNetworkGovernorState
+{
+    GENERATED_BODY()
+
+    // Net speed currently requested from the server, in bytes per second
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    int32 NetSpeed;
+
+    // Effective interpolation/smoothing amount (>= NetworkSmoothing)
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float Interpolation;
+
+    // Seconds between client movement updates the engine derives from NetSpeed
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    float ClientSendMoveDeltaTime;
+
+    // True while ping or loss is above the acceptable thresholds
+    UPROPERTY(BlueprintReadOnly, Category = "Network")
+    bool bThrottled;
+
+    FUPMNetworkGovernorState()
+        : NetSpeed(0)
+        , Interpolation(0.0f)
+        , ClientSendMoveDeltaTime(0.0f)
+        , bThrottled(false)
     {
     }
 };
@@ -582,12 +1116,89 @@ struct FUPMDebugSettings
     UPROPERTY(BlueprintReadWrite, Category = "Debug")
     bool bBenchmarkMode;
 
+    // Per-class tick cost profiling (development builds only)
+    UPROPERTY(BlueprintReadWrite, Category = "Debug")
+    bool bEnableTickProfiler;
+
+    // Per-texture mip statistics (resident/requested mips, pending and streamed MB), summed over every texture
+    // every couple of seconds; the pool numbers are sampled either way
+    UPROPERTY(BlueprintReadWrite, Category = "Debug")
+    bool bEnableTextureStreamingStats;
+
     FUPMDebugSettings()
         : bShowPerformanceOverlay(false)
         , bShowNetworkStats(false)
         , bDeveloperMode(false)
         , bEnableCrashReporting(true)
         , bBenchmarkMode(false)
+        , bEnableTickProfiler(false)
+        , bEnableTextureStreamingStats(false)
+    {
+    }
+};
+
+/**
+ * NEW: Server settings structure (listen and dedicated servers)
+ */
+USTRUCT(BlueprintType)
+struct FUPMServerSettings
+{
+    GENERATED_BODY()
+
+    // Adapt NetServerMaxTickRate to the measured tick cost
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    bool bEnableTickRateGovernor;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    int32 MinServerTickRate;
+
+    // Never above the net driver's configured NetServerMaxTickRate
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    int32 MaxServerTickRate;
+
+    // Fraction of each tick interval the server may spend working (0.5 - 0.95)
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    float TickBudgetFraction;
+
+    // Shrink replicated actors' net cull distance when even MinServerTickRate cannot be held
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    bool bAdaptNetCullDistance;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Server")
+    float MinNetCullDistanceScale; // 0.25 - 1.0
+
+    FUPMServerSettings()
+        : bEnableTickRateGovernor(false)
+        , MinServerTickRate(20)
+        , MaxServerTickRate(60)
+        , TickBudgetFraction(0.8f)
+        , bAdaptNetCullDistance(false)
+        , MinNetCullDistanceScale(0.5f)
+    {
+    }
+};
+
+/**
+ * Estimated replication cost of one actor class on the server
+ */
+USTRUCT(BlueprintType)
+struct FUPMReplicationClassCost
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Server")
+    FString ClassName;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Server")
+    int32 ActorCount;
+
+    // Share of the measured net flush time, weighted by actor count and NetUpdateFrequency
+    UPROPERTY(BlueprintReadOnly, Category = "Server")
+    float EstimatedCostMs;
+
+    FUPMReplicationClassCost()
+        : ActorCount(0)
+        , EstimatedCostMs(0.0f)
     {
     }
 };
@@ -626,6 +1237,211 @@ struct FUPMCompleteSettings
 
     UPROPERTY(BlueprintReadWrite, Category = "Settings")
     FUPMDebugSettings Debug;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Settings")
+    FUPMServerSettings Server;
+};
+
+/**
+ * What changed in one settings commit
+ */
+USTRUCT(BlueprintType)
+struct FUPMSettingsChange
+{
+    GENERATED_BODY()
+
+    // Category names, e.g. "Graphics"
+    UPROPERTY(BlueprintReadOnly, Category = "Settings")
+    TArray<FName> ChangedCategories;
+
+    // "<Category>.<Field>", e.g. "Gameplay.FOV"
+    UPROPERTY(BlueprintReadOnly, Category = "Settings")
+    TArray<FName> ChangedFields;
+
+    EUPMSettingsCategory Categories;
+
+    FUPMSettingsChange()
+        : Categories(EUPMSettingsCategory::None)
+    {
+    }
+
+    bool HasChanged(EUPMSettingsCategory Category) const { return EnumHasAnyFlags(Categories, Category); }
+    bool HasFieldChanged(FName Field) const { return ChangedFields.Contains(Field); }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUPMSettingsChanged, const FUPMSettingsChange&, Change);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnUPMSettingsChangedNative, const FUPMSettingsChange& /*Change*/);
+
+/**
+ * Refresh rate of the monitor the game window is on
+ */
+USTRUCT(BlueprintType)
+struct FUPMDisplayRefreshInfo
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Display")
+    FString MonitorId;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Display")
+    float RefreshRate;
+
+    // The platform can present without waiting for vblank, which variable refresh rate needs
+    UPROPERTY(BlueprintReadOnly, Category = "Display")
+    bool bVariableRefreshRateSupported;
+
+    FUPMDisplayRefreshInfo()
+        : RefreshRate(60.0f)
+        , bVariableRefreshRateSupported(false)
+    {
+    }
+};
+
+/**
+ * Measured frame times with one upscaler and quality mode active
+ */
+USTRUCT(BlueprintType)
+struct FUPMUpscalerStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    EUPMUpscalingMode Mode;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    EUPMUpscalingQuality Quality;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    float ScreenPercentage;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    int32 Frames;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    float FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    float GameThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    float RenderThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Upscaling")
+    float GPUMs;
+
+    FUPMUpscalerStats()
+        : Mode(EUPMUpscalingMode::None)
+        , Quality(EUPMUpscalingQuality::Custom)
+        , ScreenPercentage(100.0f)
+        , Frames(0)
+        , FrameTimeMs(0.0f)
+        , GameThreadMs(0.0f)
+        , RenderThreadMs(0.0f)
+        , GPUMs(0.0f)
+    {
+    }
+};
+
+/**
+ * PSO precache requests and the hitches seen right after settings switches
+ */
+USTRUCT(BlueprintType)
+struct FUPMShaderPrecacheStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    int32 Requests;
+
+    // Shader-relevant switches whose PSOs were precached beforehand
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    int32 WarmSwitches;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    int32 ColdSwitches;
+
+    // Frames over 50 ms within 3 seconds of a switch
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    int32 WarmSwitchHitches;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    int32 ColdSwitchHitches;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    float WarmSwitchWorstHitchMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    float ColdSwitchWorstHitchMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Shader Precache")
+    float LastPrecacheSeconds;
+
+    FUPMShaderPrecacheStats()
+        : Requests(0)
+        , WarmSwitches(0)
+        , ColdSwitches(0)
+        , WarmSwitchHitches(0)
+        , ColdSwitchHitches(0)
+        , WarmSwitchWorstHitchMs(0.0f)
+        , ColdSwitchWorstHitchMs(0.0f)
+        , LastPrecacheSeconds(0.0f)
+    {
+    }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnUPMShaderPrecacheComplete);
+
+/**
+ * Measured cost of changing one setting: the apply call plus the extra thread time of the frames after it
+ * (render state rebuilds), averaged over every change seen. Changes of several fields share the cost evenly.
+ */
+USTRUCT(BlueprintType)
+struct FUPMSettingApplyCostStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    FString Setting;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    int32 Samples;
+
+    // Game thread time of the Apply*Settings call
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float ApplyCallMs;
+
+    // Thread time over the pre-change baseline, summed over the frames after the change
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float GameThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float RenderThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float RHIThreadMs;
+
+    // Longest of the three thread costs: how long the change stalls the frame
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float MeanStallMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float MaxStallMs;
+
+    // Median of the most recent stalls; one hitch during a measurement (a GC, a level load) barely moves it
+    UPROPERTY(BlueprintReadOnly, Category = "Apply Cost")
+    float MedianStallMs;
+
+    FUPMSettingApplyCostStats()
+        : Samples(0)
+        , ApplyCallMs(0.0f)
+        , GameThreadMs(0.0f)
+        , RenderThreadMs(0.0f)
+        , RHIThreadMs(0.0f)
+        , MeanStallMs(0.0f)
+        , MaxStallMs(0.0f)
+        , MedianStallMs(0.0f)
+    {
+    }
 };
 
 /**
@@ -654,6 +1470,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Manager", meta = (WorldContext = "WorldContextObject"))
     static UUPMSettingsManager* GetInstance(const UObject* WorldContextObject);
 
+    /** The manager if something has created it already, never creates one */
+    static UUPMSettingsManager* GetExistingInstance() { return Instance; }
+
     // ==================== Performance Monitoring ====================
 
     UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
@@ -662,17 +1481,177 @@ public:
     UFUNCTION(BlueprintPure, Category = "UPM|Performance")
     FUPMPerformanceMetrics GetPerformanceMetrics() const { return PerformanceMetrics; }
 
+    /** The process-wide part of the metrics without copying the rest */
+    const FUPMProcessMetrics& GetProcessMetrics() const { return PerformanceMetrics.Process; }
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
     void ResetPerformanceStats();
 
+    /** Record every frame seen by UpdatePerformanceMetrics until StopFrameTimeRecording */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void StartFrameTimeRecording();
+
+    /**
+     * Stop recording and write FrameTimeMs,GameThreadMs,RenderThreadMs,GPUMs per frame as CSV
+     * (default Saved/UPM/FrameTimes/<Timestamp>.csv). Returns the file path, empty on failure.
+     * Compare two recordings with upm.CompareFrameTimes or -run=UPMCompare.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    FString StopFrameTimeRecording(const FString& FilePath = TEXT(""));
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    bool IsRecordingFrameTimes() const { return bRecordingFrameTimes; }
+
+    // ==================== Network Monitoring ====================
+
+    /**
+     * Sample net connection stats of the given world right away.
+     * The manager does this automatically every NetworkSampleInterval seconds;
+     * call this directly to sample a specific world (e.g. server and client worlds in one process).
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Network", meta = (WorldContext = "WorldContextObject"))
+    void SampleNetworkMetrics(const UObject* WorldContextObject);
+
+    /**
+     * Aggregated stats over all client connections (listen/dedicated servers only)
+     */
+    UFUNCTION(BlueprintPure, Category = "UPM|Network")
+    FUPMServerNetworkStats GetServerNetworkStats() const { return ServerNetworkStats; }
+
+    /**
+     * Read the net stats of one world into the given structs without touching the manager's own state.
+     * OutServerStats is only written when the world is a server. Returns true if the world has a local
+     * connection to a server.
+     */
+    static bool ReadWorldNetworkMetrics(UWorld* World, FUPMPerformanceMetrics& OutMetrics, FUPMServerNetworkStats& OutServerStats);
+
+    /**
+     * Hand the player's audio sample rate (chosen through AudioQuality in an earlier session) to the mixer.
+     * Called by the module at startup, before the audio device is created.
+     */
+    static void ApplyStoredAudioSampleRate();
+
     // ==================== Settings Management ====================
 
+    /** Copy of all settings; C++ code should prefer GetSettings() or the per-category accessors */
     UFUNCTION(BlueprintPure, Category = "UPM|Settings")
     FUPMCompleteSettings GetAllSettings() const { return CurrentSettings; }
 
+    const FUPMCompleteSettings& GetSettings() const { return CurrentSettings; }
+    const FUPMGraphicsSettings& GetGraphicsSettings() const { return CurrentSettings.Graphics; }
+    const FUPMRenderingSettings& GetRenderingSettings() const { return CurrentSettings.Rendering; }
+    const FUPMPerformanceSettings& GetPerformanceSettings() const { return CurrentSettings.Performance; }
+    const FUPMDisplaySettings& GetDisplaySettings() const { return CurrentSettings.Display; }
+    const FUPMAudioSettings& GetAudioSettings() const { return CurrentSettings.Audio; }
+    const FUPMGameplaySettings& GetGameplaySettings() const { return CurrentSettings.Gameplay; }
+    const FUPMAccessibilitySettings& GetAccessibilitySettings() const { return CurrentSettings.Accessibility; }
+    const FUPMNetworkSettings& GetNetworkSettings() const { return CurrentSettings.Network; }
+    const FUPMDebugSettings& GetDebugSettings() const { return CurrentSettings.Debug; }
+    const FUPMServerSettings& GetServerSettings() const { return CurrentSettings.Server; }
+
+    /**
+     * Fired once per commit with every category and field that changed. Each setter is a commit of its own;
+     * setters called between BeginSettingsBatch and EndSettingsBatch are applied and reported together.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "UPM|Settings")
+    FOnUPMSettingsChanged OnSettingsChanged;
+
+    FOnUPMSettingsChangedNative OnSettingsChangedNative;
+
+    /** Defer applying and notifying until the matching EndSettingsBatch (batches nest) */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void BeginSettingsBatch();
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void EndSettingsBatch();
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
     void ApplyAllSettings();
 
+    /** Replace every category at once and apply them in a single pass */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void SetAllSettings(const FUPMCompleteSettings& Settings);
+
+    /**
+     * Apply category by category over the next frames, at most TimeSliceBudgetMs per frame (at least one
+     * category per frame). Listeners are notified once, after the last category; the end state is the same
+     * as with ApplyAllSettings.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void ApplyAllSettingsTimeSliced();
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void SetAllSettingsTimeSliced(const FUPMCompleteSettings& Settings);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    bool IsTimeSlicedCommitPending() const { return SlicedCategories != EUPMSettingsCategory::None; }
+
+    // Time-slice every commit that spans more than one category (loads, profile switches)
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Settings")
+    bool bTimeSliceCommits;
+
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Settings")
+    float TimeSliceBudgetMs;
+
+    /**
+     * Set one numeric or bool setting by "<Category>.<Field>", e.g. "Graphics.ShadowQuality".
+     * The value is clamped to the range the typed setter allows. Commits only if the value changed; returns false
+     * for unknown or non-numeric fields and invalid enum values. Game thread only, other threads use
+     * FUPMSettingsRequestQueue.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    bool SetSettingByName(const FString& SettingPath, double Value);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    bool GetSettingByName(const FString& SettingPath, float& OutValue) const;
+
+    /** Reflection helpers behind SetSettingByName/GetSettingByName, usable on any settings struct; Set clamps like SetSettingByName */
+    static bool SetSettingValue(FUPMCompleteSettings& Settings, const FString& SettingPath, double Value);
+    static bool GetSettingValue(const FUPMCompleteSettings& Settings, const FString& SettingPath, double& OutValue);
+    static EUPMSettingsCategory GetSettingCategory(const FString& SettingPath);
+
+    /** Every path SetSettingByName accepts, in category order */
+    static void GetSettingPaths(TArray<FString>& OutSettingPaths);
+
+    /** Expensive if known to rebuild something or measured to stall for more than two frames */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    EUPMSettingApplyCost GetSettingApplyCost(const FString& SettingPath) const;
+
+    /** Measured apply cost of a setting (Samples is 0 if it never changed); persisted in Saved/UPM/ApplyCosts.json */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    FUPMSettingApplyCostStats GetSettingApplyCostStats(const FString& SettingPath) const;
+
+    /** Every measured setting, most expensive first */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    TArray<FUPMSettingApplyCostStats> GetAllSettingApplyCosts() const;
+
+    /** Measured cost of commits that changed several fields at once; not attributed to any one setting */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    FUPMSettingApplyCostStats GetBatchApplyCostStats() const;
+
+    // ==================== Safe Points ====================
+
+    /**
+     * Apply held-back expensive settings now. Call when a hitch will not be noticed: loading screens, fades,
+     * menus. Map loads, pausing and a fully faded camera are detected as safe points automatically.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Settings")
+    void NotifySafePoint();
+
+    /** Expensive settings changed during play that wait for a safe point, as "<Category>.<Field>" */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    TArray<FString> GetDeferredSettings() const { return DeferredSettingPaths.Array(); }
+
+    /** Whether "<Category>.<Field>" (any case) waits for a safe point */
+    bool IsSettingDeferred(const FString& SettingPath) const { return DeferredSettingPaths.Contains(SettingPath); }
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings")
+    bool IsAtSafePoint() const;
+
+    // Hold back expensive settings during play; when false everything applies right away
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Settings")
+    bool bDeferExpensiveSettings;
+
     // ==================== Graphics Settings ====================
 
     UFUNCTION(BlueprintCallable, Category = "UPM|Graphics")
@@ -737,6 +1716,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Rendering")
     void SetUpscalingMode(EUPMUpscalingMode Mode);
 
+    UFUNCTION(BlueprintCallable, Category = "UPM|Rendering")
+    void SetUpscalingQuality(EUPMUpscalingQuality Quality);
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Rendering")
     void SetGlobalIlluminationQuality(int32 Quality);
 
@@ -760,6 +1742,67 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
     void SetFrameRateLimit(float Limit);
 
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetAutoFrameRateTarget(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetVariableRefreshRate(bool bEnabled);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    FUPMDisplayRefreshInfo GetDisplayRefreshInfo() const;
+
+    /**
+     * Frame rate caps that pace evenly on the current display, highest first: the refresh rate and its
+     * integer divisors down to 30, or just below the refresh rate under variable refresh rate
+     */
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    TArray<float> GetFrameRateTargets() const;
+
+    /** The cap in effect: the automatic target, or FrameRateLimit (0 = unlimited) */
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    float GetFrameRateTarget() const;
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetEcoModeEnabled(bool bEnabled);
+
+    /** Tell eco mode a menu is open in a game that does not pause for it */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetMenuActive(bool bActive);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    EUPMEcoState GetEcoState() const { return EcoState; }
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetStreamingGovernorEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetStreamingBudgetMs(float BudgetMs);
+
+    /**
+     * Tell the streaming governor a loading screen covers the game, so loading may take the frame.
+     * Map loads and a fully faded camera are detected automatically.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetLoadingScreenActive(bool bActive);
+
+    /**
+     * 0.5 - 1: scale for the loading range of the game's streaming sources, lowered while the streaming budget
+     * cannot keep up during play
+     */
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    float GetStreamingDistanceScale() const;
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetEffectsBudgetEnabled(bool bEnabled);
+
+    /** 0 = a share of the frame from EffectsQuality */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetEffectsBudgetMs(float BudgetMs);
+
+    /** Effect assets with the most active systems in the game world, most first */
+    UFUNCTION(BlueprintPure, Category = "UPM|Performance")
+    TArray<FUPMEffectSystemStats> GetTopEffectSystems(int32 MaxEntries = 10) const;
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
     void SetDynamicResolutionEnabled(bool bEnabled);
 
@@ -778,6 +1821,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
     void SetProcessPriority(int32 Priority);
 
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetTickBudgetEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Performance")
+    void SetTickBudgetFraction(float Fraction);
+
     // ==================== Display Settings ====================
 
     UFUNCTION(BlueprintCallable, Category = "UPM|Display")
@@ -854,6 +1903,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Audio")
     void SetSpatialAudioEnabled(bool bEnabled);
 
+    UFUNCTION(BlueprintCallable, Category = "UPM|Audio")
+    void SetAdaptiveVoiceBudgetEnabled(bool bEnabled);
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Audio")
     void SetDynamicRange(float Range);
 
@@ -950,6 +2002,20 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Network")
     void SetCrossplayEnabled(bool bEnabled);
 
+    UFUNCTION(BlueprintCallable, Category = "UPM|Network")
+    void SetAdaptiveNetworkingEnabled(bool bEnabled);
+
+    /** Governor state of the world the manager is tracking (default state when it has not run there) */
+    UFUNCTION(BlueprintPure, Category = "UPM|Network")
+    FUPMNetworkGovernorState GetNetworkGovernorState() const;
+
+    /**
+     * Configure the engine's packet simulation (PktLag/PktLoss) on the world's net driver.
+     * Only available in builds with DO_ENABLE_NET_TEST (not Shipping); returns false otherwise.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Network", meta = (WorldContext = "WorldContextObject"))
+    static bool SetPacketSimulation(const UObject* WorldContextObject, int32 LagMs, int32 LossPercent);
+
     // ==================== Debug Settings ====================
 
     UFUNCTION(BlueprintCallable, Category = "UPM|Debug")
@@ -970,6 +2036,89 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Debug")
     void SetBenchmarkMode(bool bEnabled);
 
+    /** Profile tick cost per class; code opts in with UPM_TICK_SCOPE() (see UPMTickProfiler.h) */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Debug")
+    void SetTickProfilerEnabled(bool bEnabled);
+
+    /** Sum resident and requested mips over the streamable textures for the Texture* metrics */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Debug")
+    void SetTextureStreamingStatsEnabled(bool bEnabled);
+
+    /** Log the tick cost report and write it to Saved/UPM/TickReport.csv; returns false if nothing was written */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Debug")
+    bool DumpTickProfilerReport();
+
+    // ==================== Server Settings ====================
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Server")
+    void SetServerSettings(const FUPMServerSettings& Settings);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Server")
+    void SetServerTickRateGovernorEnabled(bool bEnabled);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Server")
+    void SetServerTickRateRange(int32 MinTickRate, int32 MaxTickRate);
+
+    UFUNCTION(BlueprintCallable, Category = "UPM|Server")
+    void SetAdaptNetCullDistance(bool bEnabled);
+
+    /**
+     * Replicated actor classes sorted by estimated replication cost (servers only)
+     */
+    UFUNCTION(BlueprintPure, Category = "UPM|Server")
+    TArray<FUPMReplicationClassCost> GetReplicationClassCosts() const;
+
+    // ==================== Upscaling ====================
+
+    /** Whether the upscaler's plugin is loaded and the GPU can run it; None is always available */
+    UFUNCTION(BlueprintPure, Category = "UPM|Upscaling")
+    bool IsUpscalerAvailable(EUPMUpscalingMode Mode) const;
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Upscaling")
+    TArray<EUPMUpscalingMode> GetAvailableUpscalers() const;
+
+    /** The upscaler actually running: the selected one, or its fallback if it is unavailable */
+    UFUNCTION(BlueprintPure, Category = "UPM|Upscaling")
+    EUPMUpscalingMode GetActiveUpscalingMode() const;
+
+    /** Screen percentage of the selected quality mode (Display.ScreenPercentage for Custom and None) */
+    UFUNCTION(BlueprintPure, Category = "UPM|Upscaling")
+    float GetUpscalingScreenPercentage() const;
+
+    /** Frame times measured per upscaler and quality mode this session */
+    UFUNCTION(BlueprintPure, Category = "UPM|Upscaling")
+    TArray<FUPMUpscalerStats> GetUpscalerStats() const;
+
+    // ==================== Shader Precache ====================
+
+    /**
+     * Compile the PSOs of upcoming settings at full speed, e.g. during a fade or a menu.
+     * Returns false if they are already warm.
+     */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Shader Precache")
+    bool PrecacheSettings(const FUPMCompleteSettings& Settings);
+
+    /** Precache, then apply the settings once warm or after TimeoutSeconds, whichever comes first */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Shader Precache")
+    void SetAllSettingsWhenWarm(const FUPMCompleteSettings& Settings, float TimeoutSeconds = 10.0f);
+
+    /** LoadProfile through SetAllSettingsWhenWarm */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Shader Precache")
+    bool LoadProfileWhenWarm(const FString& ProfileName, float TimeoutSeconds = 10.0f);
+
+    /** 0-1 for the running precache, 1 when nothing is pending */
+    UFUNCTION(BlueprintPure, Category = "UPM|Shader Precache")
+    float GetShaderPrecacheProgress() const;
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Shader Precache")
+    bool IsShaderPrecacheWarm() const;
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Shader Precache")
+    FUPMShaderPrecacheStats GetShaderPrecacheStats() const;
+
+    UPROPERTY(BlueprintAssignable, Category = "UPM|Shader Precache")
+    FOnUPMShaderPrecacheComplete OnShaderPrecacheComplete;
+
     // ==================== Persistence ====================
 
     UFUNCTION(BlueprintCallable, Category = "UPM|Persistence")
@@ -978,6 +2127,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Persistence")
     bool LoadSettings();
 
+    /** Save the current settings as a named profile (Saved/UPM/Profiles/<Name>.json) */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Persistence")
+    bool SaveProfile(const FString& ProfileName);
+
+    /** Load a named profile and apply it as one commit */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Persistence")
+    bool LoadProfile(const FString& ProfileName);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Persistence")
+    TArray<FString> GetProfileNames() const;
+
     UFUNCTION(BlueprintCallable, Category = "UPM|Persistence")
     void Initialize();
 
@@ -988,27 +2148,175 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "UPM|Settings")
     FUPMCompleteSettings CurrentSettings;
 
+    UPROPERTY(BlueprintReadOnly, Category = "UPM|Network")
+    FUPMServerNetworkStats ServerNetworkStats;
+
+    // How often network stats are sampled, in seconds (net stats only update a few times per second anyway)
+    UPROPERTY(BlueprintReadWrite, Category = "UPM|Network")
+    float NetworkSampleInterval;
+
 private:
     // Performance tracking
     TArray<float> FPSHistory;
     float FPSHistoryTimeAccumulator;
 
+    // Frame time recording: frame, game thread, render thread, GPU (ms)
+    bool bRecordingFrameTimes;
+    TArray<FVector4f> RecordedFrameTimes;
+
+    // Network tracking
+    TWeakObjectPtr<UWorld> CachedWorld;
+    float NetworkSampleAccumulator;
+    void SampleNetworkMetricsForWorld(UWorld* World);
+
+    // Network governor, per world so PIE clients throttle independently
+    TMap<TObjectKey<UWorld>, FUPMNetworkGovernorState> NetworkGovernorStates;
+    FUPMNetworkGovernorState& FindOrAddNetworkGovernorState(UWorld* World);
+    void ApplyBandwidthLimit(UWorld* World);
+    void UpdateNetworkGovernor(UWorld* World);
+    int32 GetMaxNetSpeed(UWorld* World) const;
+    void SetClientNetSpeed(UWorld* World, int32 NetSpeed);
+
     // Settings application
     void ApplyGraphicsSettings();
     void ApplyRenderingSettings();
     void ApplyPerformanceSettings();
     void ApplyDisplaySettings();
     void ApplyAudioSettings();
-    void ApplyGameplaySettings();
+    void ApplyGameplaySettings(); // FOV only, the other gameplay fields are up to listeners
     void ApplyAccessibilitySettings();
     void ApplyNetworkSettings();
     void ApplyDebugSettings();
+    void ApplyServerSettings();
+
+    // Server profiling, created once a server world is known
+    TSharedPtr<FUPMServerProfiler> ServerProfiler;
+    void UpdateServerMetrics();
+
+    uint32 TickProfilerWindowSerial;
+
+    // Audio render cost and adaptive voice budget
+    TSharedPtr<FUPMAudioRenderMonitor, ESPMode::ThreadSafe> AudioRenderMonitor;
+    int32 AudioVoiceLimit;
+    float AudioBudgetAccumulator;
+    FAudioDevice* GetAudioDevice() const;
+    void ApplyAudioSampleRateQuality();
+    void UpdateAudioBudget(float DeltaTime);
+
+    // Commit pipeline: changed categories are applied once and reported against the last committed state
+    FUPMCompleteSettings CommittedSettings;
+    EUPMSettingsCategory PendingCategories;
+    int32 SettingsBatchDepth;
+    bool bPublishingChanges; // Commits requested by listeners wait until the running commit has ended
+    void CommitSettings(EUPMSettingsCategory Categories);
+    void CommitListenerChanges();
+    void ApplyCategories(EUPMSettingsCategory Categories);
+
+    // Commit stages: hold back expensive fields, apply, diff and notify, restore the held-back fields
+    EUPMSettingsCategory BeginApply(EUPMSettingsCategory Categories, FUPMCompleteSettings& OutRequestedSettings);
+    void PublishChanges(EUPMSettingsCategory Categories);
+    void EndApply(const FUPMCompleteSettings& RequestedSettings);
+
+    // Time-sliced commits
+    EUPMSettingsCategory SlicedCategories;
+    EUPMSettingsCategory SlicedAppliedCategories;
+    TMap<EUPMSettingsCategory, float> CategoryApplyCostMs; // Last measured, to plan the slices
+    float SettingsApplyMsThisFrame;
+    void StartTimeSlicedCommit(EUPMSettingsCategory Categories);
+    void ProcessTimeSlicedCommit();
+    void FlushTimeSlicedCommit();
+
+    // Expensive settings not applied yet; CurrentSettings holds their requested values, CommittedSettings the applied
+    TSet<FString> DeferredSettingPaths;
+    bool bForceSafePoint;
+    FDelegateHandle PreLoadMapHandle;
+    void DeferExpensiveChanges(EUPMSettingsCategory Categories);
+
+    // Requests from other threads and deferred switches are applied at the start of every frame
+    FDelegateHandle BeginFrameHandle;
+    void BeginFrame();
+
+    // Automatic frame rate target; ApplyFrameRateTarget writes the cap of the current settings
+    TSharedPtr<FUPMFrameRateTarget> FrameRateTarget;
+    bool bFrameRateSyncIntervalSet;
+    void ApplyFrameRateTarget();
+
+    // Eco mode; the cap goes through ApplyFrameRateTarget, bDisableWorldRendering is restored to its previous value
+    EUPMEcoState EcoState;
+    bool bMenuActive;
+    bool bEcoSuspendedRendering;
+    bool bWorldRenderingWasDisabled;
+    EUPMEcoState GetCurrentEcoState() const;
+    float GetEcoFrameRateLimit() const;
+    void UpdateEcoState();
+
+    // Streaming governor; loading screens are map loads, SetLoadingScreenActive and a fully faded camera
+    TSharedPtr<FUPMStreamingGovernor> StreamingGovernor;
+    bool bLoadingMap;
+    bool bLoadingScreenActive;
+    FDelegateHandle PostLoadMapHandle;
+    bool IsLoadingScreen() const;
+
+    // Texture streaming telemetry, low frequency
+    TSharedPtr<FUPMTextureStreamingStats> TextureStreamingStats;
+
+    // Effects budget, driven by EffectsQuality and the frame rate target
+    TSharedPtr<FUPMEffectsBudget> EffectsBudget;
+
+    // Upscaler exclusivity, screen percentage pairing and cost per mode
+    TSharedPtr<FUPMUpscalerManager> UpscalerManager;
+
+    // PSO precaching and the settings waiting for it
+    TSharedPtr<FUPMShaderPrecache> ShaderPrecache;
+
+    // Hitch measurement after each change; CommitApplyMs is the apply time of the commit being published
+    TSharedPtr<FUPMApplyCostTracker> ApplyCostTracker;
+    float CommitApplyMs;
+    TOptional<FUPMCompleteSettings> SettingsWaitingForPrecache;
+    double PrecacheDeadline;
 
     // Persistence helpers
+    FString SettingsFilePathOverride; // Lets the self-benchmark save and load without touching the player's file
     FString GetSettingsFilePath() const;
+    static FString GetProfileFilePath(const FString& ProfileName);
+    bool SaveSettingsToFile(const FString& FilePath);
+    bool LoadSettingsFromFile(const FString& FilePath);
+    bool ReadProfile(const FString& ProfileName, FUPMCompleteSettings& OutSettings);
     TSharedPtr<FJsonObject> SettingsToJson() const;
     bool JsonToSettings(TSharedPtr<FJsonObject> JsonObject);
 
     // Singleton instance
     static UUPMSettingsManager* Instance;
+
+    // Self-benchmark and automation tests reach the private apply and persistence paths
+    friend class FUPMSelfBenchmark;
+    friend class FUPMSelfBenchmarkIsolationTest;
+    friend class FUPMEcoFrameRateCapTest;
+};
+
+/**
+ * Scoped settings batch: everything set during its lifetime is applied and reported in one commit
+ */
+class FUPMSettingsBatch
+{
+public:
+    explicit FUPMSettingsBatch(UUPMSettingsManager* InManager)
+        : Manager(InManager)
+    {
+        if (Manager)
+        {
+            Manager->BeginSettingsBatch();
+        }
+    }
+
+    ~FUPMSettingsBatch()
+    {
+        if (Manager)
+        {
+            Manager->EndSettingsBatch();
+        }
+    }
+
+private:
+    UUPMSettingsManager* Manager;
 };
@@ -23,6 +23,7 @@ public:
     UUPMSettingsPanelWidget(const FObjectInitializer& ObjectInitializer);
 
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
 
     // ==================== Initialization ====================
 
@@ -38,6 +39,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Settings Panel")
     void RefreshFromSettings();
 
+    /**
+     * Called once per settings commit with what changed (also for changes made outside this panel)
+     */
+    UFUNCTION(BlueprintImplementableEvent, Category = "UPM|Settings Panel")
+    void OnSettingsChanged(const FUPMSettingsChange& Change);
+
     // ==================== Settings Access ====================
 
     /**
@@ -144,7 +151,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "UPM|Settings Panel")
     void ApplySettings();
 
+    /**
+     * Measured cost of changing a setting, e.g. to warn that it will hitch or only applies at the next safe point
+     */
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings Panel")
+    FUPMSettingApplyCostStats GetSettingApplyCostStats(const FString& SettingPath) const;
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Settings Panel")
+    bool IsSettingExpensive(const FString& SettingPath) const;
+
 protected:
     UPROPERTY(BlueprintReadOnly, Category = "UPM|Settings Panel")
     UUPMSettingsManager* SettingsManager;
+
+private:
+    void HandleSettingsChanged(const FUPMSettingsChange& Change);
+
+    FDelegateHandle SettingsChangedHandle;
 };
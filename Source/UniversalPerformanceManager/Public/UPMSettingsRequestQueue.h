@@ -0,0 +1,46 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class UUPMSettingsManager;
+
+/** Outcome of a queued settings request */
+enum class EUPMSettingsRequestResult : uint8
+{
+    // The value was applied in this frame's commit
+    Applied,
+    // Accepted, but an expensive setting that is applied at the next safe point
+    Deferred,
+    // The setting already had this value
+    Unchanged,
+    // Another request for the same setting in the same frame won
+    Coalesced,
+    // Unknown setting, non-numeric field, non-finite value or invalid enum value
+    Rejected
+};
+
+/**
+ * Settings change requests from any thread
+ *
+ * Producers (adaptive systems, worker threads, network callbacks) enqueue without locking. Once per frame, at
+ * the start of the frame on the game thread, the manager drains the queue, keeps one request per setting and
+ * applies all winners as a single commit, so listeners see one change notification per frame at most:
+ *
+ *     FUPMSettingsRequestQueue::Request(TEXT("Graphics.ShadowQuality"), 1, TEXT("ThermalGovernor"))
+ *         .Next([](EUPMSettingsRequestResult Result) { ... });
+ *
+ * Per setting the higher priority wins, on a tie the later request; the others complete as Coalesced.
+ * Values are clamped to the setting's range like the typed setters do.
+ */
+class UNIVERSALPERFORMANCEMANAGER_API FUPMSettingsRequestQueue
+{
+public:
+    /** Any thread: queue "<Category>.<Field>" = Value; the future completes on the game thread */
+    static TFuture<EUPMSettingsRequestResult> Request(const FString& SettingPath, double Value, const FString& Requester = FString(), int32 Priority = 0);
+
+    /** Game thread: drain, merge and apply everything queued so far */
+    static void ProcessRequests(UUPMSettingsManager* Manager);
+};
@@ -0,0 +1,44 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/RefCounting.h"
+#include "UPMSettingsManager.h"
+
+/**
+ * Immutable copy of the settings for reading on any thread
+ *
+ * The manager publishes a new snapshot on every settings commit through an atomic pointer. Readers take the current
+ * one without a lock: one atomic load plus the reference count increment, bracketed by a reader count:
+ *
+ *     TRefCountPtr<const FUPMSettingsSnapshot> Snapshot = FUPMSettingsSnapshot::Get();
+ *     const int32 EffectsQuality = Snapshot->Settings.Graphics.EffectsQuality;
+ *
+ * A superseded snapshot is retired and released on the game thread (on publish and at the end of each frame) the
+ * first time no reader is between its load and its increment, so the reference is always taken on a live object.
+ * After that it is freed when its last reference is dropped; hold the TRefCountPtr for as long as the settings are
+ * read, and take a new one to see later commits.
+ */
+class UNIVERSALPERFORMANCEMANAGER_API FUPMSettingsSnapshot : public FThreadSafeRefCountedObject
+{
+public:
+    FUPMSettingsSnapshot(const FUPMCompleteSettings& InSettings, uint32 InVersion);
+
+    const FUPMCompleteSettings Settings;
+
+    // Increases with every commit
+    const uint32 Version;
+
+    /** Latest snapshot, any thread; never null */
+    static TRefCountPtr<const FUPMSettingsSnapshot> Get();
+
+    /** Game thread: make Settings the latest snapshot */
+    static void Publish(const FUPMCompleteSettings& InSettings);
+
+    /** Game thread: release retired snapshots that no reader can still be loading */
+    static void ReleaseRetired();
+
+    /** Module shutdown: drop the published snapshot, references still held keep theirs alive */
+    static void Shutdown();
+};
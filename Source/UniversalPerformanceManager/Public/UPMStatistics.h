@@ -0,0 +1,36 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Small statistics helpers shared by the UPM metric collectors
+ */
+struct UNIVERSALPERFORMANCEMANAGER_API FUPMStatistics
+{
+    /** Arithmetic mean, 0 for an empty set */
+    static float Mean(const TArray<float>& Values);
+
+    /**
+     * Percentile of an already sorted array using linear interpolation
+     * @param Percentile 0-100
+     */
+    static float PercentileSorted(const TArray<float>& SortedValues, float Percentile);
+
+    /** Percentile of an unsorted array (sorts a copy) */
+    static float Percentile(const TArray<float>& Values, float Percentile);
+
+    /** Sample standard deviation (n - 1), 0 for fewer than two values */
+    static float StdDev(const TArray<float>& Values);
+
+    /** Half width of the 95% confidence interval of the mean (Student's t), 0 for fewer than two values */
+    static float ConfidenceInterval95(const TArray<float>& Values);
+
+    /**
+     * Mann-Whitney U test (normal approximation with tie correction)
+     * @param OutProbabilityOfSuperiority P(A > B) + P(A == B) / 2; 0.5 = no shift, used as effect size
+     * @param OutPValue Two-sided p-value for "the distributions are shifted"
+     */
+    static void MannWhitneyU(const TArray<float>& A, const TArray<float>& B, double& OutProbabilityOfSuperiority, double& OutPValue);
+};
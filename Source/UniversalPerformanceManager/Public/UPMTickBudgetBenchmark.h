@@ -0,0 +1,91 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "UPMTickBudgetBenchmark.generated.h"
+
+/**
+ * Ticking load actor used by the tick budget benchmark: burns a fixed amount of game thread time per tick
+ */
+UCLASS(NotBlueprintable)
+class UNIVERSALPERFORMANCEMANAGER_API AUPMTickBudgetLoadActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AUPMTickBudgetLoadActor();
+
+    virtual void Tick(float DeltaTime) override;
+
+    UPROPERTY(EditAnywhere, Category = "UPM|Benchmark")
+    int32 WorkIterations;
+
+private:
+    float WorkState;
+};
+
+/**
+ * Tick budget benchmark
+ *
+ * Spawns a grid of ticking load actors, measures frame and world tick time with the tick budget disabled,
+ * then again with it enabled, and logs/saves the comparison to Saved/UPM/TickBudgetBenchmark.json.
+ *
+ * Place it in any map, or run headless without a map of its own:
+ *   <Project> /Engine/Maps/Entry -game -nullrhi -UPMTickBudgetBenchmark=5000
+ */
+UCLASS(Blueprintable)
+class UNIVERSALPERFORMANCEMANAGER_API AUPMTickBudgetBenchmark : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AUPMTickBudgetBenchmark();
+
+    virtual void BeginPlay() override;
+    virtual void Tick(float DeltaTime) override;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    int32 NumActors;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float GridSpacing;
+
+    // Work per load actor tick; 2000 iterations is roughly 10 us on a desktop CPU
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    int32 WorkIterations;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float WarmupDuration;
+
+    // Duration of each measured phase (budget off, budget on)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float PhaseDuration;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    bool bExitWhenFinished;
+
+private:
+    enum class EPhase : uint8
+    {
+        Warmup,
+        Baseline,
+        Throttled,
+        Finished
+    };
+
+    void SpawnLoadActors();
+    void EnterPhase(EPhase NewPhase);
+    void ReportResults();
+
+    EPhase Phase;
+    float PhaseTime;
+    bool bTickBudgetWasEnabled;
+
+    TArray<float> BaselineFrameTimes;
+    TArray<float> BaselineWorldTickTimes;
+    TArray<float> ThrottledFrameTimes;
+    TArray<float> ThrottledWorldTickTimes;
+    int32 PeakThrottledActors;
+};
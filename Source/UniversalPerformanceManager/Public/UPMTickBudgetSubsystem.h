@@ -0,0 +1,140 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "UPMSettingsManager.h"
+#include "UPMTickBudgetSubsystem.generated.h"
+
+class AActor;
+class ULevel;
+class UActorComponent;
+
+/**
+ * Significance-based tick throttling
+ *
+ * Every ticking actor in the world gets a significance score (0-1) from its distance to the nearest viewer,
+ * whether it was rendered recently and whether it is relevant to a player (owned, possessed, always relevant).
+ * The subsystem measures the game thread time of the world tick and raises a throttle level while it is over
+ * budget; actors below the throttle level get longer tick intervals (and optionally stop ticking), the most
+ * significant actors are never touched.
+ *
+ * Actors tagged UPM.NoThrottle are left alone.
+ */
+UCLASS()
+class UNIVERSALPERFORMANCEMANAGER_API UUPMTickBudgetSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    UUPMTickBudgetSubsystem();
+
+    // USubsystem / FTickableGameObject
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void SetSettings(const FUPMPerformanceSettings& InSettings);
+
+    /** Smoothed game thread time of the world tick (ms) */
+    UFUNCTION(BlueprintPure, Category = "UPM|Tick Budget")
+    float GetWorldTickTimeMs() const { return SmoothedWorldTickMs; }
+
+    /** Unsmoothed game thread time of the last world tick (ms) */
+    float GetLastWorldTickTimeMs() const { return LastWorldTickMs; }
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Tick Budget")
+    float GetTickBudgetMs() const;
+
+    /** 0 = nothing throttled, 1 = every actor below full significance throttled */
+    UFUNCTION(BlueprintPure, Category = "UPM|Tick Budget")
+    float GetThrottleLevel() const { return ThrottleLevel; }
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Tick Budget")
+    int32 GetManagedActorCount() const { return ManagedActors.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Tick Budget")
+    int32 GetThrottledActorCount() const { return ThrottledActorCount; }
+
+    /** Exclude an actor from throttling (restores its tick right away) */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Tick Budget")
+    void SetActorExempt(AActor* Actor, bool bExempt);
+
+    static const FName NoThrottleTag;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    struct FManagedComponent
+    {
+        TWeakObjectPtr<UActorComponent> Component;
+        float OriginalInterval;
+
+        // Whether it ticked when the budget disabled it; only those are enabled again
+        bool bWasTickEnabled = false;
+    };
+
+    struct FManagedActor
+    {
+        TWeakObjectPtr<AActor> Actor;
+        float OriginalInterval = 0.0f;
+        TArray<FManagedComponent> Components;
+        float AppliedInterval = 0.0f;
+        bool bThrottled = false;
+        bool bTickDisabled = false;
+        bool bWasTickEnabled = false;
+    };
+
+    struct FViewpoint
+    {
+        FVector Location;
+        FVector Direction;
+    };
+
+    /** Actors are only registered while the budget is enabled and the world has begun play */
+    void StartManaging();
+    void StopManaging();
+    void RegisterLevel(ULevel* Level);
+    void RegisterActor(AActor* Actor);
+    void SpawnBenchmarkFromCommandLine();
+    void OnActorSpawned(AActor* Actor);
+    void OnLevelAdded(ULevel* Level, UWorld* InWorld);
+
+    void OnWorldTickStart(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+    void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaSeconds);
+
+    void GatherViewpoints();
+    float ComputeSignificance(const AActor* Actor) const;
+    void UpdateThrottleLevel(float DeltaTime);
+    void ApplyThrottle(FManagedActor& Managed, float Significance);
+    void SetManagedInterval(FManagedActor& Managed, float Interval);
+    void SetManagedTickEnabled(FManagedActor& Managed, bool bEnabled);
+    void RestoreActor(FManagedActor& Managed);
+    void RestoreAll();
+
+    FUPMPerformanceSettings Settings;
+
+    TArray<FManagedActor> ManagedActors;
+    TSet<TWeakObjectPtr<AActor>> RegisteredActors;
+    TArray<FViewpoint> Viewpoints;
+    int32 NextActorIndex;
+    int32 ThrottledActorCount;
+
+    // World tick measurement
+    double WorldTickStartTime;
+    float LastWorldTickMs;
+    float SmoothedWorldTickMs;
+
+    float ThrottleLevel;
+    float ControlAccumulator;
+
+    FDelegateHandle ActorSpawnedHandle;
+    FDelegateHandle LevelAddedHandle;
+    FDelegateHandle TickStartHandle;
+    FDelegateHandle PostActorTickHandle;
+};
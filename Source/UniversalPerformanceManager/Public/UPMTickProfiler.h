@@ -0,0 +1,142 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMSettingsManager.h"
+#include <atomic>
+
+/** The tick profiler is compiled out of Shipping builds */
+#ifndef UPM_WITH_TICK_PROFILER
+#define UPM_WITH_TICK_PROFILER !UE_BUILD_SHIPPING
+#endif
+
+/** Set while the profiler is collecting; checked by every tick scope */
+extern UNIVERSALPERFORMANCEMANAGER_API std::atomic<bool> GUPMTickProfilerEnabled;
+
+/**
+ * Per-class tick cost profiler
+ *
+ * Tick scopes record into a table owned by the calling thread (no locks on the hot path, only a flag
+ * telling the merge which buffer the thread is writing).
+ * At the end of each frame the game thread merges all thread tables into per-class totals, and once
+ * per second the averages are published as the top offenders.
+ *
+ * The engine does not expose a hook inside its tick dispatch, so actors and components opt in by
+ * placing UPM_TICK_SCOPE() at the top of their Tick / TickComponent override.
+ */
+class UNIVERSALPERFORMANCEMANAGER_API FUPMTickProfiler
+{
+public:
+    static FUPMTickProfiler& Get();
+
+    void SetEnabled(bool bEnabled);
+    static bool IsEnabled() { return GUPMTickProfilerEnabled.load(std::memory_order_relaxed); }
+
+    /** Record one tick of the given class (any thread) */
+    void RecordTick(const UClass* Class, uint64 Cycles);
+
+    /** Most expensive classes of the last evaluation window, sorted by time */
+    void GetTopEntries(int32 MaxEntries, TArray<FUPMTickCostEntry>& OutEntries) const;
+
+    /** Incremented every time new averages are published */
+    uint32 GetWindowSerial() const { return WindowSerial; }
+
+    /** Write the full table of the last window to a log/console output device */
+    void DumpReport(FOutputDevice& Ar, int32 MaxEntries = 50) const;
+
+    /** Write the full table of the last window as CSV */
+    bool WriteReport(const FString& FilePath) const;
+
+    void Reset();
+
+private:
+    FUPMTickProfiler();
+
+    struct FClassAccumulator
+    {
+        uint64 Cycles = 0;
+        uint32 Count = 0;
+    };
+
+    /**
+     * Per-thread table, double buffered by frame so the merge never touches the buffer being written.
+     * WriterState is 1 + the parity of the buffer the owning thread is writing, 0 while it is not writing.
+     * Keyed by class name, resolved while the class is ticking: a class collected later in the frame
+     * (hot reload, unloaded Blueprint) is never dereferenced by the merge.
+     */
+    struct FThreadTable
+    {
+        TMap<FName, FClassAccumulator> Frames[2];
+        std::atomic<uint32> WriterState{0};
+    };
+
+    struct FWindowAccumulator
+    {
+        double TotalMs = 0.0;
+        double PeakFrameMs = 0.0;
+        uint64 Count = 0;
+    };
+
+    FThreadTable& GetThreadTable();
+
+    /** Flip writers to the other buffer and wait until no thread is still writing the returned one */
+    uint32 FlipAndDrainBuffer();
+
+    void OnEndFrame();
+    void PublishWindow();
+
+    /** Free the thread tables once nothing ticks anymore */
+    void Shutdown();
+
+    // Thread tables are registered once per thread and freed at engine exit; the generation tells threads
+    // their cached table is gone
+    FCriticalSection TablesLock;
+    TArray<TUniquePtr<FThreadTable>> ThreadTables;
+    std::atomic<uint32> TablesGeneration;
+
+    std::atomic<uint32> FrameParity;
+    FDelegateHandle EndFrameHandle;
+    FDelegateHandle PreExitHandle;
+
+    // Game thread only
+    TMap<FName, FWindowAccumulator> WindowTotals;
+    uint32 WindowFrames;
+    double WindowStartTime;
+    TArray<FUPMTickCostEntry> PublishedEntries;
+    uint32 WindowSerial;
+};
+
+#if UPM_WITH_TICK_PROFILER
+
+/** RAII tick timer, use through UPM_TICK_SCOPE() */
+class FUPMTickScope
+{
+public:
+    explicit FUPMTickScope(const UClass* InClass)
+        : Class(InClass)
+        , StartCycles(FUPMTickProfiler::IsEnabled() ? FPlatformTime::Cycles64() : 0)
+    {
+    }
+
+    ~FUPMTickScope()
+    {
+        if (StartCycles != 0)
+        {
+            FUPMTickProfiler::Get().RecordTick(Class, FPlatformTime::Cycles64() - StartCycles);
+        }
+    }
+
+private:
+    const UClass* Class;
+    uint64 StartCycles;
+};
+
+/** Place at the top of an actor's Tick or a component's TickComponent */
+#define UPM_TICK_SCOPE() FUPMTickScope ANONYMOUS_VARIABLE(UPMTickScope_)(GetClass())
+
+#else
+
+#define UPM_TICK_SCOPE()
+
+#endif
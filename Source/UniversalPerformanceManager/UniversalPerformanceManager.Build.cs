@@ -25,7 +25,9 @@ public class UniversalPerformanceManager : ModuleRules
 
         PrivateDependencyModuleNames.AddRange(new string[]
         {
-            "ApplicationCore"
+            "ApplicationCore",
+            "AudioMixerCore",
+            "Projects"
         });
 
         // If you are using online features
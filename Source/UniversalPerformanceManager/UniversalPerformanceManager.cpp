@@ -1,6 +1,10 @@
 // Copyright Universal Performance Manager. All Rights Reserved.
 
 #include "UniversalPerformanceManager.h"
+#include "UPMSettingsManager.h"
+#include "UPMSettingsSnapshot.h"
+#include "Misc/CoreDelegates.h"
+#include "Engine/World.h"
 
 #define LOCTEXT_NAMESPACE "FUniversalPerformanceManagerModule"
 
@@ -8,14 +12,38 @@ void FUniversalPerformanceManagerModule::StartupModule()
 {
     // This code will execute after your module is loaded into memory
     UE_LOG(LogTemp, Log, TEXT("Universal Performance Manager module started"));
+
+    // Before the engine creates the main audio device
+    UUPMSettingsManager::ApplyStoredAudioSampleRate();
+
+    SettingsSnapshotReleaseHandle = FCoreDelegates::OnEndFrame.AddStatic(&FUPMSettingsSnapshot::ReleaseRetired);
+
+    if (IsRunningDedicatedServer())
+    {
+        PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(
+            this, &FUniversalPerformanceManagerModule::OnPostWorldInitialization);
+    }
 }
 
 void FUniversalPerformanceManagerModule::ShutdownModule()
 {
     // This function may be called during shutdown to clean up your module
+    FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+    FCoreDelegates::OnEndFrame.Remove(SettingsSnapshotReleaseHandle);
+    FUPMSettingsSnapshot::Shutdown();
+
     UE_LOG(LogTemp, Log, TEXT("Universal Performance Manager module shutdown"));
 }
 
+void FUniversalPerformanceManagerModule::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+    if (World && World->IsGameWorld())
+    {
+        // Creates the manager on first use and points the server profiler at the new world after travel
+        UUPMSettingsManager::GetInstance(World);
+    }
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FUniversalPerformanceManagerModule, UniversalPerformanceManager)
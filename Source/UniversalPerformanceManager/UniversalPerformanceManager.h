@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Engine/World.h"
 
 class FUniversalPerformanceManagerModule : public IModuleInterface
 {
@@ -11,4 +12,11 @@ public:
     /** IModuleInterface implementation */
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+    /** Dedicated servers have no widgets to create the manager, so do it when a game world appears */
+    void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+
+    FDelegateHandle PostWorldInitializationHandle;
+    FDelegateHandle SettingsSnapshotReleaseHandle;
 };
@@ -0,0 +1,744 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMBenchmarkRunner.h"
+#include "UPMSettingsManager.h"
+#include "UPMStatistics.h"
+#include "Camera/CameraActor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "LevelSequence.h"
+#include "LevelSequenceActor.h"
+#include "LevelSequencePlayer.h"
+#include "Json.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "UObject/UObjectGlobals.h"
+
+static const double UPMBenchmarkMapLoadTimeoutSeconds = 120.0;
+static const float UPMBenchmarkDefaultMeasureSeconds = 10.0f;
+
+// Exit codes for -UPMBenchmark
+static const uint8 UPMBenchmarkExitPassed = 0;
+static const uint8 UPMBenchmarkExitThresholdExceeded = 1;
+static const uint8 UPMBenchmarkExitError = 2;
+
+// ==================== JSON Helpers ====================
+
+static FString UPMResolveProjectPath(const FString& FilePath)
+{
+    return FPaths::IsRelative(FilePath) ? FPaths::ProjectDir() / FilePath : FilePath;
+}
+
+static bool UPMReadVector(const TSharedPtr<FJsonObject>& Object, const FString& FieldName, FVector& OutVector)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Values;
+    if (!Object->TryGetArrayField(FieldName, Values) || Values->Num() != 3)
+    {
+        return false;
+    }
+
+    OutVector = FVector((*Values)[0]->AsNumber(), (*Values)[1]->AsNumber(), (*Values)[2]->AsNumber());
+    return true;
+}
+
+static TArray<TSharedPtr<FJsonValue>> UPMMakeVectorArray(double X, double Y, double Z)
+{
+    return { MakeShareable(new FJsonValueNumber(X)), MakeShareable(new FJsonValueNumber(Y)), MakeShareable(new FJsonValueNumber(Z)) };
+}
+
+static void UPMReadCameraPath(const TSharedPtr<FJsonObject>& Object, TArray<FUPMCameraPathPoint>& OutPath)
+{
+    const TArray<TSharedPtr<FJsonValue>>* PointValues;
+    if (!Object->TryGetArrayField(TEXT("CameraPath"), PointValues))
+    {
+        return;
+    }
+
+    OutPath.Reset();
+    for (const TSharedPtr<FJsonValue>& PointValue : *PointValues)
+    {
+        const TSharedPtr<FJsonObject>* PointObject;
+        if (!PointValue->TryGetObject(PointObject))
+        {
+            continue;
+        }
+
+        FUPMCameraPathPoint Point;
+        FVector RotationValues;
+        (*PointObject)->TryGetNumberField(TEXT("Time"), Point.Time);
+        UPMReadVector(*PointObject, TEXT("Location"), Point.Location);
+        if (UPMReadVector(*PointObject, TEXT("Rotation"), RotationValues))
+        {
+            Point.Rotation = FRotator(RotationValues.X, RotationValues.Y, RotationValues.Z); // Pitch, Yaw, Roll
+        }
+        OutPath.Add(Point);
+    }
+
+    OutPath.Sort([](const FUPMCameraPathPoint& A, const FUPMCameraPathPoint& B) { return A.Time < B.Time; });
+}
+
+static TSharedPtr<FJsonObject> UPMLoadJsonFile(const FString& FilePath)
+{
+    FString JsonString;
+    if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to read file: %s"), *FilePath);
+        return nullptr;
+    }
+
+    TSharedPtr<FJsonObject> JsonObject;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+    if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to parse JSON: %s"), *FilePath);
+        return nullptr;
+    }
+    return JsonObject;
+}
+
+// ==================== Setup ====================
+
+UUPMBenchmarkRunner::UUPMBenchmarkRunner()
+    : bLaunchedFromCommandLine(false)
+    , bBenchmarkModeWasEnabled(false)
+    , Phase(EPhase::Idle)
+    , RunIndex(0)
+    , PhaseTime(0.0f)
+    , PathTime(0.0f)
+    , LastFrameTime(0.0)
+    , SequencePlayer(nullptr)
+    , RecordInterval(0.1f)
+    , RecordAccumulator(0.0f)
+{
+}
+
+TSharedPtr<FJsonObject> UUPMBenchmarkRunner::LoadJsonFile(const FString& FilePath)
+{
+    return UPMLoadJsonFile(UPMResolveProjectPath(FilePath));
+}
+
+bool UUPMBenchmarkRunner::LoadConfig(const FString& FilePath, FUPMBenchmarkConfig& OutConfig)
+{
+    TSharedPtr<FJsonObject> JsonObject = LoadJsonFile(FilePath);
+    if (!JsonObject.IsValid())
+    {
+        return false;
+    }
+
+    OutConfig = FUPMBenchmarkConfig();
+    JsonObject->TryGetStringField(TEXT("Name"), OutConfig.Name);
+    JsonObject->TryGetStringField(TEXT("Map"), OutConfig.Map);
+    JsonObject->TryGetStringField(TEXT("Sequence"), OutConfig.Sequence);
+    JsonObject->TryGetNumberField(TEXT("Seed"), OutConfig.Seed);
+    JsonObject->TryGetBoolField(TEXT("FixedTimestep"), OutConfig.bFixedTimestep);
+    JsonObject->TryGetNumberField(TEXT("FixedFrameRate"), OutConfig.FixedFrameRate);
+    JsonObject->TryGetNumberField(TEXT("WarmupSeconds"), OutConfig.WarmupSeconds);
+    JsonObject->TryGetNumberField(TEXT("MeasureSeconds"), OutConfig.MeasureSeconds);
+    JsonObject->TryGetNumberField(TEXT("Repeats"), OutConfig.Repeats);
+    JsonObject->TryGetNumberField(TEXT("MaxMeanFrameTimeMs"), OutConfig.MaxMeanFrameTimeMs);
+    JsonObject->TryGetNumberField(TEXT("MaxP95FrameTimeMs"), OutConfig.MaxP95FrameTimeMs);
+    JsonObject->TryGetNumberField(TEXT("MaxRunToRunVariation"), OutConfig.MaxRunToRunVariation);
+
+    // The path can be inline or in a separate (recorded) file
+    FString CameraPathFile;
+    if (JsonObject->TryGetStringField(TEXT("CameraPathFile"), CameraPathFile))
+    {
+        if (TSharedPtr<FJsonObject> PathObject = UPMLoadJsonFile(UPMResolveProjectPath(CameraPathFile)))
+        {
+            UPMReadCameraPath(PathObject, OutConfig.CameraPath);
+        }
+    }
+    UPMReadCameraPath(JsonObject, OutConfig.CameraPath);
+
+    OutConfig.Repeats = FMath::Clamp(OutConfig.Repeats, 1, 100);
+    OutConfig.FixedFrameRate = FMath::Clamp(OutConfig.FixedFrameRate, 1.0f, 1000.0f);
+    return true;
+}
+
+UUPMBenchmarkRunner* UUPMBenchmarkRunner::StartBenchmark(const UObject* WorldContextObject, const FUPMBenchmarkConfig& Config)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    UUPMBenchmarkRunner* Runner = NewObject<UUPMBenchmarkRunner>();
+    Runner->AddToRoot(); // Released in Cleanup
+    Runner->Config = Config;
+    Runner->Begin(World);
+    return Runner;
+}
+
+void UUPMBenchmarkRunner::LaunchFromCommandLine()
+{
+    FString ConfigPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("UPMBenchmark="), ConfigPath))
+    {
+        NewObject<UUPMBenchmarkRunner>()->Launch(ConfigPath);
+    }
+}
+
+bool UUPMBenchmarkRunner::LoadRunnerConfig(const FString& FilePath)
+{
+    return LoadConfig(FilePath, Config);
+}
+
+void UUPMBenchmarkRunner::Launch(const FString& ConfigPath)
+{
+    AddToRoot(); // Released in Cleanup
+    bLaunchedFromCommandLine = true;
+
+    if (!LoadRunnerConfig(ConfigPath))
+    {
+        Fail(FString::Printf(TEXT("Could not load benchmark config %s"), *ConfigPath));
+        return;
+    }
+
+    UWorld* GameWorld = nullptr;
+    if (GEngine)
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            if (Context.WorldType == EWorldType::Game && Context.World())
+            {
+                GameWorld = Context.World();
+                break;
+            }
+        }
+    }
+
+    if (!GameWorld)
+    {
+        Fail(TEXT("No game world (run with -game)"));
+        return;
+    }
+
+    const FString LoadedMap = UWorld::RemovePIEPrefix(GameWorld->GetOutermost()->GetName());
+    const FString& Map = Config.Map;
+    const bool bMapLoaded = Map.IsEmpty() || LoadedMap == Map || FPackageName::GetShortName(LoadedMap) == Map;
+
+    if (bMapLoaded)
+    {
+        Begin(GameWorld);
+        return;
+    }
+
+    // Start once the benchmark map has loaded
+    Phase = EPhase::WaitingForMap;
+    LastFrameTime = FPlatformTime::Seconds();
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UUPMBenchmarkRunner::OnPostLoadMap);
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUPMBenchmarkRunner::TickBenchmark));
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Benchmark '%s' loading map %s"), *Config.Name, *Map);
+    UGameplayStatics::OpenLevel(GameWorld, FName(*Map));
+}
+
+void UUPMBenchmarkRunner::OnPostLoadMap(UWorld* LoadedWorld)
+{
+    if (Phase == EPhase::WaitingForMap && LoadedWorld && LoadedWorld->IsGameWorld())
+    {
+        FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+        Begin(LoadedWorld);
+    }
+}
+
+void UUPMBenchmarkRunner::Begin(UWorld* InWorld)
+{
+    if (!InWorld)
+    {
+        Fail(TEXT("No world to benchmark"));
+        return;
+    }
+
+    World = InWorld;
+
+    if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(InWorld))
+    {
+        bBenchmarkModeWasEnabled = Manager->GetDebugSettings().bBenchmarkMode;
+        Manager->SetBenchmarkMode(true);
+    }
+
+    if (Config.bFixedTimestep)
+    {
+        FApp::SetUseFixedTimeStep(true);
+        FApp::SetFixedDeltaTime(1.0 / Config.FixedFrameRate);
+    }
+
+    SetupCamera();
+    if (Phase == EPhase::Finished)
+    {
+        return; // Setup failed
+    }
+
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUPMBenchmarkRunner::TickBenchmark));
+    }
+
+    Summary = FUPMBenchmarkSummary();
+    Summary.Name = Config.Name;
+    AllFrameTimes.Reset();
+    RunIndex = 0;
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Benchmark '%s' started (%d runs, seed %d, %s timestep)"),
+        *Config.Name, GetTotalRuns(), Config.Seed, Config.bFixedTimestep ? TEXT("fixed") : TEXT("variable"));
+
+    StartRun();
+}
+
+void UUPMBenchmarkRunner::SetupCamera()
+{
+    UWorld* CurrentWorld = World.Get();
+    APlayerController* PlayerController = CurrentWorld->GetFirstPlayerController();
+
+    if (!Config.Sequence.IsEmpty())
+    {
+        ULevelSequence* LevelSequence = LoadObject<ULevelSequence>(nullptr, *Config.Sequence);
+        if (!LevelSequence)
+        {
+            Fail(FString::Printf(TEXT("Could not load sequence %s"), *Config.Sequence));
+            return;
+        }
+
+        // Loops so a warmup or measured phase longer than the sequence keeps playing; camera cuts take the view
+        FMovieSceneSequencePlaybackSettings PlaybackSettings;
+        PlaybackSettings.LoopCount.Value = -1;
+
+        ALevelSequenceActor* OutActor = nullptr;
+        SequencePlayer = ULevelSequencePlayer::CreateLevelSequencePlayer(CurrentWorld, LevelSequence, PlaybackSettings, OutActor);
+        SequenceActor = OutActor;
+        return;
+    }
+
+    // Without a path the player's own view is measured
+    if (Config.CameraPath.Num() == 0)
+    {
+        return;
+    }
+
+    LocationCurve.Reset();
+    RotationCurve.Reset();
+    for (const FUPMCameraPathPoint& Point : Config.CameraPath)
+    {
+        const int32 LocationIndex = LocationCurve.AddPoint(Point.Time, Point.Location);
+        LocationCurve.Points[LocationIndex].InterpMode = CIM_CurveAuto;
+
+        const int32 RotationIndex = RotationCurve.AddPoint(Point.Time, Point.Rotation.Quaternion());
+        RotationCurve.Points[RotationIndex].InterpMode = CIM_Linear;
+    }
+    LocationCurve.AutoSetTangents();
+    RotationCurve.AutoSetTangents();
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    Camera = CurrentWorld->SpawnActor<ACameraActor>(Config.CameraPath[0].Location, Config.CameraPath[0].Rotation, SpawnParameters);
+
+    if (PlayerController && Camera.IsValid())
+    {
+        PlayerController->SetViewTarget(Camera.Get());
+    }
+}
+
+float UUPMBenchmarkRunner::GetPathDuration() const
+{
+    if (SequencePlayer)
+    {
+        return SequencePlayer->GetDuration().AsSeconds();
+    }
+    return Config.CameraPath.Num() > 0 ? Config.CameraPath.Last().Time : 0.0f;
+}
+
+void UUPMBenchmarkRunner::UpdateCamera(float InPathTime)
+{
+    ACameraActor* CameraActor = Camera.Get();
+    if (!CameraActor || LocationCurve.Points.Num() == 0)
+    {
+        return;
+    }
+
+    CameraActor->SetActorLocationAndRotation(
+        LocationCurve.Eval(InPathTime, FVector::ZeroVector),
+        RotationCurve.Eval(InPathTime, FQuat::Identity));
+}
+
+// ==================== Runs ====================
+
+void UUPMBenchmarkRunner::PrepareRun(int32 InRunIndex)
+{
+}
+
+void UUPMBenchmarkRunner::OnRunMeasured(int32 InRunIndex, const FUPMBenchmarkRunResult& Result)
+{
+    UE_LOG(LogTemp, Log, TEXT("UPM: Benchmark run %d/%d: mean %.2f ms, P95 %.2f ms, P99 %.2f ms (%d frames)"),
+        InRunIndex + 1, GetTotalRuns(), Result.MeanFrameTimeMs, Result.P95FrameTimeMs, Result.P99FrameTimeMs, Result.Frames);
+}
+
+void UUPMBenchmarkRunner::StartRun()
+{
+    PrepareRun(RunIndex);
+
+    // Every run starts from the same random state and the start of the path
+    FMath::RandInit(Config.Seed);
+    FMath::SRandInit(Config.Seed);
+
+    Phase = EPhase::Warmup;
+    PhaseTime = 0.0f;
+    PathTime = 0.0f;
+    LastFrameTime = 0.0;
+
+    FrameTimes.Reset();
+    GameThreadTimes.Reset();
+    RenderThreadTimes.Reset();
+    GPUTimes.Reset();
+
+    if (SequencePlayer)
+    {
+        SequencePlayer->Stop();
+        SequencePlayer->Play();
+    }
+    UpdateCamera(0.0f);
+}
+
+bool UUPMBenchmarkRunner::TickBenchmark(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    if (Phase == EPhase::Recording)
+    {
+        UWorld* CurrentWorld = World.Get();
+        APlayerController* PlayerController = CurrentWorld ? CurrentWorld->GetFirstPlayerController() : nullptr;
+        RecordAccumulator += DeltaTime;
+        PathTime += DeltaTime;
+
+        if (PlayerController && PlayerController->PlayerCameraManager && RecordAccumulator >= RecordInterval)
+        {
+            RecordAccumulator = 0.0f;
+
+            FUPMCameraPathPoint Point;
+            Point.Time = PathTime;
+            Point.Location = PlayerController->PlayerCameraManager->GetCameraLocation();
+            Point.Rotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+            RecordedPath.Add(Point);
+        }
+        return true;
+    }
+
+    if (Phase == EPhase::WaitingForMap)
+    {
+        if (Now - LastFrameTime > UPMBenchmarkMapLoadTimeoutSeconds)
+        {
+            Fail(FString::Printf(TEXT("Map %s did not load"), *Config.Map));
+            return false;
+        }
+        return true;
+    }
+
+    if (Phase != EPhase::Warmup && Phase != EPhase::Measure)
+    {
+        return false;
+    }
+
+    if (!World.IsValid())
+    {
+        Fail(TEXT("The benchmark world was unloaded"));
+        return false;
+    }
+
+    // Game time advances by the (possibly fixed) engine delta, frame time is measured in real time
+    const float GameDeltaTime = static_cast<float>(FApp::GetDeltaTime());
+    PhaseTime += GameDeltaTime;
+    PathTime += GameDeltaTime;
+
+    const float PathDuration = GetPathDuration();
+
+    if (Phase == EPhase::Warmup)
+    {
+        UpdateCamera(PathDuration > 0.0f ? FMath::Fmod(PathTime, PathDuration) : PathTime);
+
+        if (PhaseTime >= GetWarmupSeconds())
+        {
+            Phase = EPhase::Measure;
+            PhaseTime = 0.0f;
+            PathTime = 0.0f;
+            LastFrameTime = Now;
+
+            if (SequencePlayer)
+            {
+                SequencePlayer->Stop();
+                SequencePlayer->Play();
+            }
+            UpdateCamera(0.0f);
+        }
+        return true;
+    }
+
+    UpdateCamera(PathTime);
+
+    FrameTimes.Add(static_cast<float>((Now - LastFrameTime) * 1000.0));
+    GameThreadTimes.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+    RenderThreadTimes.Add(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+    GPUTimes.Add(FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles()));
+    LastFrameTime = Now;
+
+    const float MeasureDuration = Config.MeasureSeconds > 0.0f ? Config.MeasureSeconds
+        : (PathDuration > 0.0f ? PathDuration : UPMBenchmarkDefaultMeasureSeconds);
+
+    if (PhaseTime >= MeasureDuration)
+    {
+        const FUPMBenchmarkRunResult Result = EvaluateRun();
+        Summary.Runs.Add(Result);
+        OnRunMeasured(RunIndex, Result);
+
+        RunIndex++;
+        if (RunIndex >= GetTotalRuns())
+        {
+            Finish();
+            return false;
+        }
+        StartRun();
+    }
+    return true;
+}
+
+FUPMBenchmarkRunResult UUPMBenchmarkRunner::EvaluateRun()
+{
+    TArray<float> SortedFrameTimes = FrameTimes;
+    SortedFrameTimes.Sort();
+
+    FUPMBenchmarkRunResult Result;
+    Result.Frames = FrameTimes.Num();
+    Result.MeanFrameTimeMs = FUPMStatistics::Mean(FrameTimes);
+    Result.StdDevFrameTimeMs = FUPMStatistics::StdDev(FrameTimes);
+    Result.P50FrameTimeMs = FUPMStatistics::PercentileSorted(SortedFrameTimes, 50.0f);
+    Result.P95FrameTimeMs = FUPMStatistics::PercentileSorted(SortedFrameTimes, 95.0f);
+    Result.P99FrameTimeMs = FUPMStatistics::PercentileSorted(SortedFrameTimes, 99.0f);
+    Result.MeanGameThreadMs = FUPMStatistics::Mean(GameThreadTimes);
+    Result.MeanRenderThreadMs = FUPMStatistics::Mean(RenderThreadTimes);
+    Result.MeanGPUMs = FUPMStatistics::Mean(GPUTimes);
+
+    AllFrameTimes.Append(FrameTimes);
+    return Result;
+}
+
+// ==================== Results ====================
+
+void UUPMBenchmarkRunner::Finish()
+{
+    Phase = EPhase::Finished;
+
+    TArray<float> RunMeans;
+    for (const FUPMBenchmarkRunResult& Run : Summary.Runs)
+    {
+        RunMeans.Add(Run.MeanFrameTimeMs);
+    }
+
+    AllFrameTimes.Sort();
+    Summary.MeanFrameTimeMs = FUPMStatistics::Mean(RunMeans);
+    Summary.ConfidenceInterval95Ms = FUPMStatistics::ConfidenceInterval95(RunMeans);
+    Summary.RunToRunVariation = Summary.MeanFrameTimeMs > 0.0f ? FUPMStatistics::StdDev(RunMeans) / Summary.MeanFrameTimeMs : 0.0f;
+    Summary.P50FrameTimeMs = FUPMStatistics::PercentileSorted(AllFrameTimes, 50.0f);
+    Summary.P95FrameTimeMs = FUPMStatistics::PercentileSorted(AllFrameTimes, 95.0f);
+    Summary.P99FrameTimeMs = FUPMStatistics::PercentileSorted(AllFrameTimes, 99.0f);
+
+    Summary.bPassed = (Config.MaxMeanFrameTimeMs <= 0.0f || Summary.MeanFrameTimeMs <= Config.MaxMeanFrameTimeMs)
+        && (Config.MaxP95FrameTimeMs <= 0.0f || Summary.P95FrameTimeMs <= Config.MaxP95FrameTimeMs)
+        && (Config.MaxRunToRunVariation <= 0.0f || Summary.RunToRunVariation <= Config.MaxRunToRunVariation);
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField("Name", Config.Name);
+    RootObject->SetStringField("Map", Config.Map);
+    RootObject->SetNumberField("Seed", Config.Seed);
+    RootObject->SetBoolField("FixedTimestep", Config.bFixedTimestep);
+    RootObject->SetNumberField("FixedFrameRate", Config.FixedFrameRate);
+    RootObject->SetNumberField("Repeats", Summary.Runs.Num());
+    RootObject->SetBoolField("Passed", Summary.bPassed);
+    RootObject->SetNumberField("MeanFrameTimeMs", Summary.MeanFrameTimeMs);
+    RootObject->SetNumberField("ConfidenceInterval95Ms", Summary.ConfidenceInterval95Ms);
+    RootObject->SetNumberField("P50FrameTimeMs", Summary.P50FrameTimeMs);
+    RootObject->SetNumberField("P95FrameTimeMs", Summary.P95FrameTimeMs);
+    RootObject->SetNumberField("P99FrameTimeMs", Summary.P99FrameTimeMs);
+    RootObject->SetNumberField("RunToRunVariation", Summary.RunToRunVariation);
+
+    TArray<TSharedPtr<FJsonValue>> RunValues;
+    for (const FUPMBenchmarkRunResult& Run : Summary.Runs)
+    {
+        TSharedPtr<FJsonObject> RunObject = MakeShareable(new FJsonObject);
+        RunObject->SetNumberField("Frames", Run.Frames);
+        RunObject->SetNumberField("MeanFrameTimeMs", Run.MeanFrameTimeMs);
+        RunObject->SetNumberField("StdDevFrameTimeMs", Run.StdDevFrameTimeMs);
+        RunObject->SetNumberField("P50FrameTimeMs", Run.P50FrameTimeMs);
+        RunObject->SetNumberField("P95FrameTimeMs", Run.P95FrameTimeMs);
+        RunObject->SetNumberField("P99FrameTimeMs", Run.P99FrameTimeMs);
+        RunObject->SetNumberField("MeanGameThreadMs", Run.MeanGameThreadMs);
+        RunObject->SetNumberField("MeanRenderThreadMs", Run.MeanRenderThreadMs);
+        RunObject->SetNumberField("MeanGPUMs", Run.MeanGPUMs);
+        RunValues.Add(MakeShareable(new FJsonValueObject(RunObject)));
+    }
+    RootObject->SetArrayField("Runs", RunValues);
+
+    Summary.ResultFilePath = WriteResultFile(RootObject);
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Benchmark '%s' %s: mean %.2f +/- %.2f ms (95%% CI), P50 %.2f, P95 %.2f, P99 %.2f ms, run-to-run %.1f%%"),
+        *Config.Name, Summary.bPassed ? TEXT("passed") : TEXT("FAILED"), Summary.MeanFrameTimeMs, Summary.ConfidenceInterval95Ms,
+        Summary.P50FrameTimeMs, Summary.P95FrameTimeMs, Summary.P99FrameTimeMs, Summary.RunToRunVariation * 100.0f);
+
+    OnBenchmarkFinished.Broadcast(Summary);
+    Cleanup();
+
+    if (bLaunchedFromCommandLine)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, Summary.bPassed ? UPMBenchmarkExitPassed : UPMBenchmarkExitThresholdExceeded);
+    }
+}
+
+FString UUPMBenchmarkRunner::WriteResultFile(const TSharedPtr<FJsonObject>& RootObject) const
+{
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to serialize benchmark results"));
+        return FString();
+    }
+
+    const FString FileName = FString::Printf(TEXT("%s-%s.json"),
+        *FPaths::MakeValidFileName(Config.Name), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")));
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("Benchmarks") / FileName;
+
+    if (!FFileHelper::SaveStringToFile(OutputString, *FilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write benchmark results to file: %s"), *FilePath);
+        return FString();
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Benchmark results written to %s"), *FilePath);
+    return FilePath;
+}
+
+void UUPMBenchmarkRunner::Fail(const FString& Reason)
+{
+    UE_LOG(LogTemp, Error, TEXT("UPM: Benchmark '%s' failed: %s"), *Config.Name, *Reason);
+
+    Phase = EPhase::Finished;
+    Cleanup();
+
+    if (bLaunchedFromCommandLine)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, UPMBenchmarkExitError);
+    }
+}
+
+void UUPMBenchmarkRunner::Cleanup()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+    if (Config.bFixedTimestep)
+    {
+        FApp::SetUseFixedTimeStep(false);
+    }
+
+    if (SequencePlayer)
+    {
+        SequencePlayer->Stop();
+        SequencePlayer = nullptr;
+    }
+
+    if (ALevelSequenceActor* SequenceActorPtr = SequenceActor.Get())
+    {
+        SequenceActorPtr->Destroy();
+    }
+
+    if (ACameraActor* CameraActor = Camera.Get())
+    {
+        if (APlayerController* PlayerController = CameraActor->GetWorld()->GetFirstPlayerController())
+        {
+            PlayerController->SetViewTarget(PlayerController->GetPawn() ? static_cast<AActor*>(PlayerController->GetPawn()) : PlayerController);
+        }
+        CameraActor->Destroy();
+    }
+
+    if (UWorld* CurrentWorld = World.Get())
+    {
+        if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(CurrentWorld))
+        {
+            Manager->SetBenchmarkMode(bBenchmarkModeWasEnabled);
+        }
+    }
+
+    if (IsRooted())
+    {
+        RemoveFromRoot();
+    }
+}
+
+// ==================== Camera Path Recording ====================
+
+UUPMBenchmarkRunner* UUPMBenchmarkRunner::StartCameraPathRecording(const UObject* WorldContextObject, float SampleInterval)
+{
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+    if (!World)
+    {
+        return nullptr;
+    }
+
+    UUPMBenchmarkRunner* Runner = NewObject<UUPMBenchmarkRunner>();
+    Runner->AddToRoot(); // Released in StopCameraPathRecording
+    Runner->World = World;
+    Runner->Phase = EPhase::Recording;
+    Runner->RecordInterval = FMath::Max(SampleInterval, 0.01f);
+    Runner->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Runner, &UUPMBenchmarkRunner::TickBenchmark));
+    return Runner;
+}
+
+bool UUPMBenchmarkRunner::StopCameraPathRecording(const FString& FilePath)
+{
+    if (Phase != EPhase::Recording)
+    {
+        return false;
+    }
+
+    Phase = EPhase::Finished;
+    Cleanup();
+
+    if (RecordedPath.Num() == 0)
+    {
+        return false;
+    }
+
+    TArray<TSharedPtr<FJsonValue>> PointValues;
+    for (const FUPMCameraPathPoint& Point : RecordedPath)
+    {
+        TSharedPtr<FJsonObject> PointObject = MakeShareable(new FJsonObject);
+        PointObject->SetNumberField("Time", Point.Time);
+        PointObject->SetArrayField("Location", UPMMakeVectorArray(Point.Location.X, Point.Location.Y, Point.Location.Z));
+        PointObject->SetArrayField("Rotation", UPMMakeVectorArray(Point.Rotation.Pitch, Point.Rotation.Yaw, Point.Rotation.Roll));
+        PointValues.Add(MakeShareable(new FJsonValueObject(PointObject)));
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetArrayField("CameraPath", PointValues);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    const FString FullPath = UPMResolveProjectPath(FilePath);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer) || !FFileHelper::SaveStringToFile(OutputString, *FullPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write camera path to file: %s"), *FullPath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Recorded %d camera path points to %s"), RecordedPath.Num(), *FullPath);
+    return true;
+}
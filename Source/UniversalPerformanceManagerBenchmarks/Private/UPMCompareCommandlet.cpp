@@ -0,0 +1,47 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMCompareCommandlet.h"
+#include "UPMFrameTimeComparison.h"
+#include "Misc/OutputDeviceRedirector.h"
+#include "Misc/Parse.h"
+
+UUPMCompareCommandlet::UUPMCompareCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UUPMCompareCommandlet::Main(const FString& Params)
+{
+    FString BaselinePath;
+    FString CandidatePath;
+    if (!FParse::Value(*Params, TEXT("Baseline="), BaselinePath) || !FParse::Value(*Params, TEXT("Candidate="), CandidatePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Usage: -run=UPMCompare -Baseline=<a.csv> -Candidate=<b.csv> [-Column=FrameTimeMs]"));
+        return 2;
+    }
+
+    FString Column = TEXT("FrameTimeMs");
+    FParse::Value(*Params, TEXT("Column="), Column);
+
+    FUPMFrameTimeComparisonOptions Options;
+    FParse::Value(*Params, TEXT("Iterations="), Options.BootstrapIterations);
+    FParse::Value(*Params, TEXT("BlockLength="), Options.BlockLength);
+    FParse::Value(*Params, TEXT("Alpha="), Options.Alpha);
+    FParse::Value(*Params, TEXT("MinChange="), Options.MinRelativeChange);
+    FParse::Value(*Params, TEXT("Seed="), Options.Seed);
+
+    TArray<float> Baseline;
+    TArray<float> Candidate;
+    if (!FUPMFrameTimeComparison::LoadFrameTimes(BaselinePath, Baseline, Column)
+        || !FUPMFrameTimeComparison::LoadFrameTimes(CandidatePath, Candidate, Column))
+    {
+        return 2;
+    }
+
+    const FUPMFrameTimeComparisonResult Result = FUPMFrameTimeComparison::Compare(Baseline, Candidate, Options);
+    FUPMFrameTimeComparison::PrintReport(Result, *GLog);
+    return Result.bRegression ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMEffectsBudgetBenchmark.h"
+#include "UPMTickBudgetSubsystem.h"
+#include "UPMSettingsManager.h"
+#include "UPMStatistics.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+#include "Json.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+AUPMEffectsBudgetBenchmark::AUPMEffectsBudgetBenchmark()
+    : System(nullptr)
+    , NumSystems(500)
+    , GridSpacing(200.0f)
+    , BudgetMs(0.0f)
+    , WarmupDuration(3.0f)
+    , PhaseDuration(15.0f)
+    , bExitWhenFinished(false)
+    , Phase(EPhase::Warmup)
+    , PhaseTime(0.0f)
+    , bEffectsBudgetWasEnabled(false)
+    , EffectsBudgetMsWas(0.0f)
+    , FXBudgetEnabledWas(0)
+    , bRestoreFXBudget(false)
+    , MinSpawnScale(1.0f)
+{
+    PrimaryActorTick.bCanEverTick = true;
+    RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+    // The benchmark itself must not be throttled
+    Tags.Add(UUPMTickBudgetSubsystem::NoThrottleTag);
+}
+
+void AUPMEffectsBudgetBenchmark::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this))
+    {
+        bEffectsBudgetWasEnabled = Manager->GetPerformanceSettings().bEnableEffectsBudget;
+        EffectsBudgetMsWas = Manager->GetPerformanceSettings().EffectsBudgetMs;
+    }
+    if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("fx.Budget.Enabled")))
+    {
+        FXBudgetEnabledWas = CVar->GetInt();
+    }
+
+    SpawnSystems();
+    EnterPhase(EPhase::Warmup);
+}
+
+void AUPMEffectsBudgetBenchmark::SpawnSystems()
+{
+    UWorld* World = GetWorld();
+    if (!World || !System)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Effects budget benchmark has no Niagara system to spawn"));
+        return;
+    }
+
+    const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumSystems)));
+    const FVector Origin = GetActorLocation() - FVector(GridSize * GridSpacing * 0.5f, GridSize * GridSpacing * 0.5f, 0.0f);
+
+    for (int32 Index = 0; Index < NumSystems; ++Index)
+    {
+        const FVector Location = Origin + FVector((Index % GridSize) * GridSpacing, (Index / GridSize) * GridSpacing, 0.0f);
+        UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, System, Location, FRotator::ZeroRotator, FVector::OneVector, false);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Effects budget benchmark spawned %d instances of %s"), NumSystems, *System->GetPathName());
+}
+
+void AUPMEffectsBudgetBenchmark::EnterPhase(EPhase NewPhase)
+{
+    Phase = NewPhase;
+    PhaseTime = 0.0f;
+
+    UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this);
+    IConsoleVariable* FXBudgetCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("fx.Budget.Enabled"));
+    if (!Manager)
+    {
+        return;
+    }
+
+    switch (Phase)
+    {
+    case EPhase::Warmup:
+    case EPhase::Baseline:
+        Manager->SetEffectsBudgetEnabled(false);
+        if (FXBudgetCVar)
+        {
+            FXBudgetCVar->Set(1);
+        }
+        break;
+    case EPhase::Budgeted:
+        Manager->SetEffectsBudgetMs(BudgetMs);
+        Manager->SetEffectsBudgetEnabled(true);
+        break;
+    case EPhase::Finished:
+        // fx.Budget.Enabled goes back next frame, after the manager restored its own values
+        Manager->SetEffectsBudgetMs(EffectsBudgetMsWas);
+        Manager->SetEffectsBudgetEnabled(bEffectsBudgetWasEnabled);
+        bRestoreFXBudget = !bEffectsBudgetWasEnabled;
+        break;
+    }
+}
+
+void AUPMEffectsBudgetBenchmark::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (Phase == EPhase::Finished)
+    {
+        if (bRestoreFXBudget)
+        {
+            if (IConsoleVariable* CVar = IConsoleManager::Get().FindConsoleVariable(TEXT("fx.Budget.Enabled")))
+            {
+                CVar->Set(FXBudgetEnabledWas);
+            }
+            bRestoreFXBudget = false;
+
+            if (bExitWhenFinished)
+            {
+                FPlatformMisc::RequestExit(false);
+            }
+        }
+        return;
+    }
+
+    PhaseTime += DeltaTime;
+
+    const UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this);
+    const FUPMPerformanceMetrics Metrics = Manager ? Manager->GetPerformanceMetrics() : FUPMPerformanceMetrics();
+    const float EffectsMs = FMath::Max(Metrics.Process.EffectsGameThreadMs, Metrics.Process.EffectsRenderThreadMs);
+
+    switch (Phase)
+    {
+    case EPhase::Warmup:
+        if (PhaseTime >= WarmupDuration)
+        {
+            EnterPhase(EPhase::Baseline);
+        }
+        break;
+
+    case EPhase::Baseline:
+        BaselineFrameTimes.Add(DeltaTime * 1000.0f);
+        BaselineEffectsTimes.Add(EffectsMs);
+        if (PhaseTime >= PhaseDuration)
+        {
+            EnterPhase(EPhase::Budgeted);
+        }
+        break;
+
+    case EPhase::Budgeted:
+        // The first seconds are the spawn scale converging, not the steady state
+        if (PhaseTime >= 3.0f)
+        {
+            BudgetedFrameTimes.Add(DeltaTime * 1000.0f);
+            BudgetedEffectsTimes.Add(EffectsMs);
+        }
+        MinSpawnScale = FMath::Min(MinSpawnScale, Metrics.Process.EffectsSpawnScale);
+        if (PhaseTime >= PhaseDuration + 3.0f)
+        {
+            ReportResults();
+            EnterPhase(EPhase::Finished);
+            if (bExitWhenFinished && !bRestoreFXBudget)
+            {
+                FPlatformMisc::RequestExit(false);
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void AUPMEffectsBudgetBenchmark::ReportResults()
+{
+    const UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(this);
+    const float EffectiveBudgetMs = Manager ? Manager->GetPerformanceMetrics().Process.EffectsBudgetMs : 0.0f;
+
+    auto MakePhaseObject = [](const TArray<float>& FrameTimes, const TArray<float>& EffectsTimes)
+    {
+        TSharedPtr<FJsonObject> PhaseObject = MakeShareable(new FJsonObject);
+        PhaseObject->SetNumberField("Frames", FrameTimes.Num());
+        PhaseObject->SetNumberField("FrameTimeMeanMs", FUPMStatistics::Mean(FrameTimes));
+        PhaseObject->SetNumberField("FrameTimeP95Ms", FUPMStatistics::Percentile(FrameTimes, 95.0f));
+        PhaseObject->SetNumberField("EffectsMeanMs", FUPMStatistics::Mean(EffectsTimes));
+        PhaseObject->SetNumberField("EffectsP95Ms", FUPMStatistics::Percentile(EffectsTimes, 95.0f));
+        return PhaseObject;
+    };
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField("System", System ? System->GetPathName() : FString());
+    RootObject->SetNumberField("Systems", NumSystems);
+    RootObject->SetNumberField("EffectsBudgetMs", EffectiveBudgetMs);
+    RootObject->SetNumberField("MinSpawnScale", MinSpawnScale);
+    RootObject->SetObjectField("Baseline", MakePhaseObject(BaselineFrameTimes, BaselineEffectsTimes));
+    RootObject->SetObjectField("Budgeted", MakePhaseObject(BudgetedFrameTimes, BudgetedEffectsTimes));
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Effects budget benchmark (%d systems, budget %.2f ms)"), NumSystems, EffectiveBudgetMs);
+    UE_LOG(LogTemp, Log, TEXT("UPM:   Baseline effects mean %.2f ms, P95 %.2f ms, frame mean %.2f ms"),
+        FUPMStatistics::Mean(BaselineEffectsTimes), FUPMStatistics::Percentile(BaselineEffectsTimes, 95.0f),
+        FUPMStatistics::Mean(BaselineFrameTimes));
+    UE_LOG(LogTemp, Log, TEXT("UPM:   Budgeted effects mean %.2f ms, P95 %.2f ms, frame mean %.2f ms, spawn scale down to %.2f"),
+        FUPMStatistics::Mean(BudgetedEffectsTimes), FUPMStatistics::Percentile(BudgetedEffectsTimes, 95.0f),
+        FUPMStatistics::Mean(BudgetedFrameTimes), MinSpawnScale);
+
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer))
+    {
+        const FString FilePath = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("EffectsBudgetBenchmark.json");
+        if (!FFileHelper::SaveStringToFile(OutputString, *FilePath))
+        {
+            UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write benchmark results to file: %s"), *FilePath);
+        }
+    }
+}
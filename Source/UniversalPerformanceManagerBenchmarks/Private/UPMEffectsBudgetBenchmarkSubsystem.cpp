@@ -0,0 +1,59 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMEffectsBudgetBenchmarkSubsystem.h"
+#include "UPMEffectsBudgetBenchmark.h"
+#include "NiagaraSystem.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+bool UUPMEffectsBudgetBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Effects are not simulated on dedicated servers
+    return !IsRunningDedicatedServer()
+        && FCString::Strifind(FCommandLine::Get(), TEXT("UPMEffectsBudgetBenchmark=")) != nullptr
+        && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UUPMEffectsBudgetBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UUPMEffectsBudgetBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // -UPMEffectsBudgetBenchmark=<NiagaraSystem> turns any map (e.g. /Engine/Maps/Entry with -nullrhi) into the benchmark
+    static bool bBenchmarkSpawned = false;
+
+    FString SystemPath;
+    if (bBenchmarkSpawned || InWorld.GetNetMode() == NM_Client
+        || !FParse::Value(FCommandLine::Get(), TEXT("UPMEffectsBudgetBenchmark="), SystemPath))
+    {
+        return;
+    }
+    bBenchmarkSpawned = true;
+
+    UNiagaraSystem* System = LoadObject<UNiagaraSystem>(nullptr, *SystemPath);
+    if (!System)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Effects budget benchmark could not load Niagara system: %s"), *SystemPath);
+        return;
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    SpawnParameters.bDeferConstruction = true;
+
+    AUPMEffectsBudgetBenchmark* Benchmark = InWorld.SpawnActor<AUPMEffectsBudgetBenchmark>(
+        AUPMEffectsBudgetBenchmark::StaticClass(), FTransform::Identity, SpawnParameters);
+    if (Benchmark)
+    {
+        FParse::Value(FCommandLine::Get(), TEXT("UPMEffectsBudgetBenchmarkCount="), Benchmark->NumSystems);
+        FParse::Value(FCommandLine::Get(), TEXT("UPMEffectsBudgetBenchmarkBudgetMs="), Benchmark->BudgetMs);
+        Benchmark->System = System;
+        Benchmark->bExitWhenFinished = true;
+        Benchmark->FinishSpawning(FTransform::Identity);
+    }
+}
@@ -0,0 +1,33 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSelfBenchmarkCommandlet.h"
+#include "UPMSelfBenchmark.h"
+#include "UPMSettingsManager.h"
+#include "Misc/OutputDeviceRedirector.h"
+#include "Misc/Parse.h"
+
+UUPMSelfBenchmarkCommandlet::UUPMSelfBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UUPMSelfBenchmarkCommandlet::Main(const FString& Params)
+{
+    FUPMSelfBenchmarkOptions Options;
+    FParse::Value(*Params, TEXT("Baseline="), Options.BaselinePath);
+    FParse::Value(*Params, TEXT("Tolerance="), Options.Tolerance);
+    Options.bUpdateBaseline = FParse::Param(*Params, TEXT("UpdateBaseline"));
+
+    // Default settings, there is no game world or player settings to preserve here
+    UUPMSettingsManager* Manager = NewObject<UUPMSettingsManager>();
+    Manager->AddToRoot();
+
+    TArray<FUPMSelfBenchmarkCase> Cases;
+    const bool bPassed = FUPMSelfBenchmark::Run(Manager, Options, Cases, *GLog);
+
+    Manager->RemoveFromRoot();
+    return bPassed ? 0 : 1;
+}
@@ -0,0 +1,393 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UPMSweepRunner.h"
+#include "UPMStatistics.h"
+#include "Json.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+static const int32 UPMSweepMaxCombinations = 256;
+
+static FString UPMGetSweepResultsPath()
+{
+    return FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("SweepResults.json");
+}
+
+UUPMSweepRunner::UUPMSweepRunner()
+    : SettleSeconds(3.0f)
+    , bOriginalSettingsCaptured(false)
+    , CurrentCombination(INDEX_NONE)
+    , bSettling(false)
+{
+}
+
+void UUPMSweepRunner::LaunchFromCommandLine()
+{
+    FString ConfigPath;
+    if (FParse::Value(FCommandLine::Get(), TEXT("UPMSweep="), ConfigPath))
+    {
+        NewObject<UUPMSweepRunner>()->Launch(ConfigPath);
+    }
+}
+
+bool UUPMSweepRunner::LoadRunnerConfig(const FString& FilePath)
+{
+    if (!Super::LoadRunnerConfig(FilePath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> JsonObject = LoadJsonFile(FilePath);
+    const TSharedPtr<FJsonObject>* SweepObject;
+    if (!JsonObject.IsValid() || !JsonObject->TryGetObjectField(TEXT("Sweep"), SweepObject))
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Sweep config %s has no \"Sweep\" object"), *FilePath);
+        return false;
+    }
+
+    (*SweepObject)->TryGetNumberField(TEXT("SettleSeconds"), SettleSeconds);
+    SettleSeconds = FMath::Max(SettleSeconds, 0.0f);
+
+    Axes.Reset();
+    const TArray<TSharedPtr<FJsonValue>>* AxisValues;
+    if ((*SweepObject)->TryGetArrayField(TEXT("Axes"), AxisValues))
+    {
+        for (const TSharedPtr<FJsonValue>& AxisValue : *AxisValues)
+        {
+            const TSharedPtr<FJsonObject>* AxisObject;
+            if (!AxisValue->TryGetObject(AxisObject))
+            {
+                continue;
+            }
+
+            FUPMSweepAxis Axis;
+            (*AxisObject)->TryGetStringField(TEXT("Setting"), Axis.Setting);
+            (*AxisObject)->TryGetNumberField(TEXT("Weight"), Axis.Weight);
+
+            const TArray<TSharedPtr<FJsonValue>>* Values;
+            if ((*AxisObject)->TryGetArrayField(TEXT("Values"), Values))
+            {
+                for (const TSharedPtr<FJsonValue>& Value : *Values)
+                {
+                    Axis.Values.Add(static_cast<float>(Value->AsNumber()));
+                }
+            }
+
+            // Validate every value against a scratch copy so typos fail before anything is measured; a value the
+            // manager would clamp or round would be recorded in the results as something that was never applied
+            FUPMCompleteSettings Scratch;
+            if (Axis.Values.Num() == 0 || !UUPMSettingsManager::SetSettingValue(Scratch, Axis.Setting, Axis.Values[0]))
+            {
+                UE_LOG(LogTemp, Error, TEXT("UPM: Invalid sweep axis '%s' (unknown setting or no values)"), *Axis.Setting);
+                return false;
+            }
+            for (const float Value : Axis.Values)
+            {
+                double AppliedValue = 0.0;
+                if (!UUPMSettingsManager::SetSettingValue(Scratch, Axis.Setting, Value)
+                    || !UUPMSettingsManager::GetSettingValue(Scratch, Axis.Setting, AppliedValue)
+                    || !FMath::IsNearlyEqual(AppliedValue, static_cast<double>(Value), 1e-4))
+                {
+                    UE_LOG(LogTemp, Error, TEXT("UPM: Sweep axis '%s' value %g is out of range or invalid for the setting"), *Axis.Setting, Value);
+                    return false;
+                }
+            }
+            Axes.Add(Axis);
+        }
+    }
+
+    const int32 Combinations = GetCombinationCount();
+    if (Axes.Num() == 0 || Combinations > UPMSweepMaxCombinations)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Sweep needs 1-%d combinations, config has %d"), UPMSweepMaxCombinations, Axes.Num() == 0 ? 0 : Combinations);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Sweep '%s': %d axes, %d combinations x %d repeats"), *Config.Name, Axes.Num(), Combinations, Config.Repeats);
+    return true;
+}
+
+int32 UUPMSweepRunner::GetCombinationCount() const
+{
+    int32 Count = 1;
+    for (const FUPMSweepAxis& Axis : Axes)
+    {
+        Count *= FMath::Max(1, Axis.Values.Num());
+    }
+    return Count;
+}
+
+int32 UUPMSweepRunner::GetValueIndex(int32 Combination, int32 AxisIndex) const
+{
+    // Mixed radix, the last axis changes fastest
+    for (int32 Index = Axes.Num() - 1; Index > AxisIndex; --Index)
+    {
+        Combination /= Axes[Index].Values.Num();
+    }
+    return Combination % Axes[AxisIndex].Values.Num();
+}
+
+int32 UUPMSweepRunner::GetTotalRuns() const
+{
+    return GetCombinationCount() * FMath::Max(1, Config.Repeats);
+}
+
+float UUPMSweepRunner::GetWarmupSeconds() const
+{
+    return Config.WarmupSeconds + (bSettling ? SettleSeconds : 0.0f);
+}
+
+void UUPMSweepRunner::PrepareRun(int32 InRunIndex)
+{
+    const int32 Combination = InRunIndex / FMath::Max(1, Config.Repeats);
+    bSettling = Combination != CurrentCombination;
+
+    if (bSettling)
+    {
+        ApplyCombination(Combination);
+    }
+}
+
+void UUPMSweepRunner::ApplyCombination(int32 Combination)
+{
+    UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(World.Get());
+    if (!Manager)
+    {
+        return;
+    }
+
+    if (!bOriginalSettingsCaptured)
+    {
+        OriginalSettings = Manager->GetSettings();
+        bOriginalSettingsCaptured = true;
+    }
+
+    // Every combination starts from the original settings so nothing carries over from the previous one
+    FUPMCompleteSettings Settings = OriginalSettings;
+    FString Description;
+    for (int32 AxisIndex = 0; AxisIndex < Axes.Num(); ++AxisIndex)
+    {
+        const float Value = Axes[AxisIndex].Values[GetValueIndex(Combination, AxisIndex)];
+        UUPMSettingsManager::SetSettingValue(Settings, Axes[AxisIndex].Setting, Value);
+        Description += FString::Printf(TEXT(" %s=%g"), *Axes[AxisIndex].Setting, Value);
+    }
+
+    // The settle time hides the rebuilds
+    Manager->SetAllSettings(Settings);
+    Manager->NotifySafePoint();
+    FlushRenderingCommands();
+
+    CurrentCombination = Combination;
+    CombinationRunMeans.Reset();
+    CombinationFrameTimes.Reset();
+
+    UE_LOG(LogTemp, Log, TEXT("UPM: Sweep combination %d/%d:%s"), Combination + 1, GetCombinationCount(), *Description);
+}
+
+void UUPMSweepRunner::OnRunMeasured(int32 InRunIndex, const FUPMBenchmarkRunResult& Result)
+{
+    Super::OnRunMeasured(InRunIndex, Result);
+
+    CombinationRunMeans.Add(Result.MeanFrameTimeMs);
+    CombinationFrameTimes.Append(FrameTimes);
+
+    const int32 Repeats = FMath::Max(1, Config.Repeats);
+    if ((InRunIndex + 1) % Repeats != 0)
+    {
+        return;
+    }
+
+    FUPMSweepResult SweepResult;
+    float WeightedQuality = 0.0f;
+    float TotalWeight = 0.0f;
+    for (int32 AxisIndex = 0; AxisIndex < Axes.Num(); ++AxisIndex)
+    {
+        const FUPMSweepAxis& Axis = Axes[AxisIndex];
+        const float Value = Axis.Values[GetValueIndex(CurrentCombination, AxisIndex)];
+        SweepResult.Settings.Add(Axis.Setting, Value);
+
+        const float MinValue = FMath::Min(Axis.Values);
+        const float MaxValue = FMath::Max(Axis.Values);
+        const float Position = MaxValue > MinValue ? (Value - MinValue) / (MaxValue - MinValue) : 1.0f;
+        WeightedQuality += Position * Axis.Weight;
+        TotalWeight += Axis.Weight;
+    }
+
+    SweepResult.QualityScore = TotalWeight > 0.0f ? WeightedQuality / TotalWeight * 100.0f : 0.0f;
+    SweepResult.MeanFrameTimeMs = FUPMStatistics::Mean(CombinationRunMeans);
+    SweepResult.ConfidenceInterval95Ms = FUPMStatistics::ConfidenceInterval95(CombinationRunMeans);
+    SweepResult.P95FrameTimeMs = FUPMStatistics::Percentile(CombinationFrameTimes, 95.0f);
+    Results.Add(SweepResult);
+}
+
+void UUPMSweepRunner::Finish()
+{
+    Phase = EPhase::Finished;
+
+    float CheapestMs = TNumericLimits<float>::Max();
+    for (const FUPMSweepResult& Result : Results)
+    {
+        CheapestMs = FMath::Min(CheapestMs, Result.MeanFrameTimeMs);
+    }
+
+    for (FUPMSweepResult& Result : Results)
+    {
+        Result.CostMs = Result.MeanFrameTimeMs - CheapestMs;
+        Result.bParetoOptimal = !Results.ContainsByPredicate([&Result](const FUPMSweepResult& Other)
+        {
+            return Other.MeanFrameTimeMs <= Result.MeanFrameTimeMs && Other.QualityScore >= Result.QualityScore
+                && (Other.MeanFrameTimeMs < Result.MeanFrameTimeMs || Other.QualityScore > Result.QualityScore);
+        });
+    }
+
+    // Cheapest first, so the table reads as a cost ladder
+    Results.Sort([](const FUPMSweepResult& A, const FUPMSweepResult& B) { return A.MeanFrameTimeMs < B.MeanFrameTimeMs; });
+
+    TArray<TSharedPtr<FJsonValue>> AxisValues;
+    for (const FUPMSweepAxis& Axis : Axes)
+    {
+        TSharedPtr<FJsonObject> AxisObject = MakeShareable(new FJsonObject);
+        AxisObject->SetStringField("Setting", Axis.Setting);
+        AxisObject->SetNumberField("Weight", Axis.Weight);
+        TArray<TSharedPtr<FJsonValue>> Values;
+        for (float Value : Axis.Values)
+        {
+            Values.Add(MakeShareable(new FJsonValueNumber(Value)));
+        }
+        AxisObject->SetArrayField("Values", Values);
+        AxisValues.Add(MakeShareable(new FJsonValueObject(AxisObject)));
+    }
+
+    FString CostTable = TEXT("QualityScore,MeanFrameTimeMs,ConfidenceInterval95Ms,P95FrameTimeMs,CostMs,ParetoOptimal");
+    for (const FUPMSweepAxis& Axis : Axes)
+    {
+        CostTable += TEXT(",") + Axis.Setting;
+    }
+    CostTable += LINE_TERMINATOR;
+
+    TArray<TSharedPtr<FJsonValue>> ResultValues;
+    UE_LOG(LogTemp, Log, TEXT("UPM: Sweep '%s' results (* = Pareto frontier)"), *Config.Name);
+    for (const FUPMSweepResult& Result : Results)
+    {
+        TSharedPtr<FJsonObject> SettingsObject = MakeShareable(new FJsonObject);
+        FString SettingsColumns;
+        FString SettingsDescription;
+        for (const FUPMSweepAxis& Axis : Axes)
+        {
+            const float Value = Result.Settings.FindRef(Axis.Setting);
+            SettingsObject->SetNumberField(Axis.Setting, Value);
+            SettingsColumns += FString::Printf(TEXT(",%g"), Value);
+            SettingsDescription += FString::Printf(TEXT(" %s=%g"), *Axis.Setting, Value);
+        }
+
+        TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject);
+        ResultObject->SetObjectField("Settings", SettingsObject);
+        ResultObject->SetNumberField("QualityScore", Result.QualityScore);
+        ResultObject->SetNumberField("MeanFrameTimeMs", Result.MeanFrameTimeMs);
+        ResultObject->SetNumberField("ConfidenceInterval95Ms", Result.ConfidenceInterval95Ms);
+        ResultObject->SetNumberField("P95FrameTimeMs", Result.P95FrameTimeMs);
+        ResultObject->SetNumberField("CostMs", Result.CostMs);
+        ResultObject->SetBoolField("ParetoOptimal", Result.bParetoOptimal);
+        ResultValues.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+
+        CostTable += FString::Printf(TEXT("%.1f,%.3f,%.3f,%.3f,%.3f,%d%s"), Result.QualityScore, Result.MeanFrameTimeMs,
+            Result.ConfidenceInterval95Ms, Result.P95FrameTimeMs, Result.CostMs, Result.bParetoOptimal ? 1 : 0, *SettingsColumns);
+        CostTable += LINE_TERMINATOR;
+
+        UE_LOG(LogTemp, Log, TEXT("UPM: %s quality %5.1f  %7.2f +/- %.2f ms  P95 %7.2f ms  +%.2f ms %s"),
+            Result.bParetoOptimal ? TEXT("*") : TEXT(" "), Result.QualityScore, Result.MeanFrameTimeMs,
+            Result.ConfidenceInterval95Ms, Result.P95FrameTimeMs, Result.CostMs, *SettingsDescription);
+    }
+
+    TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject);
+    RootObject->SetStringField("Name", Config.Name);
+    RootObject->SetStringField("Map", Config.Map);
+    RootObject->SetNumberField("Repeats", Config.Repeats);
+    RootObject->SetNumberField("SettleSeconds", SettleSeconds);
+    RootObject->SetStringField("Date", FDateTime::Now().ToIso8601());
+    RootObject->SetArrayField("Axes", AxisValues);
+    RootObject->SetArrayField("Results", ResultValues);
+
+    // Fixed file names so preset selection can always find the latest sweep
+    bool bWritten = false;
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    if (FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer))
+    {
+        const FString FilePath = UPMGetSweepResultsPath();
+        const FString TablePath = FPaths::ProjectSavedDir() / TEXT("UPM") / TEXT("SweepCostTable.csv");
+        bWritten = FFileHelper::SaveStringToFile(OutputString, *FilePath) && FFileHelper::SaveStringToFile(CostTable, *TablePath);
+        Summary.ResultFilePath = FilePath;
+    }
+
+    if (!bWritten)
+    {
+        UE_LOG(LogTemp, Error, TEXT("UPM: Failed to write sweep results to %s"), *UPMGetSweepResultsPath());
+    }
+
+    Summary.bPassed = bWritten;
+    OnBenchmarkFinished.Broadcast(Summary);
+    Cleanup();
+
+    if (bLaunchedFromCommandLine)
+    {
+        FPlatformMisc::RequestExitWithStatus(false, bWritten ? 0 : 2);
+    }
+}
+
+void UUPMSweepRunner::Cleanup()
+{
+    if (bOriginalSettingsCaptured)
+    {
+        if (UUPMSettingsManager* Manager = UUPMSettingsManager::GetInstance(World.Get()))
+        {
+            Manager->SetAllSettings(OriginalSettings);
+            Manager->NotifySafePoint();
+        }
+        bOriginalSettingsCaptured = false;
+    }
+
+    Super::Cleanup();
+}
+
+bool UUPMSweepRunner::LoadSweepResults(TArray<FUPMSweepResult>& OutResults)
+{
+    TSharedPtr<FJsonObject> RootObject = LoadJsonFile(UPMGetSweepResultsPath());
+    const TArray<TSharedPtr<FJsonValue>>* ResultValues;
+    if (!RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("Results"), ResultValues))
+    {
+        return false;
+    }
+
+    OutResults.Reset();
+    for (const TSharedPtr<FJsonValue>& ResultValue : *ResultValues)
+    {
+        const TSharedPtr<FJsonObject>* ResultObject;
+        if (!ResultValue->TryGetObject(ResultObject))
+        {
+            continue;
+        }
+
+        FUPMSweepResult Result;
+        (*ResultObject)->TryGetNumberField(TEXT("QualityScore"), Result.QualityScore);
+        (*ResultObject)->TryGetNumberField(TEXT("MeanFrameTimeMs"), Result.MeanFrameTimeMs);
+        (*ResultObject)->TryGetNumberField(TEXT("ConfidenceInterval95Ms"), Result.ConfidenceInterval95Ms);
+        (*ResultObject)->TryGetNumberField(TEXT("P95FrameTimeMs"), Result.P95FrameTimeMs);
+        (*ResultObject)->TryGetNumberField(TEXT("CostMs"), Result.CostMs);
+        (*ResultObject)->TryGetBoolField(TEXT("ParetoOptimal"), Result.bParetoOptimal);
+
+        const TSharedPtr<FJsonObject>* SettingsObject;
+        if ((*ResultObject)->TryGetObjectField(TEXT("Settings"), SettingsObject))
+        {
+            for (const TPair<FString, TSharedPtr<FJsonValue>>& Setting : (*SettingsObject)->Values)
+            {
+                Result.Settings.Add(Setting.Key, static_cast<float>(Setting.Value->AsNumber()));
+            }
+        }
+        OutResults.Add(Result);
+    }
+    return true;
+}
@@ -0,0 +1,340 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/NoExportTypes.h"
+#include "Containers/Ticker.h"
+#include "UPMBenchmarkRunner.generated.h"
+
+class ACameraActor;
+class ALevelSequenceActor;
+class ULevelSequencePlayer;
+class UWorld;
+
+/**
+ * One key of a benchmark camera path
+ */
+USTRUCT(BlueprintType)
+struct FUPMCameraPathPoint
+{
+    GENERATED_BODY()
+
+    // Seconds from the start of the path
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float Time;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FVector Location;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FRotator Rotation;
+
+    FUPMCameraPathPoint()
+        : Time(0.0f)
+        , Location(FVector::ZeroVector)
+        , Rotation(FRotator::ZeroRotator)
+    {
+    }
+};
+
+/**
+ * Benchmark configuration, loaded from JSON (see README for the file format)
+ */
+USTRUCT(BlueprintType)
+struct FUPMBenchmarkConfig
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FString Name;
+
+    // Map to load before running; empty = run in the current map
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FString Map;
+
+    // Level sequence to play instead of a camera path (object path)
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FString Sequence;
+
+    // Camera spline keys, interpolated with an auto curve; record one with StartCameraPathRecording
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    TArray<FUPMCameraPathPoint> CameraPath;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    int32 Seed;
+
+    // Advance the game by exactly 1/FixedFrameRate per frame, independent of how long frames take
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    bool bFixedTimestep;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float FixedFrameRate;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float WarmupSeconds;
+
+    // Measured phase length; 0 = length of the camera path or sequence
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float MeasureSeconds;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    int32 Repeats;
+
+    // Pass/fail thresholds for CI, 0 = not checked
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float MaxMeanFrameTimeMs;
+
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float MaxP95FrameTimeMs;
+
+    // Coefficient of variation of the run means (0.05 = 5%)
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float MaxRunToRunVariation;
+
+    FUPMBenchmarkConfig()
+        : Name(TEXT("Benchmark"))
+        , Seed(12345)
+        , bFixedTimestep(false)
+        , FixedFrameRate(60.0f)
+        , WarmupSeconds(5.0f)
+        , MeasureSeconds(0.0f)
+        , Repeats(3)
+        , MaxMeanFrameTimeMs(0.0f)
+        , MaxP95FrameTimeMs(0.0f)
+        , MaxRunToRunVariation(0.0f)
+    {
+    }
+};
+
+/**
+ * Frame statistics of one measured run
+ */
+USTRUCT(BlueprintType)
+struct FUPMBenchmarkRunResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    int32 Frames;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanFrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float StdDevFrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P50FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P95FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P99FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanGameThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanRenderThreadMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanGPUMs;
+
+    FUPMBenchmarkRunResult()
+        : Frames(0)
+        , MeanFrameTimeMs(0.0f)
+        , StdDevFrameTimeMs(0.0f)
+        , P50FrameTimeMs(0.0f)
+        , P95FrameTimeMs(0.0f)
+        , P99FrameTimeMs(0.0f)
+        , MeanGameThreadMs(0.0f)
+        , MeanRenderThreadMs(0.0f)
+        , MeanGPUMs(0.0f)
+    {
+    }
+};
+
+/**
+ * Result of all repeats of a benchmark
+ */
+USTRUCT(BlueprintType)
+struct FUPMBenchmarkSummary
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    FString Name;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    TArray<FUPMBenchmarkRunResult> Runs;
+
+    // Mean of the run means and the 95% confidence interval half width around it
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanFrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float ConfidenceInterval95Ms;
+
+    // Percentiles over the frames of all runs
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P50FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P95FrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P99FrameTimeMs;
+
+    // Coefficient of variation of the run means
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float RunToRunVariation;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    bool bPassed;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    FString ResultFilePath;
+
+    FUPMBenchmarkSummary()
+        : MeanFrameTimeMs(0.0f)
+        , ConfidenceInterval95Ms(0.0f)
+        , P50FrameTimeMs(0.0f)
+        , P95FrameTimeMs(0.0f)
+        , P99FrameTimeMs(0.0f)
+        , RunToRunVariation(0.0f)
+        , bPassed(false)
+    {
+    }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUPMBenchmarkFinished, const FUPMBenchmarkSummary&, Summary);
+
+/**
+ * Automated benchmark runner
+ *
+ * Loads the configured map, plays a camera path or level sequence with a fixed random seed (and optionally a
+ * fixed timestep), runs a warmup and a measured phase per repeat, and writes mean, confidence interval,
+ * percentiles and run-to-run variation to Saved/UPM/Benchmarks/<Name>-<Timestamp>.json.
+ *
+ * Command line: -UPMBenchmark=<config.json> runs the benchmark and exits with
+ *   0 = passed, 1 = a threshold was exceeded, 2 = the benchmark could not run.
+ */
+UCLASS(BlueprintType)
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API UUPMBenchmarkRunner : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    UUPMBenchmarkRunner();
+
+    /** Load a benchmark configuration; relative paths are resolved against the project directory */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Benchmark")
+    static bool LoadConfig(const FString& FilePath, FUPMBenchmarkConfig& OutConfig);
+
+    /** Run a benchmark in the current world (Config.Map is ignored) */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Benchmark", meta = (WorldContext = "WorldContextObject"))
+    static UUPMBenchmarkRunner* StartBenchmark(const UObject* WorldContextObject, const FUPMBenchmarkConfig& Config);
+
+    /** Entry point for -UPMBenchmark=<config>, called once the engine loop is initialized */
+    static void LaunchFromCommandLine();
+
+    /** Record the player camera into a path that can be pasted into a config's "CameraPath" */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Benchmark", meta = (WorldContext = "WorldContextObject"))
+    static UUPMBenchmarkRunner* StartCameraPathRecording(const UObject* WorldContextObject, float SampleInterval = 0.1f);
+
+    /** Stop recording and write {"CameraPath": [...]} to the given file; returns false if nothing was recorded */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Benchmark")
+    bool StopCameraPathRecording(const FString& FilePath);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Benchmark")
+    bool IsRunning() const { return Phase != EPhase::Idle && Phase != EPhase::Finished; }
+
+    UPROPERTY(BlueprintAssignable, Category = "UPM|Benchmark")
+    FOnUPMBenchmarkFinished OnBenchmarkFinished;
+
+protected:
+    enum class EPhase : uint8
+    {
+        Idle,
+        WaitingForMap,
+        Warmup,
+        Measure,
+        Finished,
+        Recording
+    };
+
+    /** Load the config, open its map and begin; the process exits with the result */
+    void Launch(const FString& ConfigPath);
+
+    /** Load this runner's configuration from a file (derived runners read their additional fields here) */
+    virtual bool LoadRunnerConfig(const FString& FilePath);
+
+    /** Load a JSON file, relative paths are resolved against the project directory */
+    static TSharedPtr<class FJsonObject> LoadJsonFile(const FString& FilePath);
+
+    void Begin(UWorld* InWorld);
+    bool TickBenchmark(float DeltaTime);
+    void OnPostLoadMap(UWorld* LoadedWorld);
+
+    void SetupCamera();
+    void UpdateCamera(float PathTime);
+    float GetPathDuration() const;
+
+    /** Hook for derived runners: called before the warmup of every run */
+    virtual void PrepareRun(int32 RunIndex);
+
+    /** Hook for derived runners: called after every measured run */
+    virtual void OnRunMeasured(int32 RunIndex, const FUPMBenchmarkRunResult& Result);
+
+    virtual int32 GetTotalRuns() const { return FMath::Max(1, Config.Repeats); }
+
+    /** Warmup before the measured phase of the current run */
+    virtual float GetWarmupSeconds() const { return Config.WarmupSeconds; }
+
+    void StartRun();
+    FUPMBenchmarkRunResult EvaluateRun();
+    virtual void Finish();
+    void Fail(const FString& Reason);
+    virtual void Cleanup();
+
+    /** Write the JSON object to Saved/UPM/Benchmarks and return the file path (empty on failure) */
+    FString WriteResultFile(const TSharedPtr<class FJsonObject>& RootObject) const;
+
+    FUPMBenchmarkConfig Config;
+    bool bLaunchedFromCommandLine;
+    bool bBenchmarkModeWasEnabled;
+
+    EPhase Phase;
+    TWeakObjectPtr<UWorld> World;
+    int32 RunIndex;
+    float PhaseTime;
+    float PathTime;
+    double LastFrameTime;
+
+    // Camera playback
+    FInterpCurveVector LocationCurve;
+    FInterpCurveQuat RotationCurve;
+    TWeakObjectPtr<ACameraActor> Camera;
+    TWeakObjectPtr<ALevelSequenceActor> SequenceActor;
+    UPROPERTY()
+    ULevelSequencePlayer* SequencePlayer;
+
+    // Per-frame samples of the current run (ms)
+    TArray<float> FrameTimes;
+    TArray<float> GameThreadTimes;
+    TArray<float> RenderThreadTimes;
+    TArray<float> GPUTimes;
+
+    TArray<float> AllFrameTimes;
+    FUPMBenchmarkSummary Summary;
+
+    // Camera path recording
+    TArray<FUPMCameraPathPoint> RecordedPath;
+    float RecordInterval;
+    float RecordAccumulator;
+
+    FTSTicker::FDelegateHandle TickerHandle;
+    FDelegateHandle PostLoadMapHandle;
+};
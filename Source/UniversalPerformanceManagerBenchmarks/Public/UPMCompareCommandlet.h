@@ -0,0 +1,26 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UPMCompareCommandlet.generated.h"
+
+/**
+ * Compare two frame time recordings, for gating performance changes in CI
+ *
+ * -run=UPMCompare -Baseline=<a.csv> -Candidate=<b.csv> [-Column=FrameTimeMs] [-Iterations=1000]
+ *     [-BlockLength=0] [-Alpha=0.05] [-MinChange=0.02] [-Seed=12345]
+ *
+ * Returns 0 = no regression, 1 = regression, 2 = the recordings could not be read.
+ */
+UCLASS()
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API UUPMCompareCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UUPMCompareCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,82 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "UPMEffectsBudgetBenchmark.generated.h"
+
+class UNiagaraSystem;
+
+/**
+ * Effects budget benchmark
+ *
+ * Spawns a grid of looping Niagara systems, measures frame and effects time with the effects budget disabled,
+ * then again with it enabled, and logs/saves the comparison to Saved/UPM/EffectsBudgetBenchmark.json.
+ *
+ * Use a CPU simulation system so it also runs headless (GPU simulations do not run with -nullrhi):
+ *   <Project> /Engine/Maps/Entry -game -nullrhi -UPMEffectsBudgetBenchmark=/Game/FX/NS_Sparks -UPMEffectsBudgetBenchmarkCount=500
+ */
+UCLASS(Blueprintable)
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API AUPMEffectsBudgetBenchmark : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    AUPMEffectsBudgetBenchmark();
+
+    virtual void BeginPlay() override;
+    virtual void Tick(float DeltaTime) override;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    UNiagaraSystem* System;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    int32 NumSystems;
+
+    // Close enough that distance culling alone does not hide the load
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float GridSpacing;
+
+    // Effects budget during the budgeted phase; 0 = from EffectsQuality and the frame rate target
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float BudgetMs;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float WarmupDuration;
+
+    // Duration of each measured phase (budget off, budget on)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    float PhaseDuration;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UPM|Benchmark")
+    bool bExitWhenFinished;
+
+private:
+    enum class EPhase : uint8
+    {
+        Warmup,
+        Baseline,
+        Budgeted,
+        Finished
+    };
+
+    void SpawnSystems();
+    void EnterPhase(EPhase NewPhase);
+    void ReportResults();
+
+    EPhase Phase;
+    float PhaseTime;
+    bool bEffectsBudgetWasEnabled;
+    float EffectsBudgetMsWas;
+
+    // The engine's FX budget only measures while it is on; the baseline phase keeps it on without the budget's scaling
+    int32 FXBudgetEnabledWas;
+    bool bRestoreFXBudget;
+
+    TArray<float> BaselineFrameTimes;
+    TArray<float> BaselineEffectsTimes;
+    TArray<float> BudgetedFrameTimes;
+    TArray<float> BudgetedEffectsTimes;
+    float MinSpawnScale;
+};
@@ -0,0 +1,26 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UPMEffectsBudgetBenchmarkSubsystem.generated.h"
+
+/**
+ * Spawns the effects budget benchmark when the game is launched with -UPMEffectsBudgetBenchmark=<NiagaraSystem>
+ *
+ * Only created while that switch is on the command line, so normal runs pay nothing for it.
+ * Optional switches: -UPMEffectsBudgetBenchmarkCount=<Systems> -UPMEffectsBudgetBenchmarkBudgetMs=<Ms>
+ */
+UCLASS()
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API UUPMEffectsBudgetBenchmarkSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+protected:
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,25 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "UPMSelfBenchmarkCommandlet.generated.h"
+
+/**
+ * Benchmark the plugin's own hot paths against a stored baseline
+ *
+ * -run=UPMSelfBenchmark [-nullrhi] [-Baseline=<file>] [-Tolerance=0.25] [-UpdateBaseline]
+ *
+ * Returns 0 = within tolerance, 1 = a case regressed or there is no baseline (-UpdateBaseline records one).
+ */
+UCLASS()
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API UUPMSelfBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UUPMSelfBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,136 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UPMBenchmarkRunner.h"
+#include "UPMSettingsManager.h"
+#include "UPMSweepRunner.generated.h"
+
+/**
+ * One dimension of a settings sweep
+ */
+USTRUCT(BlueprintType)
+struct FUPMSweepAxis
+{
+    GENERATED_BODY()
+
+    // "<Category>.<Field>" of FUPMCompleteSettings, e.g. "Graphics.ShadowQuality" or "Display.ScreenPercentage"
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    FString Setting;
+
+    // Values to measure; higher values are assumed to mean higher quality
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    TArray<float> Values;
+
+    // Share of this axis in the quality score
+    UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+    float Weight;
+
+    FUPMSweepAxis()
+        : Weight(1.0f)
+    {
+    }
+};
+
+/**
+ * Measured cost of one settings combination
+ */
+USTRUCT(BlueprintType)
+struct FUPMSweepResult
+{
+    GENERATED_BODY()
+
+    // Setting path -> value of this combination
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    TMap<FString, float> Settings;
+
+    // 0-100, weighted position of every value within its axis
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float QualityScore;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float MeanFrameTimeMs;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float ConfidenceInterval95Ms;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float P95FrameTimeMs;
+
+    // Frame time above the cheapest combination
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    float CostMs;
+
+    // No other combination is both faster and of higher quality
+    UPROPERTY(BlueprintReadOnly, Category = "Benchmark")
+    bool bParetoOptimal;
+
+    FUPMSweepResult()
+        : QualityScore(0.0f)
+        , MeanFrameTimeMs(0.0f)
+        , ConfidenceInterval95Ms(0.0f)
+        , P95FrameTimeMs(0.0f)
+        , CostMs(0.0f)
+        , bParetoOptimal(false)
+    {
+    }
+};
+
+/**
+ * Settings sweep benchmark
+ *
+ * Measures every combination of the configured axes with the benchmark runner (same map, camera path, seed and
+ * repeats for every combination). Each combination is applied with one SetAllSettings call followed by a settle
+ * period before the regular warmup, so hitches from the change do not leak into the measurement.
+ * Writes a cost table with the Pareto frontier of quality score vs. frame time to Saved/UPM/SweepResults.json
+ * and Saved/UPM/SweepCostTable.csv, and restores the original settings afterwards.
+ *
+ * Command line: -UPMSweep=<config.json>, a benchmark config with an additional "Sweep" object (see README).
+ */
+UCLASS(BlueprintType)
+class UNIVERSALPERFORMANCEMANAGERBENCHMARKS_API UUPMSweepRunner : public UUPMBenchmarkRunner
+{
+    GENERATED_BODY()
+
+public:
+    UUPMSweepRunner();
+
+    /** Entry point for -UPMSweep=<config>, called once the engine loop is initialized */
+    static void LaunchFromCommandLine();
+
+    /** Read the results of the last sweep from Saved/UPM/SweepResults.json */
+    UFUNCTION(BlueprintCallable, Category = "UPM|Benchmark")
+    static bool LoadSweepResults(TArray<FUPMSweepResult>& OutResults);
+
+    UFUNCTION(BlueprintPure, Category = "UPM|Benchmark")
+    TArray<FUPMSweepResult> GetSweepResults() const { return Results; }
+
+protected:
+    virtual bool LoadRunnerConfig(const FString& FilePath) override;
+    virtual void PrepareRun(int32 InRunIndex) override;
+    virtual void OnRunMeasured(int32 InRunIndex, const FUPMBenchmarkRunResult& Result) override;
+    virtual int32 GetTotalRuns() const override;
+    virtual float GetWarmupSeconds() const override;
+    virtual void Finish() override;
+    virtual void Cleanup() override;
+
+    int32 GetCombinationCount() const;
+    int32 GetValueIndex(int32 Combination, int32 AxisIndex) const;
+    void ApplyCombination(int32 Combination);
+
+    TArray<FUPMSweepAxis> Axes;
+    float SettleSeconds;
+
+    FUPMCompleteSettings OriginalSettings;
+    bool bOriginalSettingsCaptured;
+
+    int32 CurrentCombination;
+    bool bSettling;
+
+    // Runs of the current combination
+    TArray<float> CombinationRunMeans;
+    TArray<float> CombinationFrameTimes;
+
+    TArray<FUPMSweepResult> Results;
+};
@@ -0,0 +1,31 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class UniversalPerformanceManagerBenchmarks : ModuleRules
+{
+    public UniversalPerformanceManagerBenchmarks(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        PublicDependencyModuleNames.AddRange(new string[]
+        {
+            "Core",
+            "CoreUObject",
+            "Engine",
+            "UniversalPerformanceManager"
+        });
+
+        // Kept out of the runtime module: Niagara only spawns the effects benchmark systems (the runtime module budgets
+        // effects through Engine), and LevelSequence/MovieScene only play benchmark camera paths
+        PrivateDependencyModuleNames.AddRange(new string[]
+        {
+            "Json",
+            "LevelSequence",
+            "MovieScene",
+            "Niagara",
+            "RenderCore",
+            "RHI"
+        });
+    }
+}
@@ -0,0 +1,27 @@
+// Copyright Universal Performance Manager. All Rights Reserved.
+
+#include "UniversalPerformanceManagerBenchmarks.h"
+#include "UPMBenchmarkRunner.h"
+#include "UPMSweepRunner.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+
+void FUniversalPerformanceManagerBenchmarksModule::StartupModule()
+{
+    // -UPMBenchmark=/-UPMSweep=<config> need the game world, which exists once the engine loop is initialized
+    if (FCString::Strifind(FCommandLine::Get(), TEXT("UPMBenchmark=")))
+    {
+        BenchmarkLaunchHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddStatic(&UUPMBenchmarkRunner::LaunchFromCommandLine);
+    }
+    else if (FCString::Strifind(FCommandLine::Get(), TEXT("UPMSweep=")))
+    {
+        BenchmarkLaunchHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddStatic(&UUPMSweepRunner::LaunchFromCommandLine);
+    }
+}
+
+void FUniversalPerformanceManagerBenchmarksModule::ShutdownModule()
+{
+    FCoreDelegates::OnFEngineLoopInitComplete.Remove(BenchmarkLaunchHandle);
+}
+
+IMPLEMENT_MODULE(FUniversalPerformanceManagerBenchmarksModule, UniversalPerformanceManagerBenchmarks)